@@ -22,6 +22,7 @@
  */
 
 #include "Calcite.h"
+#include "Calcite/PlanCache.h"
 #include "Catalog/Catalog.h"
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_path.h"
@@ -47,6 +48,8 @@
 
 #include <utility>
 
+extern bool g_enable_plan_cache;
+
 using namespace rapidjson;
 using namespace apache::thrift;
 using namespace apache::thrift::protocol;
@@ -406,6 +409,7 @@ Calcite::Calcite(const SystemParameters& system_parameters,
 }
 
 void Calcite::updateMetadata(std::string catalog, std::string table) {
+  DdlTriggeredCacheInvalidator::invalidateCaches();
   if (server_available_) {
     auto ms = measure<>::execution([&]() {
       auto clientP = getClient(remote_calcite_port_);
@@ -463,13 +467,41 @@ TPlanResult Calcite::process(
     const bool is_view_optimize,
     const bool check_privileges,
     const std::string& calcite_session_id) {
-  TPlanResult result = processImpl(query_state_proxy,
-                                   std::move(sql_string),
-                                   filter_push_down_info,
-                                   legacy_syntax,
-                                   is_explain,
-                                   is_view_optimize,
-                                   calcite_session_id);
+  // Filter push down information is specific to a single execution and explained
+  // plans are not worth caching.
+  const bool use_plan_cache =
+      g_enable_plan_cache && filter_push_down_info.empty() && !is_explain;
+  std::string plan_cache_key;
+  uint64_t plan_cache_generation{0};
+  std::shared_ptr<const TPlanResult> cached_plan;
+  auto& plan_cache = PlanCache::instance();
+  if (use_plan_cache) {
+    const auto& cat =
+        query_state_proxy.getQueryState().getConstSessionInfo()->getCatalog();
+    plan_cache_key = PlanCache::makeKey(
+        cat.getCurrentDB().dbId, sql_string, legacy_syntax, is_view_optimize);
+    plan_cache_generation = plan_cache.getGeneration();
+    cached_plan = plan_cache.get(plan_cache_key);
+  }
+  TPlanResult result;
+  if (cached_plan) {
+    VLOG(1) << "Plan cache hit for '" << sql_string << "'";
+    result = *cached_plan;
+    result.execution_time_ms = 0;
+  } else {
+    result = processImpl(query_state_proxy,
+                         std::move(sql_string),
+                         filter_push_down_info,
+                         legacy_syntax,
+                         is_explain,
+                         is_view_optimize,
+                         calcite_session_id);
+    if (use_plan_cache) {
+      plan_cache.put(plan_cache_key,
+                     plan_cache_generation,
+                     std::make_shared<const TPlanResult>(result));
+    }
+  }
   if (check_privileges && !is_explain) {
     checkAccessedObjectsPrivileges(query_state_proxy, result);
   }
@@ -677,6 +709,8 @@ std::string Calcite::getRuntimeExtensionFunctionWhitelist() {
 void Calcite::setRuntimeExtensionFunctions(
     const std::vector<TUserDefinedFunction>& udfs,
     const std::vector<TUserDefinedTableFunction>& udtfs) {
+  // Cached plans may reference the functions being replaced.
+  DdlTriggeredCacheInvalidator::invalidateCaches();
   if (server_available_) {
     auto clientP = getClient(remote_calcite_port_);
     clientP.first->setRuntimeExtensionFunctions(udfs, udtfs);
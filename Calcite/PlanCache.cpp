@@ -0,0 +1,106 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Calcite/PlanCache.h"
+
+#include <algorithm>
+#include <cctype>
+
+bool g_enable_plan_cache{false};
+
+PlanCache& PlanCache::instance() {
+  static PlanCache plan_cache;
+  return plan_cache;
+}
+
+PlanCache::PlanCache() : plans_(kMaxEntryCount) {}
+
+std::string PlanCache::normalizeSql(const std::string& sql) {
+  std::string normalized;
+  normalized.reserve(sql.size());
+  bool pending_space{false};
+  size_t i = 0;
+  while (i < sql.size()) {
+    const char c = sql[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = !normalized.empty();
+      ++i;
+      continue;
+    }
+    if (pending_space) {
+      normalized += ' ';
+      pending_space = false;
+    }
+    // Quoted literals, quoted identifiers and comments are copied verbatim. Comments
+    // must keep their line breaks, which terminate single line comments.
+    size_t end = i + 1;
+    if (c == '\'' || c == '"' || c == '`') {
+      while (end < sql.size() && sql[end] != c) {
+        ++end;
+      }
+      end = std::min(end + 1, sql.size());
+    } else if (sql.compare(i, 2, "--") == 0) {
+      end = std::min(sql.find('\n', i), sql.size());
+    } else if (sql.compare(i, 2, "/*") == 0) {
+      const auto comment_end = sql.find("*/", i + 2);
+      end = comment_end == std::string::npos ? sql.size() : comment_end + 2;
+    }
+    normalized.append(sql, i, end - i);
+    i = end;
+  }
+  if (!normalized.empty() && normalized.back() == ';') {
+    normalized.pop_back();
+    if (!normalized.empty() && normalized.back() == ' ') {
+      normalized.pop_back();
+    }
+  }
+  return normalized;
+}
+
+std::string PlanCache::makeKey(const int db_id,
+                               const std::string& sql,
+                               const bool legacy_syntax,
+                               const bool is_view_optimize) {
+  return std::to_string(db_id) + (legacy_syntax ? "|L" : "|-") +
+         (is_view_optimize ? "V|" : "-|") + normalizeSql(sql);
+}
+
+std::shared_ptr<const TPlanResult> PlanCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto plan = plans_.get(key);
+  if (!plan) {
+    ++miss_count_;
+    return nullptr;
+  }
+  ++hit_count_;
+  return *plan;
+}
+
+void PlanCache::put(const std::string& key,
+                    const uint64_t generation,
+                    std::shared_ptr<const TPlanResult> plan) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  plans_.put(key, std::move(plan));
+}
+
+void PlanCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++generation_;
+  plans_.clear();
+}
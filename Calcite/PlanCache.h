@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PlanCache.h
+ * @brief   Process-wide cache of Calcite plans for repeated SQL statements.
+ *
+ * Calcite plans with a super user session, so a plan only depends on the statement,
+ * the database and the planner options. Privileges are checked against the accessed
+ * objects of the plan on every execution, cached or not. Any DDL clears the cache
+ * through DdlTriggeredCacheInvalidator.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "QueryEngine/CacheInvalidator.h"
+#include "StringDictionary/LruCache.hpp"
+
+class TPlanResult;
+
+class PlanCache {
+ public:
+  static PlanCache& instance();
+
+  // Collapses whitespace outside of quoted literals and identifiers and drops a
+  // trailing semicolon, so that formatting differences don't defeat the cache.
+  static std::string normalizeSql(const std::string& sql);
+
+  static std::string makeKey(const int db_id,
+                             const std::string& sql,
+                             const bool legacy_syntax,
+                             const bool is_view_optimize);
+
+  // The generation is bumped by every invalidation. A plan computed while an
+  // invalidation happened may be stale and is not cached.
+  uint64_t getGeneration() const { return generation_; }
+
+  std::shared_ptr<const TPlanResult> get(const std::string& key);
+  void put(const std::string& key,
+           const uint64_t generation,
+           std::shared_ptr<const TPlanResult> plan);
+  void clear();
+
+  size_t getHitCount() const { return hit_count_; }
+  size_t getMissCount() const { return miss_count_; }
+
+  static auto yieldCacheInvalidator() -> std::function<void()> {
+    return []() -> void { PlanCache::instance().clear(); };
+  }
+
+ private:
+  PlanCache();
+
+  static constexpr size_t kMaxEntryCount{1000};
+
+  std::mutex mutex_;
+  LruCache<std::string, std::shared_ptr<const TPlanResult>> plans_;
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+
+using DdlTriggeredCacheInvalidator = CacheInvalidator<PlanCache>;
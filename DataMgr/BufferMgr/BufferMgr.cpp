@@ -59,7 +59,8 @@ BufferMgr::BufferMgr(const int device_id,
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
-    , buffer_epoch_(0) {
+    , buffer_epoch_(0)
+    , eviction_policy_(EvictionPolicy::LRU) {
   CHECK(max_buffer_pool_size_ > 0);
   CHECK(page_size_ > 0);
   // TODO change checks on run-time configurable slab size variables to exceptions
@@ -103,6 +104,33 @@ void BufferMgr::clear() {
   slab_segments_.clear();
   unsized_segs_.clear();
   buffer_epoch_ = 0;
+  if (eviction_alg_) {
+    std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+    eviction_alg_ = create_eviction_algorithm(eviction_policy_);
+  }
+}
+
+void BufferMgr::setEvictionPolicy(const EvictionPolicy policy) {
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  CHECK(chunk_index_.empty());
+  std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+  eviction_policy_ = policy;
+  eviction_alg_ = policy == EvictionPolicy::LRU ? nullptr
+                                                : create_eviction_algorithm(policy);
+}
+
+void BufferMgr::touchEvictionAlg(const ChunkKey& key) {
+  if (eviction_alg_) {
+    std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+    eviction_alg_->touchChunk(key);
+  }
+}
+
+void BufferMgr::removeFromEvictionAlg(const ChunkKey& key) {
+  if (eviction_alg_) {
+    std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+    eviction_alg_->removeChunk(key);
+  }
 }
 
 /// Throws a runtime_error if the Chunk already exists
@@ -128,6 +156,7 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunk_key,
                   1);  // need to do this before allocating Buffer because doing so could
                        // change the segment used
   }
+  touchEvictionAlg(chunk_key);
   // following should be safe outside the lock b/c first thing Buffer
   // constructor does is pin (and its still in unsized segs at this point
   // so can't be evicted)
@@ -164,6 +193,10 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      if (eviction_alg_) {
+        std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+        eviction_alg_->markChunkEvicted(evict_it->chunk_key);
+      }
     }
     evict_it = slab_segments_[slab_num].erase(
         evict_it);  // erase operations returns next iterator - safe if we ever move
@@ -216,7 +249,7 @@ BufferList::iterator BufferMgr::reserveBuffer(
   }
   // If we're here then we couldn't keep buffer in existing slot
   // need to find new segment, copy data over, and then delete old
-  auto new_seg_it = findFreeBuffer(num_bytes);
+  auto new_seg_it = findFreeBuffer(num_bytes, seg_it->chunk_key);
 
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
@@ -272,7 +305,8 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
   return slab_segments_[slab_num].end();
 }
 
-BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
+BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes,
+                                               const ChunkKey& chunk_key) {
   size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
   if (num_pages_requested > max_num_pages_per_slab_) {
     throw TooBigForSlab(num_bytes);
@@ -280,7 +314,11 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t num_slabs = slab_segments_.size();
 
+  const int preferred_node = getPreferredNumaNode(chunk_key);
   for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+    if (preferred_node >= 0 && getSlabNumaNode(slab_num) != preferred_node) {
+      continue;
+    }
     auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
     if (seg_it != slab_segments_[slab_num].end()) {
       return seg_it;
@@ -299,7 +337,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           current_max_slab_page_size_) {  // don't try to allocate if the
                                           // new slab won't be big enough
         auto alloc_ms = measure<>::execution(
-            [&]() { addSlab(current_max_slab_page_size_ * page_size_); });
+            [&]() { addSlab(current_max_slab_page_size_ * page_size_, preferred_node); });
         LOG(INFO) << "ALLOCATION slab of " << current_max_slab_page_size_ << " pages ("
                   << current_max_slab_page_size_ * page_size_ << "B) created in "
                   << alloc_ms << " ms " << getStringMgrType() << ":" << device_id_;
@@ -342,8 +380,39 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
     throw FailedToCreateFirstSlab(num_bytes);
   }
 
+  // Fall back to free space on the other NUMA nodes before evicting anything.
+  if (preferred_node >= 0) {
+    for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+      if (getSlabNumaNode(slab_num) == preferred_node) {
+        continue;
+      }
+      auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+      if (seg_it != slab_segments_[slab_num].end()) {
+        return seg_it;
+      }
+    }
+  }
+
   // If here then we can't add a slab - so we need to evict
 
+  // With an eviction algorithm, the score of a chunk is its position in the eviction
+  // order of the algorithm rather than its last touch epoch.
+  std::map<ChunkKey, size_t> eviction_ranks;
+  if (eviction_alg_) {
+    std::lock_guard<std::mutex> eviction_alg_lock(eviction_alg_mutex_);
+    const auto eviction_order = eviction_alg_->getEvictionOrder();
+    for (size_t rank = 0; rank < eviction_order.size(); ++rank) {
+      eviction_ranks.emplace(eviction_order[rank], rank);
+    }
+  }
+  const auto get_score = [this, &eviction_ranks](const BufferSeg& seg) -> size_t {
+    if (!eviction_alg_) {
+      return seg.last_touched;
+    }
+    const auto it = eviction_ranks.find(seg.chunk_key);
+    return it != eviction_ranks.end() ? it->second : eviction_ranks.size();
+  };
+
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
   // This is because score is the sum of the lastTouched score for all pages evicted.
@@ -382,7 +451,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // chunk score was larger than one large chunk so it always would evict a large
           // chunk so under memory pressure a query would evict its own current chunks and
           // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          score = std::max(score, get_score(*evict_it));
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
@@ -598,6 +667,7 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
   auto seg_it = buffer_it->second;
   chunk_index_.erase(buffer_it);
   chunk_index_lock.unlock();
+  removeFromEvictionAlg(key);
   std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
   if (seg_it->buffer) {
     delete seg_it->buffer;  // Delete Buffer for segment
@@ -631,6 +701,7 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
       seg_it->buffer = 0;
     }
     removeSegment(seg_it);
+    removeFromEvictionAlg(buffer_it->first);
     chunk_index_.erase(buffer_it++);
   }
 }
@@ -725,6 +796,7 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
     sized_segs_lock.unlock();
 
     buffer_it->second->last_touched = buffer_epoch_++;  // race
+    touchEvictionAlg(key);
 
     if (buffer_it->second->buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
@@ -36,6 +36,7 @@
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/CacheEvictionAlgorithm.h"
 #include "Shared/types.h"
 
 class OutOfMemory : public std::runtime_error {
@@ -126,6 +127,8 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   size_t getPageSize();
   bool isAllocationCapped() override;
   const std::vector<BufferList>& getSlabSegments();
+  /// NUMA node the memory of the slab is bound to, -1 if it isn't bound to any.
+  virtual int getSlabNumaNode(const size_t slab_num) const { return -1; }
 
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
@@ -167,6 +170,10 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   BufferList::iterator reserveBuffer(BufferList::iterator& seg_it,
                                      const size_t num_bytes);
+
+  /// Selects the policy used to pick unpinned segments to evict. Must be called before
+  /// any buffer is created. Defaults to LRU.
+  void setEvictionPolicy(const EvictionPolicy policy);
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunk_metadata_vec,
                                        const ChunkKey& key_prefix) override;
 
@@ -182,14 +189,20 @@ class BufferMgr : public AbstractBufferMgr {  // implements
                                 /// allocation of the buffer pool
   std::vector<BufferList> slab_segments_;
 
+  /// NUMA node the chunk should preferably be placed on, -1 for any node.
+  virtual int getPreferredNumaNode(const ChunkKey& key) const { return -1; }
+
  private:
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
+  void touchEvictionAlg(const ChunkKey& key);
+  void removeFromEvictionAlg(const ChunkKey& key);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
   int getBufferId();
-  virtual void addSlab(const size_t slab_size) = 0;
+  /// Adds a slab for a buffer preferably placed on the given NUMA node, -1 for any node.
+  virtual void addSlab(const size_t slab_size, const int preferred_numa_node) = 0;
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
                               const size_t page_size,
@@ -211,6 +224,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   int max_buffer_id_;
   unsigned int buffer_epoch_;
 
+  // Null for LRU, which is tracked through the last_touched epochs of the segments.
+  std::unique_ptr<CacheEvictionAlgorithm> eviction_alg_;
+  EvictionPolicy eviction_policy_;
+  std::mutex eviction_alg_mutex_;
+
   BufferList unsized_segs_;
 
   BufferList::iterator evict(BufferList::iterator& evict_start,
@@ -226,10 +244,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
    *
    * @return An iterator to the reserved buffer. We guarantee that this
    * buffer won't be evicted by PINNING it - caller should change this to
-   * USED if applicable
+   * USED if applicable. Free space in the slabs on the preferred NUMA node of the
+   * chunk is used first, then a new slab is added, then any other free space.
    *
    */
-  BufferList::iterator findFreeBuffer(size_t num_bytes);
+  BufferList::iterator findFreeBuffer(size_t num_bytes, const ChunkKey& chunk_key);
 };
 
 }  // namespace Buffer_Namespace
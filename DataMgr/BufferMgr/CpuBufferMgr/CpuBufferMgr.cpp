@@ -19,10 +19,11 @@
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "Shared/numa.h"
 
 namespace Buffer_Namespace {
 
-void CpuBufferMgr::addSlab(const size_t slab_size) {
+void CpuBufferMgr::addSlab(const size_t slab_size, const int preferred_numa_node) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
   try {
@@ -31,6 +32,18 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
     slabs_.resize(slabs_.size() - 1);
     throw FailedToCreateSlab(slab_size);
   }
+  int numa_node = -1;
+  if (g_enable_numa_placement && numa::node_count() > 1) {
+    const auto& nodes = numa::nodes();
+    numa_node = preferred_numa_node >= 0 ? preferred_numa_node
+                                         : nodes[(slabs_.size() - 1) % nodes.size()];
+    if (!numa::bind_memory(slabs_.back(), slab_size, numa_node)) {
+      LOG(WARNING) << "Could not bind CPU buffer pool slab " << slabs_.size() - 1
+                   << " to NUMA node " << numa_node;
+      numa_node = -1;
+    }
+  }
+  slab_numa_nodes_.push_back(numa_node);
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
@@ -39,6 +52,19 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
   allocator_.reset(new Arena(max_slab_size_ + kArenaBlockOverhead));
+  slab_numa_nodes_.clear();
+}
+
+int CpuBufferMgr::getSlabNumaNode(const size_t slab_num) const {
+  return slab_num < slab_numa_nodes_.size() ? slab_numa_nodes_[slab_num] : -1;
+}
+
+int CpuBufferMgr::getPreferredNumaNode(const ChunkKey& key) const {
+  if (key.size() <= CHUNK_KEY_FRAGMENT_IDX || key[0] < 0) {
+    // Temporary buffers from alloc() have no fragment.
+    return -1;
+  }
+  return numa::fragment_node(key[CHUNK_KEY_FRAGMENT_IDX]);
 }
 
 void CpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
@@ -52,8 +52,13 @@ class CpuBufferMgr : public BufferMgr {
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
 
+  int getSlabNumaNode(const size_t slab_num) const override;
+
+ protected:
+  int getPreferredNumaNode(const ChunkKey& key) const override;
+
  private:
-  void addSlab(const size_t slab_size) override;
+  void addSlab(const size_t slab_size, const int preferred_numa_node) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator segment_iter,
                       const size_t page_size,
@@ -61,6 +66,9 @@ class CpuBufferMgr : public BufferMgr {
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
   std::unique_ptr<Arena> allocator_;
+  // With NUMA placement enabled, slabs are bound to the node of the chunk they are added
+  // for, or to the nodes round-robin for buffers without a fragment.
+  std::vector<int> slab_numa_nodes_;
 };
 
 }  // namespace Buffer_Namespace
@@ -53,7 +53,8 @@ GpuCudaBufferMgr::~GpuCudaBufferMgr() {
   }
 }
 
-void GpuCudaBufferMgr::addSlab(const size_t slab_size) {
+void GpuCudaBufferMgr::addSlab(const size_t slab_size,
+                               const int /*preferred_numa_node*/) {
   slabs_.resize(slabs_.size() + 1);
   try {
     slabs_.back() = cuda_mgr_->allocateDeviceMem(slab_size, device_id_);
@@ -38,7 +38,7 @@ class GpuCudaBufferMgr : public BufferMgr {
   ~GpuCudaBufferMgr() override;
 
  private:
-  void addSlab(const size_t slab_size) override;
+  void addSlab(const size_t slab_size, const int preferred_numa_node) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator seg_it,
                       const size_t page_size,
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include "../Shared/sqltypes.h"
+#include "DataMgr/ChunkValueSketch.h"
 #include "Shared/types.h"
 
 #include "Logger/Logger.h"
@@ -33,12 +35,17 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // Optional Bloom filter / NDV sketch over every value in the chunk; null when the
+  // encoder does not build one or it no longer covers all values.
+  std::shared_ptr<const ChunkValueSketch> valueSketch;
 
   std::string dump() {
     return "numBytes: " + to_string(numBytes) + " numElements " + to_string(numElements) +
            " min: " + DatumToString(chunkStats.min, sqlType) +
            " max: " + DatumToString(chunkStats.max, sqlType) +
-           " has_nulls: " + to_string(chunkStats.has_nulls);
+           " has_nulls: " + to_string(chunkStats.has_nulls) +
+           (valueSketch ? " approx_ndv: " + to_string(valueSketch->approxDistinctCount())
+                        : "");
   }
 
   ChunkMetadata(const SQLTypeInfo& sql_type,
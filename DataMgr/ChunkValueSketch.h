@@ -0,0 +1,150 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkValueSketch.h
+ * @brief   Per-chunk Bloom filter and HyperLogLog sketch over integer-encoded values.
+ *
+ * Built by the encoders at insert time and persisted after the encoder stats in the
+ * chunk metadata page. The executor uses the Bloom filter to skip fragments for
+ * equality predicates that the min/max range cannot rule out.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "Shared/sqltypes.h"
+
+class ChunkValueSketch {
+ public:
+  static constexpr size_t kBloomFilterBits{3072 * 8};
+  static constexpr size_t kBloomFilterHashes{4};
+  static constexpr size_t kHllRegisterBits{9};
+  static constexpr size_t kHllRegisterCount{size_t(1) << kHllRegisterBits};
+  // Past this many distinct values the false positive rate exceeds ~15%, at which point
+  // the filter no longer skips enough fragments to be worth building or persisting.
+  static constexpr size_t kMaxUsefulDistinctCount{kBloomFilterBits / 4};
+
+  ChunkValueSketch() {
+    bloom_words_.fill(0);
+    hll_registers_.fill(0);
+  }
+
+  // Types whose chunk values are integers comparable with the executor's integer
+  // constants: integers, decimals, date/time and dictionary-encoded strings.
+  static bool isSupportedType(const SQLTypeInfo& ti) {
+    if (ti.is_dict_encoded_string()) {
+      return true;
+    }
+    return (ti.is_integer() || ti.is_decimal() || ti.is_time()) && !ti.is_boolean();
+  }
+
+  void add(const int64_t val) {
+    const uint64_t hash = mix(static_cast<uint64_t>(val));
+    const uint64_t h1 = hash;
+    const uint64_t h2 = mix(hash) | 1;
+    for (size_t i = 0; i < kBloomFilterHashes; ++i) {
+      const size_t bit = (h1 + i * h2) % kBloomFilterBits;
+      bloom_words_[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+    const size_t register_idx = hash >> (64 - kHllRegisterBits);
+    const uint64_t rank_bits = hash << kHllRegisterBits;
+    const uint8_t rank =
+        rank_bits ? static_cast<uint8_t>(__builtin_clzll(rank_bits) + 1)
+                  : static_cast<uint8_t>(64 - kHllRegisterBits + 1);
+    hll_registers_[register_idx] = std::max(hll_registers_[register_idx], rank);
+  }
+
+  bool mayContain(const int64_t val) const {
+    const uint64_t hash = mix(static_cast<uint64_t>(val));
+    const uint64_t h1 = hash;
+    const uint64_t h2 = mix(hash) | 1;
+    for (size_t i = 0; i < kBloomFilterHashes; ++i) {
+      const size_t bit = (h1 + i * h2) % kBloomFilterBits;
+      if (!(bloom_words_[bit >> 6] & (uint64_t(1) << (bit & 63)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void merge(const ChunkValueSketch& that) {
+    for (size_t i = 0; i < bloom_words_.size(); ++i) {
+      bloom_words_[i] |= that.bloom_words_[i];
+    }
+    for (size_t i = 0; i < kHllRegisterCount; ++i) {
+      hll_registers_[i] = std::max(hll_registers_[i], that.hll_registers_[i]);
+    }
+  }
+
+  // HyperLogLog estimate of the number of distinct values added, with the linear
+  // counting correction for small cardinalities.
+  size_t approxDistinctCount() const {
+    constexpr double m = kHllRegisterCount;
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double sum = 0.0;
+    size_t zero_registers = 0;
+    for (const auto reg : hll_registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(reg));
+      zero_registers += reg == 0;
+    }
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zero_registers) {
+      estimate = m * std::log(m / zero_registers);
+    }
+    return static_cast<size_t>(estimate + 0.5);
+  }
+
+  bool isSaturated() const { return approxDistinctCount() > kMaxUsefulDistinctCount; }
+
+  void write(FILE* f) const {
+    fwrite(bloom_words_.data(), sizeof(uint64_t), bloom_words_.size(), f);
+    fwrite(hll_registers_.data(), sizeof(uint8_t), hll_registers_.size(), f);
+  }
+
+  bool read(FILE* f) {
+    return fread(bloom_words_.data(), sizeof(uint64_t), bloom_words_.size(), f) ==
+               bloom_words_.size() &&
+           fread(hll_registers_.data(), sizeof(uint8_t), hll_registers_.size(), f) ==
+               hll_registers_.size();
+  }
+
+  static constexpr size_t kSerializedSize{kBloomFilterBits / 8 + kHllRegisterCount};
+
+ private:
+  // 64-bit finalizer from MurmurHash3
+  static uint64_t mix(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+  }
+
+  std::array<uint64_t, kBloomFilterBits / 64> bloom_words_;
+  std::array<uint8_t, kHllRegisterCount> hll_registers_;
+};
+
+// The sketch is written to the 4096 byte chunk metadata page after the buffer and
+// encoder metadata, which take at most a few hundred bytes.
+static_assert(ChunkValueSketch::kSerializedSize <= 3584,
+              "Chunk value sketch does not fit in the chunk metadata page");
@@ -198,17 +198,21 @@ void DataMgr::populateMgrs(const SystemParameters& system_parameters,
   LOG(INFO) << "Max CPU Slab Size is " << (float)maxCpuSlabSize / (1024 * 1024) << "MB";
   LOG(INFO) << "Max memory pool size for CPU is " << (float)cpuBufferSize / (1024 * 1024)
             << "MB";
+  const auto cpu_eviction_policy =
+      parse_eviction_policy(system_parameters.cpu_buffer_eviction_policy);
   if (hasGpus_) {
     LOG(INFO) << "Reserved GPU memory is " << (float)reservedGpuMem_ / (1024 * 1024)
               << "MB includes render buffer allocation";
     bufferMgrs_.resize(3);
-    bufferMgrs_[1].push_back(new Buffer_Namespace::CpuBufferMgr(0,
-                                                                cpuBufferSize,
-                                                                cudaMgr_.get(),
-                                                                minCpuSlabSize,
-                                                                maxCpuSlabSize,
-                                                                page_size,
-                                                                bufferMgrs_[0][0]));
+    auto cpu_buffer_mgr = new Buffer_Namespace::CpuBufferMgr(0,
+                                                             cpuBufferSize,
+                                                             cudaMgr_.get(),
+                                                             minCpuSlabSize,
+                                                             maxCpuSlabSize,
+                                                             page_size,
+                                                             bufferMgrs_[0][0]);
+    cpu_buffer_mgr->setEvictionPolicy(cpu_eviction_policy);
+    bufferMgrs_[1].push_back(cpu_buffer_mgr);
     levelSizes_.push_back(1);
     int numGpus = cudaMgr_->getDeviceCount();
     for (int gpuNum = 0; gpuNum < numGpus; ++gpuNum) {
@@ -228,23 +232,28 @@ void DataMgr::populateMgrs(const SystemParameters& system_parameters,
                 << (float)maxGpuSlabSize / (1024 * 1024) << "MB";
       LOG(INFO) << "Max memory pool size for GPU " << gpuNum << " is "
                 << (float)gpuMaxMemSize / (1024 * 1024) << "MB";
-      bufferMgrs_[2].push_back(new Buffer_Namespace::GpuCudaBufferMgr(gpuNum,
-                                                                      gpuMaxMemSize,
-                                                                      cudaMgr_.get(),
-                                                                      minGpuSlabSize,
-                                                                      maxGpuSlabSize,
-                                                                      page_size,
-                                                                      bufferMgrs_[1][0]));
+      auto gpu_buffer_mgr = new Buffer_Namespace::GpuCudaBufferMgr(gpuNum,
+                                                                   gpuMaxMemSize,
+                                                                   cudaMgr_.get(),
+                                                                   minGpuSlabSize,
+                                                                   maxGpuSlabSize,
+                                                                   page_size,
+                                                                   bufferMgrs_[1][0]);
+      gpu_buffer_mgr->setEvictionPolicy(
+          parse_eviction_policy(system_parameters.gpu_buffer_eviction_policy));
+      bufferMgrs_[2].push_back(gpu_buffer_mgr);
     }
     levelSizes_.push_back(numGpus);
   } else {
-    bufferMgrs_[1].push_back(new Buffer_Namespace::CpuBufferMgr(0,
-                                                                cpuBufferSize,
-                                                                cudaMgr_.get(),
-                                                                minCpuSlabSize,
-                                                                maxCpuSlabSize,
-                                                                page_size,
-                                                                bufferMgrs_[0][0]));
+    auto cpu_buffer_mgr = new Buffer_Namespace::CpuBufferMgr(0,
+                                                             cpuBufferSize,
+                                                             cudaMgr_.get(),
+                                                             minCpuSlabSize,
+                                                             maxCpuSlabSize,
+                                                             page_size,
+                                                             bufferMgrs_[0][0]);
+    cpu_buffer_mgr->setEvictionPolicy(cpu_eviction_policy);
+    bufferMgrs_[1].push_back(cpu_buffer_mgr);
     levelSizes_.push_back(1);
   }
 }
@@ -312,8 +321,10 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
     mi.isAllocationCapped = cpu_buffer->isAllocationCapped();
     mi.numPageAllocated = cpu_buffer->getAllocated() / mi.pageSize;
 
+    std::map<int32_t, NumaNodeMemoryInfo> numa_node_info;
     const auto& slab_segments = cpu_buffer->getSlabSegments();
     for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
+      const int32_t numa_node = cpu_buffer->getSlabNumaNode(slab_num);
       for (auto segment : slab_segments[slab_num]) {
         MemoryData md;
         md.slabNum = slab_num;
@@ -321,11 +332,24 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
         md.numPages = segment.num_pages;
         md.touch = segment.last_touched;
         md.memStatus = segment.mem_status;
+        md.numaNode = numa_node;
         md.chunk_key.insert(
             md.chunk_key.end(), segment.chunk_key.begin(), segment.chunk_key.end());
         mi.nodeMemoryData.push_back(md);
+        if (numa_node >= 0) {
+          auto& node_info =
+              numa_node_info.emplace(numa_node, NumaNodeMemoryInfo{numa_node, 0, 0})
+                  .first->second;
+          node_info.numPagesAllocated += segment.num_pages;
+          if (segment.mem_status == Buffer_Namespace::MemStatus::USED) {
+            node_info.numPagesUsed += segment.num_pages;
+          }
+        }
       }
     }
+    for (const auto& entry : numa_node_info) {
+      mi.numaNodeMemoryInfo.push_back(entry.second);
+    }
     mem_info.push_back(mi);
   } else if (hasGpus_) {
     int numGpus = cudaMgr_->getDeviceCount();
@@ -352,6 +376,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
           md.chunk_key.insert(
               md.chunk_key.end(), segment.chunk_key.begin(), segment.chunk_key.end());
           md.memStatus = segment.mem_status;
+          md.numaNode = -1;
           mi.nodeMemoryData.push_back(md);
         }
       }
@@ -55,6 +55,13 @@ struct MemoryData {
   uint32_t touch;
   std::vector<int32_t> chunk_key;
   Buffer_Namespace::MemStatus memStatus;
+  int32_t numaNode;  // -1 if the slab isn't bound to a NUMA node
+};
+
+struct NumaNodeMemoryInfo {
+  int32_t numaNode;
+  size_t numPagesAllocated;
+  size_t numPagesUsed;
 };
 
 struct MemoryInfo {
@@ -63,6 +70,8 @@ struct MemoryInfo {
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  // Pages of the CPU buffer pool per NUMA node, empty unless slabs are bound to nodes.
+  std::vector<NumaNodeMemoryInfo> numaNodeMemoryInfo;
 };
 
 //! Parse /proc/meminfo into key/value pairs.
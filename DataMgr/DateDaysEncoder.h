@@ -56,6 +56,9 @@ class DateDaysEncoder : public Encoder {
         src_data += num_elems_to_append * sizeof(T);
       }
     } else {
+      // overwritten values may still be in the sketch, but the element count no longer
+      // says whether every value was added to it
+      dropValueSketch();
       num_elems_ = offset + num_elems_to_append;
       CHECK(!replicating);
       CHECK_GE(offset, 0);
@@ -86,6 +89,7 @@ class DateDaysEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -97,6 +101,7 @@ class DateDaysEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -124,12 +129,13 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceValueSketch(that);
   }
 
   void copyMetadata(const Encoder* copyFromEncoder) override {
@@ -138,6 +144,7 @@ class DateDaysEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copyValueSketch(*copyFromEncoder);
   }
 
   void writeMetadata(FILE* f) override {
@@ -180,12 +187,14 @@ class DateDaysEncoder : public Encoder {
     if (unencoded_data == std::numeric_limits<V>::min()) {
       has_nulls = true;
       encoded_data = static_cast<V>(unencoded_data);
+      addNullToValueSketch();
     } else {
       date_days_overflow_validator_.validate(unencoded_data);
       encoded_data = DateConverters::get_epoch_days_from_seconds(unencoded_data);
       const T data = DateConverters::get_epoch_seconds_from_days(encoded_data);
       dataMax = std::max(dataMax, data);
       dataMin = std::min(dataMin, data);
+      addToValueSketch(static_cast<int64_t>(data));
     }
     return encoded_data;
   }
@@ -19,8 +19,10 @@
 #include "DateDaysEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
+#include "FrameOfReferenceEncoder.h"
 #include "Logger/Logger.h"
 #include "NoneEncoder.h"
+#include "RunLengthEncoder.h"
 #include "StringNoneEncoder.h"
 
 Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
@@ -171,6 +173,42 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }  // switch (sqlType)
       break;
     }  // Case: kENCODING_FIXED
+    case kENCODING_RL: {
+      switch (sqlType.get_type()) {
+        case kTINYINT:
+          return new RunLengthEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new RunLengthEncoder<int16_t>(buffer);
+        case kINT:
+          return new RunLengthEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new RunLengthEncoder<int64_t>(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }
+    case kENCODING_DIFF: {
+      switch (sqlType.get_type()) {
+        case kTINYINT:
+          return new FrameOfReferenceEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new FrameOfReferenceEncoder<int16_t>(buffer);
+        case kINT:
+          return new FrameOfReferenceEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new FrameOfReferenceEncoder<int64_t>(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }
     case kENCODING_DICT: {
       if (sqlType.get_type() == kARRAY) {
         CHECK(IS_STRING(sqlType.get_subtype()));
@@ -218,14 +256,128 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
   return 0;
 }
 
+std::vector<int64_t> Encoder::decodePackedChunk(const int8_t* buffer,
+                                                const size_t num_elems,
+                                                const SQLTypeInfo& ti) {
+  std::vector<int64_t> values(num_elems);
+  switch (ti.get_compression()) {
+    case kENCODING_RL:
+      run_length::decode(buffer, num_elems, values.data());
+      break;
+    case kENCODING_DIFF:
+      frame_of_reference::decode(buffer,
+                                 num_elems,
+                                 inline_int_null_val(get_logical_type_info(ti)),
+                                 values.data());
+      break;
+    default:
+      CHECK(false);
+  }
+  return values;
+}
+
+std::vector<int8_t> Encoder::encodePackedChunk(const std::vector<int64_t>& values,
+                                               const SQLTypeInfo& ti) {
+  switch (ti.get_compression()) {
+    case kENCODING_RL:
+      return run_length::encode(values.data(), values.size());
+    case kENCODING_DIFF:
+      return frame_of_reference::encode(
+          values.data(), values.size(), inline_int_null_val(get_logical_type_info(ti)));
+    default:
+      CHECK(false);
+  }
+  return {};
+}
+
+size_t Encoder::getPackedChunkSize(const int8_t* buffer,
+                                   const size_t num_elems,
+                                   const SQLTypeInfo& ti) {
+  if (num_elems == 0) {
+    // nothing might have been written to the buffer yet
+    return 0;
+  }
+  switch (ti.get_compression()) {
+    case kENCODING_RL:
+      return run_length::buffer_size(run_length::run_count(buffer));
+    case kENCODING_DIFF:
+      return frame_of_reference::buffer_size(buffer, num_elems);
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
 Encoder::Encoder(Data_Namespace::AbstractBuffer* buffer)
     : num_elems_(0)
     , buffer_(buffer)
     , decimal_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo())
-    , date_days_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo()){};
+    , date_days_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo())
+    , num_sketched_elems_(0) {}
 
 void Encoder::getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) {
   chunkMetadata->sqlType = buffer_->getSqlType();
   chunkMetadata->numBytes = buffer_->size();
   chunkMetadata->numElements = num_elems_;
+  if (value_sketch_ &&
+      (num_sketched_elems_ != num_elems_ || value_sketch_->isSaturated())) {
+    // the sketch either misses some elements or is too full to rule out any value
+    value_sketch_.reset();
+  }
+  chunkMetadata->valueSketch =
+      value_sketch_ ? std::make_shared<const ChunkValueSketch>(*value_sketch_) : nullptr;
+}
+
+void Encoder::enableValueSketch() {
+  CHECK_EQ(num_elems_, size_t(0));
+  if (ChunkValueSketch::isSupportedType(buffer_->getSqlType())) {
+    value_sketch_ = std::make_unique<ChunkValueSketch>();
+    num_sketched_elems_ = 0;
+  }
+}
+
+const ChunkValueSketch* Encoder::getValueSketch() const {
+  if (!value_sketch_ || num_sketched_elems_ != num_elems_) {
+    return nullptr;
+  }
+  return value_sketch_.get();
+}
+
+void Encoder::writeValueSketch(FILE* f) const {
+  // assumes pointer is already in right place
+  const auto sketch = getValueSketch();
+  CHECK(sketch);
+  sketch->write(f);
+}
+
+void Encoder::readValueSketch(FILE* f) {
+  // assumes pointer is already in right place, after the encoder metadata
+  auto sketch = std::make_unique<ChunkValueSketch>();
+  if (!sketch->read(f)) {
+    LOG(WARNING) << "Could not read chunk value sketch, chunk will not use it.";
+    value_sketch_.reset();
+    return;
+  }
+  value_sketch_ = std::move(sketch);
+  num_sketched_elems_ = num_elems_;
+}
+
+void Encoder::copyValueSketch(const Encoder& that) {
+  const auto that_sketch = that.getValueSketch();
+  if (that_sketch) {
+    value_sketch_ = std::make_unique<ChunkValueSketch>(*that_sketch);
+    num_sketched_elems_ = that.num_sketched_elems_;
+  } else {
+    value_sketch_.reset();
+  }
+}
+
+void Encoder::reduceValueSketch(const Encoder& that) {
+  const auto that_sketch = that.getValueSketch();
+  if (value_sketch_ && that_sketch) {
+    value_sketch_->merge(*that_sketch);
+    num_sketched_elems_ += that.num_sketched_elems_;
+  } else {
+    value_sketch_.reset();
+  }
 }
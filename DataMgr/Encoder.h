@@ -25,6 +25,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -150,6 +151,18 @@ class Encoder {
   Encoder(Data_Namespace::AbstractBuffer* buffer);
   virtual ~Encoder() {}
 
+  //! Values of the rows of a run-length or frame-of-reference encoded chunk, for the
+  //! consumers which need one fixed width value per row (join hash tables, UPDATE).
+  static std::vector<int64_t> decodePackedChunk(const int8_t* buffer,
+                                                const size_t num_elems,
+                                                const SQLTypeInfo& ti);
+  //! Chunk buffer of the given values in the encoding of the column type.
+  static std::vector<int8_t> encodePackedChunk(const std::vector<int64_t>& values,
+                                               const SQLTypeInfo& ti);
+  static size_t getPackedChunkSize(const int8_t* buffer,
+                                   const size_t num_elems,
+                                   const SQLTypeInfo& ti);
+
   //! Append data to the chunk buffer backing this encoder.
   //! @param src_data Source data for the append
   //! @param num_elems_to_append Number of elements to append
@@ -214,13 +227,64 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  /**
+   * @brief: Start building a value sketch (Bloom filter and NDV estimate) over the
+   * appended values. Must be called on an empty chunk, so that the sketch sees every
+   * element; a no-op for types the sketch does not support.
+   */
+  void enableValueSketch();
+
+  /**
+   * @brief: Value sketch of the chunk, or nullptr if the encoder does not build one or
+   * some of the chunk's elements were never added to it.
+   */
+  const ChunkValueSketch* getValueSketch() const;
+  void writeValueSketch(FILE* f) const;
+  void readValueSketch(FILE* f);
+
  protected:
+  void addToValueSketch(const int64_t val) {
+    if (value_sketch_) {
+      value_sketch_->add(val);
+      ++num_sketched_elems_;
+    }
+  }
+
+  void addNullToValueSketch() {
+    if (value_sketch_) {
+      ++num_sketched_elems_;
+    }
+  }
+
+  template <typename T>
+  void addToValueSketch(const T* values, const size_t num_values, const T null_val) {
+    if (!value_sketch_) {
+      return;
+    }
+    for (size_t i = 0; i < num_values; ++i) {
+      if (values[i] != null_val) {
+        value_sketch_->add(static_cast<int64_t>(values[i]));
+      }
+    }
+    num_sketched_elems_ += num_values;
+  }
+
+  // Called when chunk values change without passing through the sketch, e.g. in-place
+  // updates which only report the new min/max. The chunk never gets a sketch again.
+  void dropValueSketch() { value_sketch_.reset(); }
+
+  void copyValueSketch(const Encoder& that);
+  void reduceValueSketch(const Encoder& that);
+
   size_t num_elems_;
 
   Data_Namespace::AbstractBuffer* buffer_;
 
   DecimalOverflowValidator decimal_overflow_validator_;
   DateDaysOverflowValidator date_days_overflow_validator_;
+
+  std::unique_ptr<ChunkValueSketch> value_sketch_;
+  size_t num_sketched_elems_;
 };
 
 #endif  // Encoder_h
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EncoderKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define VECTORIZED_KERNEL \
+  __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+#else
+#define VECTORIZED_KERNEL
+#endif
+
+namespace encoder_kernels {
+
+namespace {
+
+// Values per block, one 512-bit register worth. Every lane keeps its own running min
+// and max, so that the compiler doesn't need to reorder the reduction to vectorize it.
+template <typename T>
+constexpr size_t kLaneCount = 64 / sizeof(T);
+
+}  // namespace
+
+template <typename T>
+VECTORIZED_KERNEL void update_stats(const T* values,
+                                    const size_t num_values,
+                                    const T null_val,
+                                    T& min,
+                                    T& max,
+                                    bool& has_nulls) {
+  constexpr size_t lane_count = kLaneCount<T>;
+  T lane_min[lane_count];
+  T lane_max[lane_count];
+  T lane_nulls[lane_count];
+  for (size_t j = 0; j < lane_count; ++j) {
+    lane_min[j] = min;
+    lane_max[j] = max;
+    lane_nulls[j] = 0;
+  }
+  size_t i = 0;
+  for (; i + lane_count <= num_values; i += lane_count) {
+    for (size_t j = 0; j < lane_count; ++j) {
+      const T val = values[i + j];
+      const bool is_null = val == null_val;
+      // nulls are replaced by the neutral element rather than skipped, selects vectorize
+      // where a conditional update doesn't
+      lane_nulls[j] = is_null ? T(1) : lane_nulls[j];
+      const T for_min = is_null ? std::numeric_limits<T>::max() : val;
+      const T for_max = is_null ? std::numeric_limits<T>::lowest() : val;
+      lane_min[j] = for_min < lane_min[j] ? for_min : lane_min[j];
+      lane_max[j] = for_max > lane_max[j] ? for_max : lane_max[j];
+    }
+  }
+  bool nulls{false};
+  for (size_t j = 0; j < lane_count; ++j) {
+    min = std::min(min, lane_min[j]);
+    max = std::max(max, lane_max[j]);
+    nulls = nulls || lane_nulls[j] != 0;
+  }
+  for (; i < num_values; ++i) {
+    const T val = values[i];
+    if (val == null_val) {
+      nulls = true;
+    } else {
+      min = std::min(min, val);
+      max = std::max(max, val);
+    }
+  }
+  has_nulls = has_nulls || nulls;
+}
+
+template <typename T, typename V>
+VECTORIZED_KERNEL bool narrow(const T* values, const size_t num_values, V* narrowed) {
+  uint8_t overflow{0};
+  for (size_t i = 0; i < num_values; ++i) {
+    const V val = static_cast<V>(values[i]);
+    narrowed[i] = val;
+    overflow |= static_cast<T>(val) != values[i];
+  }
+  return !overflow;
+}
+
+#define INSTANTIATE_UPDATE_STATS(T) \
+  template void update_stats(const T*, const size_t, const T, T&, T&, bool&);
+
+INSTANTIATE_UPDATE_STATS(int8_t)
+INSTANTIATE_UPDATE_STATS(int16_t)
+INSTANTIATE_UPDATE_STATS(int32_t)
+INSTANTIATE_UPDATE_STATS(int64_t)
+INSTANTIATE_UPDATE_STATS(uint8_t)
+INSTANTIATE_UPDATE_STATS(uint16_t)
+INSTANTIATE_UPDATE_STATS(float)
+INSTANTIATE_UPDATE_STATS(double)
+
+#undef INSTANTIATE_UPDATE_STATS
+
+template bool narrow(const int16_t*, const size_t, int8_t*);
+template bool narrow(const int32_t*, const size_t, int8_t*);
+template bool narrow(const int32_t*, const size_t, int16_t*);
+template bool narrow(const int64_t*, const size_t, int8_t*);
+template bool narrow(const int64_t*, const size_t, int16_t*);
+template bool narrow(const int64_t*, const size_t, int32_t*);
+
+}  // namespace encoder_kernels
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file EncoderKernels.h
+ * @brief Loops over the appended values of fixed width encoders
+ *
+ * The kernels are branch free, so that they vectorize. On x86-64 they are built for
+ * AVX-512, AVX2 and the baseline ISA, the best version for the CPU being picked when the
+ * library is loaded.
+ */
+
+#ifndef ENCODER_KERNELS_H
+#define ENCODER_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace encoder_kernels {
+
+/**
+ * Folds the values other than null_val into min and max and sets has_nulls if null_val
+ * occurs. NaNs are skipped, like std::min and std::max do.
+ */
+template <typename T>
+void update_stats(const T* values,
+                  const size_t num_values,
+                  const T null_val,
+                  T& min,
+                  T& max,
+                  bool& has_nulls);
+
+/**
+ * Converts the values to the narrower type V. Returns false if some value doesn't fit
+ * into V, narrowed then holds the truncated values.
+ */
+template <typename T, typename V>
+bool narrow(const T* values, const size_t num_values, V* narrowed);
+
+}  // namespace encoder_kernels
+
+#endif  // ENCODER_KERNELS_H
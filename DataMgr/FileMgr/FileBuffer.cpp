@@ -398,6 +398,9 @@ void FileBuffer::writeHeader(Page& page,
 
 void FileBuffer::readMetadata(const Page& page) {
   FILE* f = fm_->getFileForFileId(page.fileId);
+  // page headers are written with positional I/O behind the stream's back, so drop
+  // anything the stream may have buffered before reading through it
+  fflush(f);
   fseek(f, page.pageNum * METADATA_PAGE_SIZE + reservedHeaderSize_, SEEK_SET);
   fread((int8_t*)&pageSize_, sizeof(size_t), 1, f);
   fread((int8_t*)&size_, sizeof(size_t), 1, f);
@@ -405,7 +408,8 @@ void FileBuffer::readMetadata(const Page& page) {
                                        // encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int), typeData.size(), f);
   int version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  // add backward compatibility code here
+  CHECK(version == METADATA_VERSION || version == METADATA_VERSION_VALUE_SKETCH);
   bool has_encoder = static_cast<bool>(typeData[1]);
   if (has_encoder) {
     sql_type_.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -418,6 +422,9 @@ void FileBuffer::readMetadata(const Page& page) {
     sql_type_.set_size(typeData[9]);
     initEncoder(sql_type_);
     encoder_->readMetadata(f);
+    if (version == METADATA_VERSION_VALUE_SKETCH) {
+      encoder_->readValueSketch(f);
+    }
   }
 }
 
@@ -432,7 +439,10 @@ void FileBuffer::writeMetadata(const int epoch) {
   fwrite((int8_t*)&size_, sizeof(size_t), 1, f);
   vector<int> typeData(NUM_METADATA);  // assumes we will encode hasEncoder, bufferType,
                                        // encodingType, encodingBits all as int
-  typeData[0] = METADATA_VERSION;
+  // only chunks with a value sketch use the newer layout, so that files without
+  // sketches stay readable by older servers
+  const bool has_value_sketch = hasEncoder() && encoder_->getValueSketch();
+  typeData[0] = has_value_sketch ? METADATA_VERSION_VALUE_SKETCH : METADATA_VERSION;
   typeData[1] = static_cast<int>(hasEncoder());
   if (hasEncoder()) {
     typeData[2] = static_cast<int>(sql_type_.get_type());
@@ -447,7 +457,12 @@ void FileBuffer::writeMetadata(const int epoch) {
   fwrite((int8_t*)&(typeData[0]), sizeof(int), typeData.size(), f);
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
+    if (has_value_sketch) {
+      encoder_->writeValueSketch(f);
+    }
   }
+  // keep the stream coherent with positional page I/O on the same file
+  fflush(f);
   metadataPages_.epochs.push_back(epoch);
   metadataPages_.pageVersions.push_back(page);
 }
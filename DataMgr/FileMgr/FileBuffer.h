@@ -34,6 +34,8 @@ using namespace Data_Namespace;
 
 #define NUM_METADATA 10
 #define METADATA_VERSION 0
+// encoder metadata is followed by the chunk value sketch
+#define METADATA_VERSION_VALUE_SKETCH 1
 
 namespace File_Namespace {
 
@@ -57,12 +57,10 @@ void FileInfo::initNewFile() {
 }
 
 size_t FileInfo::write(const size_t offset, const size_t size, int8_t* buf) {
-  std::lock_guard<std::mutex> lock(readWriteMutex_);
   return File_Namespace::write(f, offset, size, buf);
 }
 
 size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
-  std::lock_guard<std::mutex> lock(readWriteMutex_);
   return File_Namespace::read(f, offset, size, buf);
 }
 
@@ -78,8 +76,8 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec,
 
     constexpr size_t MAX_INTS_TO_READ{10};  // currently use 1+6 ints
     int ints[MAX_INTS_TO_READ];
-    CHECK_EQ(fseek(f, pageNum * pageSize, SEEK_SET), 0);
-    CHECK_EQ(fread(ints, sizeof(int), MAX_INTS_TO_READ, f), MAX_INTS_TO_READ);
+    File_Namespace::read(
+        f, pageNum * pageSize, MAX_INTS_TO_READ * sizeof(int), (int8_t*)ints);
 
     headerSize = ints[0];
     if (0 != headerSize) {
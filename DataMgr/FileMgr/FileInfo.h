@@ -63,7 +63,6 @@ struct FileInfo {
   // free pages)
   std::set<size_t> freePages;  /// set of page numbers of free pages
   std::mutex freePagesMutex_;
-  std::mutex readWriteMutex_;
 
   /// Constructor
   FileInfo(FileMgr* fileMgr,
@@ -83,6 +82,8 @@ struct FileInfo {
   void freePageDeferred(int pageId);
   void freePage(int pageId);
   int getFreePage();
+  /// Page reads and writes use positional I/O and need no per-file lock, so readers
+  /// of different pages in the same file proceed in parallel.
   size_t write(const size_t offset, const size_t size, int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
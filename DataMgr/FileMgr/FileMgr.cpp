@@ -38,6 +38,7 @@
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
+#include "Shared/threadpool.h"
 
 #define EPOCH_FILENAME "epoch"
 #define DB_META_FILENAME "dbmeta"
@@ -163,7 +164,7 @@ void FileMgr::init(const size_t num_reader_threads) {
     int fileCount = 0;
     int threadCount = std::thread::hardware_concurrency();
     std::vector<HeaderInfo> headerVec;
-    std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+    std::vector<threadpool::Future<std::vector<HeaderInfo>>> file_futures;
     for (boost::filesystem::directory_iterator fileIt(path); fileIt != endItr; ++fileIt) {
       if (boost::filesystem::is_regular_file(fileIt->status())) {
         // note that boost::filesystem leaves preceding dot on
@@ -195,8 +196,8 @@ void FileMgr::init(const size_t num_reader_threads) {
           VLOG(4) << "File id: " << fileId << " Page size: " << pageSize
                   << " Num pages: " << numPages;
 
-          file_futures.emplace_back(std::async(
-              std::launch::async, [filePath, fileId, pageSize, numPages, this] {
+          file_futures.emplace_back(
+              threadpool::async([filePath, fileId, pageSize, numPages, this] {
                 std::vector<HeaderInfo> tempHeaderVec;
                 openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
                 return tempHeaderVec;
@@ -294,7 +295,7 @@ void FileMgr::init(const size_t num_reader_threads) {
 }
 
 void FileMgr::processFileFutures(
-    std::vector<std::future<std::vector<HeaderInfo>>>& file_futures,
+    std::vector<threadpool::Future<std::vector<HeaderInfo>>>& file_futures,
     std::vector<HeaderInfo>& headerVec) {
   for (auto& file_future : file_futures) {
     file_future.wait();
@@ -329,7 +330,7 @@ void FileMgr::init(const std::string dataPathToConvertFrom) {
     int fileCount = 0;
     int threadCount = std::thread::hardware_concurrency();
     std::vector<HeaderInfo> headerVec;
-    std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+    std::vector<threadpool::Future<std::vector<HeaderInfo>>> file_futures;
     for (boost::filesystem::directory_iterator fileIt(path); fileIt != endItr; ++fileIt) {
       if (boost::filesystem::is_regular_file(fileIt->status())) {
         // note that boost::filesystem leaves preceding dot on
@@ -358,8 +359,8 @@ void FileMgr::init(const std::string dataPathToConvertFrom) {
           CHECK(fileSize % pageSize == 0);  // should be no partial pages
           size_t numPages = fileSize / pageSize;
 
-          file_futures.emplace_back(std::async(
-              std::launch::async, [filePath, fileId, pageSize, numPages, this] {
+          file_futures.emplace_back(
+              threadpool::async([filePath, fileId, pageSize, numPages, this] {
                 std::vector<HeaderInfo> tempHeaderVec;
                 openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
                 return tempHeaderVec;
@@ -38,6 +38,7 @@
 #include "DataMgr/FileMgr/FileInfo.h"
 #include "DataMgr/FileMgr/Page.h"
 #include "Shared/mapd_shared_mutex.h"
+#include "Shared/threadpool.h"
 
 using namespace Data_Namespace;
 
@@ -288,8 +289,9 @@ class FileMgr : public AbstractBufferMgr {  // implements
   bool openDBMetaFile(const std::string& DBMetaFileName);
   void writeAndSyncDBMetaToDisk();
   void setEpoch(int epoch);  // resets current value of epoch at startup
-  void processFileFutures(std::vector<std::future<std::vector<HeaderInfo>>>& file_futures,
-                          std::vector<HeaderInfo>& headerVec);
+  void processFileFutures(
+      std::vector<threadpool::Future<std::vector<HeaderInfo>>>& file_futures,
+      std::vector<HeaderInfo>& headerVec);
   FileBuffer* createBufferUnlocked(const ChunkKey& key,
                                    size_t pageSize = 0,
                                    const size_t numBytes = 0);
@@ -21,8 +21,10 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 #include "AbstractBuffer.h"
 #include "Encoder.h"
+#include "EncoderKernels.h"
 
 #include <Shared/DatumFetchers.h>
 #include <tbb/parallel_for.h>
@@ -43,28 +45,43 @@ class FixedLengthEncoder : public Encoder {
                                             const SQLTypeInfo& ti,
                                             const bool replicating = false,
                                             const int64_t offset = -1) override {
-    T* unencoded_data = reinterpret_cast<T*>(src_data);
-    auto encoded_data = std::make_unique<V[]>(num_elems_to_append);
-    for (size_t i = 0; i < num_elems_to_append; ++i) {
-      size_t ri = replicating ? 0 : i;
-      encoded_data.get()[i] = encodeDataAndUpdateStats(unencoded_data[ri]);
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    if (offset != -1) {
+      // overwritten values may still be in the sketch, but the element count no longer
+      // says whether every value was added to it
+      dropValueSketch();
+      CHECK(!replicating);
+      CHECK_GE(offset, 0);
     }
-
     // assume always CPU_BUFFER?
+    for (size_t block_start = 0; block_start < num_elems_to_append;
+         block_start += kEncodeBlockSize) {
+      const size_t block_size =
+          std::min(kEncodeBlockSize, num_elems_to_append - block_start);
+      encoded_scratch_.resize(block_size);
+      V* encoded_data = encoded_scratch_.data();
+      if (replicating) {
+        for (size_t i = 0; i < block_size; ++i) {
+          encoded_data[i] = encodeDataAndUpdateStats(unencoded_data[0]);
+        }
+      } else {
+        encodeDataAndUpdateStats(unencoded_data + block_start, block_size, encoded_data);
+      }
+      if (offset == -1) {
+        buffer_->append(reinterpret_cast<int8_t*>(encoded_data), block_size * sizeof(V));
+      } else {
+        buffer_->write(reinterpret_cast<int8_t*>(encoded_data),
+                       block_size * sizeof(V),
+                       static_cast<size_t>(offset) + block_start * sizeof(V));
+      }
+    }
     if (offset == -1) {
       num_elems_ += num_elems_to_append;
-      buffer_->append(reinterpret_cast<int8_t*>(encoded_data.get()),
-                      num_elems_to_append * sizeof(V));
       if (!replicating) {
         src_data += num_elems_to_append * sizeof(T);
       }
     } else {
       num_elems_ = offset + num_elems_to_append;
-      CHECK(!replicating);
-      CHECK_GE(offset, 0);
-      buffer_->write(reinterpret_cast<int8_t*>(encoded_data.get()),
-                     num_elems_to_append * sizeof(V),
-                     static_cast<size_t>(offset));
     }
     auto chunk_metadata = std::make_shared<ChunkMetadata>();
     getMetadata(chunk_metadata);
@@ -88,6 +105,7 @@ class FixedLengthEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -99,6 +117,7 @@ class FixedLengthEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -107,8 +126,15 @@ class FixedLengthEncoder : public Encoder {
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
-    for (size_t i = 0; i < num_elements; ++i) {
-      encodeDataAndUpdateStats(unencoded_data[i]);
+    for (size_t block_start = 0; block_start < num_elements;
+         block_start += kEncodeBlockSize) {
+      const size_t block_size = std::min(kEncodeBlockSize, num_elements - block_start);
+      if (!updateBlockStats(unencoded_data + block_start, block_size)) {
+        // some values don't fit into V, go value by value to log them
+        for (size_t i = block_start; i < block_start + block_size; ++i) {
+          encodeDataAndUpdateStats(unencoded_data[i]);
+        }
+      }
     }
   }
 
@@ -126,12 +152,13 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceValueSketch(that);
   }
 
   void copyMetadata(const Encoder* copyFromEncoder) override {
@@ -141,6 +168,7 @@ class FixedLengthEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copyValueSketch(*copyFromEncoder);
   }
 
   void writeMetadata(FILE* f) override {
@@ -178,6 +206,49 @@ class FixedLengthEncoder : public Encoder {
   bool has_nulls;
 
  private:
+  // Values encoded at a time, which bounds the scratch buffer whatever the size of the
+  // appends.
+  static constexpr size_t kEncodeBlockSize{64 * 1024};
+
+  void encodeDataAndUpdateStats(const T* unencoded_data,
+                                const size_t num_elems,
+                                V* encoded_data) {
+    if (!encoder_kernels::narrow(unencoded_data, num_elems, encoded_data)) {
+      // some values don't fit into V, go value by value to log them
+      for (size_t i = 0; i < num_elems; ++i) {
+        encoded_data[i] = encodeDataAndUpdateStats(unencoded_data[i]);
+      }
+      return;
+    }
+    const bool in_range = updateBlockStats(unencoded_data, num_elems);
+    CHECK(in_range);
+  }
+
+  // Folds the values into the stats without encoding them. Returns false and leaves the
+  // stats untouched if some value doesn't fit into V.
+  bool updateBlockStats(const T* unencoded_data, const size_t num_elems) {
+    const T null_val = std::numeric_limits<V>::min();
+    T batch_min = std::numeric_limits<T>::max();
+    T batch_max = std::numeric_limits<T>::lowest();
+    bool batch_has_nulls{false};
+    encoder_kernels::update_stats(
+        unencoded_data, num_elems, null_val, batch_min, batch_max, batch_has_nulls);
+    if (batch_min <= batch_max) {
+      // the extremes are the only values which can overflow
+      if (batch_min < std::numeric_limits<V>::min() ||
+          batch_max > std::numeric_limits<V>::max()) {
+        return false;
+      }
+      decimal_overflow_validator_.validate(batch_min);
+      decimal_overflow_validator_.validate(batch_max);
+      dataMin = std::min(dataMin, batch_min);
+      dataMax = std::max(dataMax, batch_max);
+    }
+    has_nulls = has_nulls || batch_has_nulls;
+    addToValueSketch(unencoded_data, num_elems, null_val);
+    return true;
+  }
+
   V encodeDataAndUpdateStats(const T& unencoded_data) {
     V encoded_data = static_cast<V>(unencoded_data);
     if (unencoded_data != encoded_data) {
@@ -185,18 +256,25 @@ class FixedLengthEncoder : public Encoder {
       LOG(ERROR) << "Fixed encoding failed, Unencoded: " +
                         std::to_string(unencoded_data) +
                         " encoded: " + std::to_string(encoded_data);
+      addToValueSketch(static_cast<int64_t>(encoded_data));
     } else {
       T data = unencoded_data;
       if (data == std::numeric_limits<V>::min()) {
         has_nulls = true;
+        addNullToValueSketch();
       } else {
         decimal_overflow_validator_.validate(data);
         dataMin = std::min(dataMin, data);
         dataMax = std::max(dataMax, data);
+        addToValueSketch(static_cast<int64_t>(data));
       }
     }
     return encoded_data;
   }
+
+  // reused across appends, so that loading a chunk in batches doesn't allocate each time,
+  // holds at most kEncodeBlockSize values
+  std::vector<V> encoded_scratch_;
 };  // FixedLengthEncoder
 
 #endif  // FIXED_LENGTH_ENCODER_H
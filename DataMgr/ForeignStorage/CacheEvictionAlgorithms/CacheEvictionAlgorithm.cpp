@@ -0,0 +1,47 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CacheEvictionAlgorithm.h"
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include "LRUEvictionAlgorithm.h"
+#include "Logger/Logger.h"
+#include "TwoQueueEvictionAlgorithm.h"
+
+EvictionPolicy parse_eviction_policy(const std::string& policy_name) {
+  const auto name = boost::algorithm::to_lower_copy(policy_name);
+  if (name == "lru") {
+    return EvictionPolicy::LRU;
+  }
+  if (name == "2q") {
+    return EvictionPolicy::TWO_QUEUE;
+  }
+  throw std::runtime_error("Invalid cache eviction policy \"" + policy_name +
+                           "\". Valid options are \"lru\" and \"2q\".");
+}
+
+std::unique_ptr<CacheEvictionAlgorithm> create_eviction_algorithm(
+    const EvictionPolicy policy) {
+  switch (policy) {
+    case EvictionPolicy::LRU:
+      return std::make_unique<LRUEvictionAlgorithm>();
+    case EvictionPolicy::TWO_QUEUE:
+      return std::make_unique<TwoQueueEvictionAlgorithm>();
+  }
+  UNREACHABLE();
+  return nullptr;
+}
@@ -27,6 +27,10 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "DataMgr/AbstractBufferMgr.h"
 
 class NoEntryFoundException : public std::runtime_error {
@@ -41,4 +45,21 @@ class CacheEvictionAlgorithm {
   virtual const ChunkKey evictNextChunk() = 0;
   virtual void touchChunk(const ChunkKey&) = 0;
   virtual void removeChunk(const ChunkKey&) = 0;
+  // All tracked chunks, in the order evictNextChunk would return them. Used by callers
+  // which cannot evict an arbitrary chunk, such as the BufferMgr which needs contiguous
+  // unpinned segments.
+  virtual std::vector<ChunkKey> getEvictionOrder() const = 0;
+  // Tells the algorithm that the caller evicted the chunk on its own, as opposed to a
+  // removal of the chunk from the cache.
+  virtual void markChunkEvicted(const ChunkKey& key) { removeChunk(key); }
+  // Used for debugging.
+  virtual std::string dumpEvictionQueue() = 0;
 };
+
+enum class EvictionPolicy { LRU, TWO_QUEUE };
+
+// Accepts "lru" and "2q", throws for anything else.
+EvictionPolicy parse_eviction_policy(const std::string& policy_name);
+
+std::unique_ptr<CacheEvictionAlgorithm> create_eviction_algorithm(
+    const EvictionPolicy policy);
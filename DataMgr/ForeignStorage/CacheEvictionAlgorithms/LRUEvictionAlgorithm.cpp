@@ -53,6 +53,10 @@ void LRUEvictionAlgorithm::removeChunk(const ChunkKey& key) {
   cache_items_map_.erase(key);
 }
 
+std::vector<ChunkKey> LRUEvictionAlgorithm::getEvictionOrder() const {
+  return std::vector<ChunkKey>(cache_items_list_.rbegin(), cache_items_list_.rend());
+}
+
 std::string LRUEvictionAlgorithm::dumpEvictionQueue() {
   std::string ret = "Eviction queue:\n{";
   for (auto chunk : cache_items_list_)
@@ -44,8 +44,9 @@ class LRUEvictionAlgorithm : public CacheEvictionAlgorithm {
   void touchChunk(const ChunkKey&) override;
   // Removes a chunk from the eviction queue if present.
   void removeChunk(const ChunkKey&) override;
+  std::vector<ChunkKey> getEvictionOrder() const override;
   // Used for debugging.
-  std::string dumpEvictionQueue();
+  std::string dumpEvictionQueue() override;
 
  private:
   std::list<ChunkKey> cache_items_list_;
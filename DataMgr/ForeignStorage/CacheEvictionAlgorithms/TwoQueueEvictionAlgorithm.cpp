@@ -0,0 +1,147 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TwoQueueEvictionAlgorithm.h"
+
+#include <algorithm>
+
+bool TwoQueueEvictionAlgorithm::evictFromNewQueue(const size_t new_count,
+                                                  const size_t main_count) {
+  return new_count > 0 &&
+         (main_count == 0 || new_count > kNewQueueFraction * (new_count + main_count));
+}
+
+const ChunkKey TwoQueueEvictionAlgorithm::evictNextChunk() {
+  if (cache_items_map_.empty()) {
+    throw NoEntryFoundException();
+  }
+  const bool from_new_queue = evictFromNewQueue(new_queue_.size(), main_queue_.size());
+  const ChunkKey ret = from_new_queue ? new_queue_.back() : main_queue_.back();
+  eraseEntry(cache_items_map_.find(ret));
+  if (from_new_queue) {
+    addToGhostQueue(ret);
+  }
+  return ret;
+}
+
+void TwoQueueEvictionAlgorithm::touchChunk(const ChunkKey& key) {
+  auto it = cache_items_map_.find(key);
+  if (it != cache_items_map_.end()) {
+    auto& entry = it->second;
+    if (entry.in_main_queue) {
+      main_queue_.splice(main_queue_.begin(), main_queue_, entry.it);
+      return;
+    }
+    const size_t correlated_reference_count = std::max(
+        size_t(1),
+        static_cast<size_t>(kCorrelatedReferenceFraction * max_cache_items_count_));
+    if (new_chunk_count_ - entry.new_chunk_seq >= correlated_reference_count) {
+      main_queue_.splice(main_queue_.begin(), new_queue_, entry.it);
+      entry.in_main_queue = true;
+    }
+    return;
+  }
+  auto ghost_it = ghost_items_map_.find(key);
+  if (ghost_it != ghost_items_map_.end()) {
+    ghost_queue_.erase(ghost_it->second);
+    ghost_items_map_.erase(ghost_it);
+    main_queue_.emplace_front(key);
+    cache_items_map_.emplace(key, Entry{true, main_queue_.begin(), new_chunk_count_});
+  } else {
+    new_queue_.emplace_front(key);
+    cache_items_map_.emplace(key, Entry{false, new_queue_.begin(), ++new_chunk_count_});
+  }
+  max_cache_items_count_ = std::max(max_cache_items_count_, cache_items_map_.size());
+}
+
+void TwoQueueEvictionAlgorithm::removeChunk(const ChunkKey& key) {
+  auto it = cache_items_map_.find(key);
+  if (it != cache_items_map_.end()) {
+    eraseEntry(it);
+  }
+  auto ghost_it = ghost_items_map_.find(key);
+  if (ghost_it != ghost_items_map_.end()) {
+    ghost_queue_.erase(ghost_it->second);
+    ghost_items_map_.erase(ghost_it);
+  }
+}
+
+std::vector<ChunkKey> TwoQueueEvictionAlgorithm::getEvictionOrder() const {
+  std::vector<ChunkKey> ret;
+  ret.reserve(cache_items_map_.size());
+  auto new_it = new_queue_.rbegin();
+  auto main_it = main_queue_.rbegin();
+  size_t new_count = new_queue_.size();
+  size_t main_count = main_queue_.size();
+  while (new_count + main_count > 0) {
+    if (evictFromNewQueue(new_count, main_count)) {
+      ret.push_back(*new_it++);
+      --new_count;
+    } else {
+      ret.push_back(*main_it++);
+      --main_count;
+    }
+  }
+  return ret;
+}
+
+void TwoQueueEvictionAlgorithm::markChunkEvicted(const ChunkKey& key) {
+  auto it = cache_items_map_.find(key);
+  if (it == cache_items_map_.end()) {
+    return;
+  }
+  const bool in_main_queue = it->second.in_main_queue;
+  eraseEntry(it);
+  if (!in_main_queue) {
+    addToGhostQueue(key);
+  }
+}
+
+std::string TwoQueueEvictionAlgorithm::dumpEvictionQueue() {
+  std::string ret = "Eviction queue:\n{";
+  for (const auto& chunk : getEvictionOrder()) {
+    ret += show_chunk(chunk) + (isInMainQueue(chunk) ? " (main), " : ", ");
+  }
+  ret += "}\nGhost queue:\n{";
+  for (const auto& chunk : ghost_queue_) {
+    ret += show_chunk(chunk) + ", ";
+  }
+  ret += "}\n";
+  return ret;
+}
+
+bool TwoQueueEvictionAlgorithm::isInMainQueue(const ChunkKey& key) const {
+  auto it = cache_items_map_.find(key);
+  return it != cache_items_map_.end() && it->second.in_main_queue;
+}
+
+void TwoQueueEvictionAlgorithm::eraseEntry(
+    std::map<const ChunkKey, Entry>::iterator entry_it) {
+  auto& queue = entry_it->second.in_main_queue ? main_queue_ : new_queue_;
+  queue.erase(entry_it->second.it);
+  cache_items_map_.erase(entry_it);
+}
+
+void TwoQueueEvictionAlgorithm::addToGhostQueue(const ChunkKey& key) {
+  ghost_queue_.emplace_front(key);
+  ghost_items_map_[key] = ghost_queue_.begin();
+  const size_t max_ghost_count = std::max(
+      size_t(1), static_cast<size_t>(kGhostQueueFraction * max_cache_items_count_));
+  while (ghost_queue_.size() > max_ghost_count) {
+    ghost_items_map_.erase(ghost_queue_.back());
+    ghost_queue_.pop_back();
+  }
+}
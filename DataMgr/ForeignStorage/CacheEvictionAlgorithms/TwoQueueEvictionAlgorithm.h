@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file	TwoQueueEvictionAlgorithm.h
+ *
+ * This file includes the class specification for the 2Q cache eviction algorithm
+ * (Johnson and Shasha, VLDB 1994).
+ *
+ * Chunks seen for the first time enter a FIFO queue which holds at most a fixed share
+ * of the tracked chunks. Chunks evicted from that queue are remembered, without their
+ * data, in a bounded ghost queue. A chunk moves to the main queue, which is kept in LRU
+ * order, when it is touched again while it is remembered there, or while it is still
+ * in the FIFO queue but after enough other chunks came in that the touch is unlikely to
+ * be part of the same scan. A scan which touches every chunk of a table once only ever
+ * displaces chunks from the FIFO queue, so the chunks that are used repeatedly stay
+ * cached.
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+
+#include "CacheEvictionAlgorithm.h"
+
+class TwoQueueEvictionAlgorithm : public CacheEvictionAlgorithm {
+ public:
+  ~TwoQueueEvictionAlgorithm() override {}
+  // Returns the next chunk to evict.
+  const ChunkKey evictNextChunk() override;
+  // Update the algorithm knowing that this chunk was recently touched by the system.
+  void touchChunk(const ChunkKey&) override;
+  // Removes a chunk from the queues, including the ghost queue, if present.
+  void removeChunk(const ChunkKey&) override;
+  std::vector<ChunkKey> getEvictionOrder() const override;
+  void markChunkEvicted(const ChunkKey&) override;
+  // Used for debugging.
+  std::string dumpEvictionQueue() override;
+
+  // Exists for testing purposes.
+  bool isInMainQueue(const ChunkKey& key) const;
+
+  // Share of the tracked chunks the FIFO queue of new chunks can hold before it is
+  // evicted from first.
+  static constexpr double kNewQueueFraction{0.25};
+  // Size of the ghost queue relative to the largest number of chunks tracked so far,
+  // which stands in for the capacity of the cache.
+  static constexpr double kGhostQueueFraction{0.5};
+  // A touch of a chunk in the FIFO queue is treated as correlated with the touch that
+  // brought it in, and does not promote it, until this share of the largest number of
+  // chunks tracked so far, and at least one chunk, came in after it.
+  static constexpr double kCorrelatedReferenceFraction{0.1};
+
+ private:
+  struct Entry {
+    bool in_main_queue;
+    std::list<ChunkKey>::iterator it;
+    // Value of new_chunk_count_ after the chunk came in.
+    size_t new_chunk_seq;
+  };
+
+  static bool evictFromNewQueue(const size_t new_count, const size_t main_count);
+
+  void eraseEntry(std::map<const ChunkKey, Entry>::iterator entry_it);
+
+  void addToGhostQueue(const ChunkKey& key);
+
+  // Front is the most recently added or touched chunk in all queues.
+  std::list<ChunkKey> new_queue_;
+  std::list<ChunkKey> main_queue_;
+  std::list<ChunkKey> ghost_queue_;
+  std::map<const ChunkKey, Entry> cache_items_map_;
+  std::map<const ChunkKey, std::list<ChunkKey>::iterator> ghost_items_map_;
+  size_t max_cache_items_count_{0};
+  size_t new_chunk_count_{0};
+};
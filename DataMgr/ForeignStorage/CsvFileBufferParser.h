@@ -350,6 +350,7 @@ ParseBufferResult parse_buffer(ParseBufferRequest& request) {
   const char* buf_end = request.buffer.get() + request.buffer_size;
 
   std::vector<std::string_view> row;
+  import_export::delimited_parser::FieldBufferArena field_buffers;
   size_t row_index_plus_one = 0;
   const char* p = thread_buf;
   bool try_single_thread = false;
@@ -369,9 +370,8 @@ ParseBufferResult parse_buffer(ParseBufferRequest& request) {
   std::string file_path = request.getFilePath();
   for (; p < thread_buf_end && remaining_row_count > 0; p++, remaining_row_count--) {
     row.clear();
+    field_buffers.reset();
     row_count++;
-    std::vector<std::unique_ptr<char[]>>
-        tmp_buffers;  // holds string w/ removed escape chars, etc
 
     p = import_export::delimited_parser::get_row(p,
                                                  thread_buf_end,
@@ -379,7 +379,7 @@ ParseBufferResult parse_buffer(ParseBufferRequest& request) {
                                                  request.copy_params,
                                                  array_flags.get(),
                                                  row,
-                                                 tmp_buffers,
+                                                 field_buffers,
                                                  try_single_thread);
 
     row_index_plus_one++;
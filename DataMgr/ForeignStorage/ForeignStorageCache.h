@@ -44,6 +44,7 @@ struct DiskCacheConfig {
   DiskCacheLevel enabled_level = DiskCacheLevel::none;
   uint64_t size_limit = 21474836480;  // 20GB default
   size_t num_reader_threads = 0;
+  EvictionPolicy eviction_policy = EvictionPolicy::LRU;
   inline bool isEnabledForMutableTables() const {
     return enabled_level == DiskCacheLevel::non_fsi ||
            enabled_level == DiskCacheLevel::all;
@@ -59,9 +60,8 @@ using namespace Data_Namespace;
 namespace foreign_storage {
 
 struct TableEvictionTracker {
-  // We can swap out different eviction algorithms here.
-  std::unique_ptr<CacheEvictionAlgorithm> eviction_alg_ =
-      std::make_unique<LRUEvictionAlgorithm>();
+  // The algorithm is selected by DiskCacheConfig::eviction_policy.
+  std::unique_ptr<CacheEvictionAlgorithm> eviction_alg_;
   size_t num_pages_ = 0;
 };
 
@@ -129,6 +129,7 @@ class ForeignStorageCache {
   void createTrackerMapEntryIfNoneExists(const ChunkKey& chunk_key);
 
   std::map<const ChunkKey, TableEvictionTracker> eviction_tracker_map_;
+  const EvictionPolicy eviction_policy_;
   uint64_t max_pages_per_table_;
 
   // Underlying storage is handled by a GlobalFileMgr unique to the cache.
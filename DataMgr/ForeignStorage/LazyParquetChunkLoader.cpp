@@ -36,6 +36,8 @@
 #include "ParquetTimeEncoder.h"
 #include "ParquetTimestampEncoder.h"
 #include "ParquetVariableLengthArrayEncoder.h"
+#include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 
 namespace foreign_storage {
 
@@ -677,6 +679,8 @@ std::list<std::unique_ptr<ChunkMetadata>> append_row_groups(
       auto group_reader = parquet_reader->RowGroup(row_group_index);
       std::shared_ptr<parquet::ColumnReader> col_reader =
           group_reader->Column(parquet_column_index);
+      encoder->startColumnChunk(
+          *group_reader->metadata()->ColumnChunk(parquet_column_index));
 
       while (col_reader->HasNext()) {
         int64_t levels_read =
@@ -1119,7 +1123,7 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::loadChunk(
 std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
     const std::set<std::string>& file_paths,
     const ForeignTableSchema& schema) {
-  std::list<RowGroupMetadata> row_group_metadata;
+  auto timer = DEBUG_TIMER(__func__);
   auto column_interval =
       Interval<ColumnType>{schema.getLogicalAndPhysicalColumns().front()->columnId,
                            schema.getLogicalAndPhysicalColumns().back()->columnId};
@@ -1127,20 +1131,48 @@ std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
   std::unique_ptr<parquet::arrow::FileReader> first_file_reader;
   const auto& first_file_path = *file_paths.begin();
   open_parquet_table(first_file_path, first_file_reader, file_system_);
+  validate_parquet_metadata(
+      first_file_reader->parquet_reader()->metadata(), first_file_path, schema);
   std::map<int, std::shared_ptr<ParquetEncoder>> encoder_map;
-  for (const auto& file_path : file_paths) {
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    open_parquet_table(file_path, reader, file_system_);
-    validate_equal_schema(
-        first_file_reader.get(), reader.get(), first_file_path, file_path);
-    int num_row_groups = get_parquet_table_size(reader).first;
-    auto row_group_interval = RowGroupInterval{file_path, 0, num_row_groups - 1};
-    validate_parquet_metadata(reader->parquet_reader()->metadata(), file_path, schema);
-    if (file_path == first_file_path) {
-      populate_encoder_map(encoder_map, column_interval, schema, first_file_reader);
+  populate_encoder_map(encoder_map, column_interval, schema, first_file_reader);
+
+  // Files are split into contiguous batches, one per thread, so that concatenating the
+  // per batch results preserves the file order.
+  const std::vector<std::string> file_path_vector(file_paths.begin(), file_paths.end());
+  const size_t thread_count =
+      std::min(static_cast<size_t>(cpu_threads()), file_path_vector.size());
+  auto scan_files = [&](const size_t start_index, const size_t end_index) {
+    std::list<RowGroupMetadata> row_group_metadata;
+    for (size_t i = start_index; i < end_index; ++i) {
+      const auto& file_path = file_path_vector[i];
+      std::unique_ptr<parquet::arrow::FileReader> reader;
+      if (i > 0) {
+        open_parquet_table(file_path, reader, file_system_);
+        validate_equal_schema(
+            first_file_reader.get(), reader.get(), first_file_path, file_path);
+        validate_parquet_metadata(
+            reader->parquet_reader()->metadata(), file_path, schema);
+      }
+      const auto& file_reader = i > 0 ? reader : first_file_reader;
+      int num_row_groups = get_parquet_table_size(file_reader).first;
+      auto row_group_interval = RowGroupInterval{file_path, 0, num_row_groups - 1};
+      metadata_scan_rowgroup_interval(
+          encoder_map, row_group_interval, file_reader, schema, row_group_metadata);
     }
-    metadata_scan_rowgroup_interval(
-        encoder_map, row_group_interval, reader, schema, row_group_metadata);
+    return row_group_metadata;
+  };
+
+  std::vector<threadpool::Future<std::list<RowGroupMetadata>>> futures;
+  for (size_t i = 0; i < thread_count; ++i) {
+    futures.emplace_back(
+        threadpool::async(scan_files,
+                          i * file_path_vector.size() / thread_count,
+                          (i + 1) * file_path_vector.size() / thread_count));
+  }
+  std::list<RowGroupMetadata> row_group_metadata;
+  for (auto& future : futures) {
+    // get() instead of wait() because we need to propagate potential exceptions.
+    row_group_metadata.splice(row_group_metadata.end(), future.get());
   }
   return row_group_metadata;
 }
@@ -26,6 +26,8 @@
 #include "ImportExport/Importer.h"
 #include "LazyParquetChunkLoader.h"
 #include "ParquetShared.h"
+#include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 #include "Utils/DdlUtils.h"
 
 namespace foreign_storage {
@@ -163,19 +165,19 @@ void ParquetDataWrapper::initializeChunkBuffers(
     if (column->columnType.is_varlen_indeed()) {
       data_chunk_key = {
           db_id_, foreign_table_->tableId, column->columnId, fragment_index, 1};
-      auto data_buffer = required_buffers[data_chunk_key];
+      auto data_buffer = required_buffers.at(data_chunk_key);
       CHECK(data_buffer);
       chunk.setBuffer(data_buffer);
 
       ChunkKey index_chunk_key{
           db_id_, foreign_table_->tableId, column->columnId, fragment_index, 2};
-      auto index_buffer = required_buffers[index_chunk_key];
+      auto index_buffer = required_buffers.at(index_chunk_key);
       CHECK(index_buffer);
       chunk.setIndexBuffer(index_buffer);
     } else {
       data_chunk_key = {
           db_id_, foreign_table_->tableId, column->columnId, fragment_index};
-      auto data_buffer = required_buffers[data_chunk_key];
+      auto data_buffer = required_buffers.at(data_chunk_key);
       CHECK(data_buffer);
       chunk.setBuffer(data_buffer);
     }
@@ -455,7 +457,7 @@ void ParquetDataWrapper::loadBuffersUsingLazyParquetChunkLoader(
       logical_column_id + logical_column->columnType.get_physical_cols()};
   initializeChunkBuffers(fragment_id, column_interval, required_buffers, true);
 
-  const auto& row_group_intervals = fragment_to_row_group_interval_map_[fragment_id];
+  const auto& row_group_intervals = fragment_to_row_group_interval_map_.at(fragment_id);
 
   const bool is_dictionary_encoded_string_column =
       logical_column->columnType.is_dict_encoded_string() ||
@@ -478,17 +480,17 @@ void ParquetDataWrapper::loadBuffersUsingLazyParquetChunkLoader(
     if (column_descriptor->columnType.is_varlen_indeed()) {
       ChunkKey data_chunk_key = {
           db_id_, foreign_table_->tableId, column_id, fragment_id, 1};
-      auto buffer = required_buffers[data_chunk_key];
+      auto buffer = required_buffers.at(data_chunk_key);
       CHECK(buffer);
       chunk.setBuffer(buffer);
       ChunkKey index_chunk_key = {
           db_id_, foreign_table_->tableId, column_id, fragment_id, 2};
-      auto index_buffer = required_buffers[index_chunk_key];
+      auto index_buffer = required_buffers.at(index_chunk_key);
       CHECK(index_buffer);
       chunk.setIndexBuffer(index_buffer);
     } else {
       ChunkKey chunk_key = {db_id_, foreign_table_->tableId, column_id, fragment_id};
-      auto buffer = required_buffers[chunk_key];
+      auto buffer = required_buffers.at(chunk_key);
       CHECK(buffer);
       chunk.setBuffer(buffer);
     }
@@ -508,8 +510,9 @@ void ParquetDataWrapper::loadBuffersUsingLazyParquetChunkLoader(
       if (column->columnType.is_varlen_indeed()) {
         data_chunk_key.emplace_back(1);
       }
-      CHECK(chunk_metadata_map_.find(data_chunk_key) != chunk_metadata_map_.end());
-      auto cached_metadata = chunk_metadata_map_[data_chunk_key];
+      auto cached_metadata_it = chunk_metadata_map_.find(data_chunk_key);
+      CHECK(cached_metadata_it != chunk_metadata_map_.end());
+      auto cached_metadata = cached_metadata_it->second;
       auto updated_metadata = std::make_shared<ChunkMetadata>();
       *updated_metadata = *cached_metadata;
       // for certain types, update the metadata statistics
@@ -520,8 +523,7 @@ void ParquetDataWrapper::loadBuffersUsingLazyParquetChunkLoader(
         updated_metadata->chunkStats.max = chunk_metadata_ptr->chunkStats.max;
         updated_metadata->chunkStats.min = chunk_metadata_ptr->chunkStats.min;
       }
-      CHECK(required_buffers.find(data_chunk_key) != required_buffers.end());
-      updated_metadata->numBytes = required_buffers[data_chunk_key]->size();
+      updated_metadata->numBytes = required_buffers.at(data_chunk_key)->size();
       fragmenter->updateColumnChunkMetadata(column, fragment_id, updated_metadata);
     }
   }
@@ -542,8 +544,23 @@ void ParquetDataWrapper::populateChunkBuffers(
     logical_column_ids.emplace(column_id);
   }
 
-  for (const auto column_id : logical_column_ids) {
-    loadBuffersUsingLazyParquetChunkLoader(column_id, fragment_id, required_buffers);
+  // Columns are loaded concurrently, so that decoding one column overlaps with reading
+  // the next one. Each column has its own buffers and only reads the shared maps.
+  const std::vector<int> column_ids(logical_column_ids.begin(), logical_column_ids.end());
+  const size_t thread_count =
+      std::min(static_cast<size_t>(cpu_threads()), column_ids.size());
+  std::vector<threadpool::Future<void>> futures;
+  for (size_t i = 0; i < thread_count; ++i) {
+    futures.emplace_back(threadpool::async([&, i] {
+      for (size_t j = i; j < column_ids.size(); j += thread_count) {
+        loadBuffersUsingLazyParquetChunkLoader(
+            column_ids[j], fragment_id, required_buffers);
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    // get() instead of wait() because we need to propagate potential exceptions.
+    future.get();
   }
 }
 
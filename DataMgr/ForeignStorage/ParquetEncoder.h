@@ -37,6 +37,9 @@ class ParquetEncoder {
                           const bool is_last_batch,
                           int8_t* values) = 0;
 
+  // Called before the values of each row group's column chunk are appended.
+  virtual void startColumnChunk(const parquet::ColumnChunkMetaData& column_metadata) {}
+
   virtual std::shared_ptr<ChunkMetadata> getRowGroupMetadata(
       const parquet::RowGroupMetaData* group_metadata,
       const int parquet_column_index,
@@ -23,6 +23,8 @@
 #include <parquet/schema.h>
 #include <parquet/types.h>
 
+#include <unordered_map>
+
 namespace foreign_storage {
 
 template <typename V>
@@ -51,8 +53,24 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
                                                  levels_read,
                                                  is_last_batch,
                                                  encode_buffer_.data());
+    if (is_last_batch) {
+      // The next row group comes with its own dictionary page.
+      string_id_cache_.clear();
+    }
+  }
+
+  void startColumnChunk(const parquet::ColumnChunkMetaData& column_metadata) override {
+    dictionary_encoded_ = column_metadata.has_dictionary_page();
   }
 
+  /**
+   * Values of a dictionary encoded Parquet column chunk point into its dictionary page,
+   * so string ids are cached by value address and each dictionary entry goes through
+   * the string dictionary only once per row group. Pages of such a chunk which fell
+   * back to plain encoding may reuse the same addresses for other strings, hence cache
+   * hits are checked against a copy of the string. Chunks without a dictionary page
+   * have no repeated value addresses and bypass the cache.
+   */
   void encodeAndCopyContiguous(const int8_t* parquet_data_bytes,
                                int8_t* omnisci_data_bytes,
                                const size_t num_elements) override {
@@ -60,14 +78,52 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
     auto parquet_data_ptr =
         reinterpret_cast<const parquet::ByteArray*>(parquet_data_bytes);
     auto omnisci_data_ptr = reinterpret_cast<V*>(omnisci_data_bytes);
+    if (!dictionary_encoded_) {
+      std::vector<std::string_view> string_views;
+      string_views.reserve(num_elements);
+      for (size_t i = 0; i < num_elements; ++i) {
+        auto& byte_array = parquet_data_ptr[i];
+        string_views.emplace_back(reinterpret_cast<const char*>(byte_array.ptr),
+                                  byte_array.len);
+      }
+      string_dictionary_->getOrAddBulk(string_views, omnisci_data_ptr);
+      updateMetadataStats(num_elements, omnisci_data_bytes);
+      return;
+    }
+    // Cache misses, with repeated values of the batch looked up only once.
     std::vector<std::string_view> string_views;
-    string_views.reserve(num_elements);
+    std::unordered_map<const uint8_t*, size_t> string_view_index_by_address;
+    std::vector<std::pair<size_t, size_t>> missed_values;
     for (size_t i = 0; i < num_elements; ++i) {
       auto& byte_array = parquet_data_ptr[i];
-      string_views.emplace_back(reinterpret_cast<const char*>(byte_array.ptr),
-                                byte_array.len);
+      std::string_view string_view(reinterpret_cast<const char*>(byte_array.ptr),
+                                   byte_array.len);
+      auto it = string_id_cache_.find(byte_array.ptr);
+      if (it != string_id_cache_.end() && it->second.first == string_view) {
+        omnisci_data_ptr[i] = it->second.second;
+        continue;
+      }
+      auto [index_it, inserted] =
+          string_view_index_by_address.emplace(byte_array.ptr, string_views.size());
+      if (inserted || string_views[index_it->second] != string_view) {
+        index_it->second = string_views.size();
+        string_views.emplace_back(string_view);
+      }
+      missed_values.emplace_back(i, index_it->second);
+    }
+    if (!string_views.empty()) {
+      std::vector<V> string_ids(string_views.size());
+      string_dictionary_->getOrAddBulk(string_views, string_ids.data());
+      for (const auto& [value_index, string_view_index] : missed_values) {
+        omnisci_data_ptr[value_index] = string_ids[string_view_index];
+      }
+      for (size_t i = 0; i < string_views.size() &&
+                         string_id_cache_.size() < kMaxStringIdCacheEntries;
+           ++i) {
+        string_id_cache_[reinterpret_cast<const uint8_t*>(string_views[i].data())] = {
+            std::string(string_views[i]), string_ids[i]};
+      }
     }
-    string_dictionary_->getOrAddBulk(string_views, omnisci_data_ptr);
     updateMetadataStats(num_elements, omnisci_data_bytes);
   }
 
@@ -101,9 +157,15 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
     chunk_metadata_->fillChunkStats(min_, max_, false);
   }
 
+  // Bounds the cache for plain encoded pages, which have no repeated value addresses.
+  static constexpr size_t kMaxStringIdCacheEntries{1 << 16};
+
   StringDictionary* string_dictionary_;
   std::unique_ptr<ChunkMetadata>& chunk_metadata_;
   std::vector<int8_t> encode_buffer_;
+  std::unordered_map<const uint8_t*, std::pair<std::string, V>> string_id_cache_;
+  // Values are assumed to come from a dictionary page unless told otherwise.
+  bool dictionary_encoded_{true};
 
   V min_, max_;
 };
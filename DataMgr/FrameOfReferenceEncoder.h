@@ -0,0 +1,382 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file FrameOfReferenceEncoder.h
+ * @brief Encoder of ENCODING DIFF integer, date and time columns
+ *
+ * The chunk buffer holds a Header with the frame of reference (the smallest value of the
+ * chunk) and the bit width of the codes, followed by the codes packed into 64-bit words.
+ * The code of a value is its difference to the frame of reference, the code with all
+ * bits set stands for null. The generated code extracts a code with a shift and a mask,
+ * see frame_of_reference_decode in DecodersImpl.h.
+ */
+
+#ifndef FRAME_OF_REFERENCE_ENCODER_H
+#define FRAME_OF_REFERENCE_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+
+namespace frame_of_reference {
+
+struct Header {
+  int64_t base;
+  int32_t bit_width;
+  int32_t padding;
+};
+
+constexpr size_t kHeaderSize{sizeof(Header)};
+
+inline uint64_t null_code(const int32_t bit_width) {
+  return bit_width == 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+}
+
+inline size_t word_count(const size_t num_values, const int32_t bit_width) {
+  return (num_values * bit_width + 63) / 64;
+}
+
+inline size_t buffer_size(const size_t num_values, const int32_t bit_width) {
+  return kHeaderSize + word_count(num_values, bit_width) * sizeof(uint64_t);
+}
+
+inline size_t buffer_size(const int8_t* buffer, const size_t num_values) {
+  return buffer_size(num_values, reinterpret_cast<const Header*>(buffer)->bit_width);
+}
+
+// Smallest bit width which leaves the null code out of [0, max - min].
+inline Header make_header(const int64_t min, const int64_t max) {
+  Header header{min, 1, 0};
+  if (min <= max) {
+    const auto range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    header.bit_width = 64 - __builtin_clzll(range + 1);
+  }
+  return header;
+}
+
+// Packs the code of the row at bit offset bit_pos of words, which must be zeroed there.
+inline void pack(uint64_t* words,
+                 const size_t bit_pos,
+                 const int32_t bit_width,
+                 const uint64_t code) {
+  const size_t word = bit_pos >> 6;
+  const size_t shift = bit_pos & 63;
+  words[word] |= code << shift;
+  if (shift + bit_width > 64) {
+    words[word + 1] |= code >> (64 - shift);
+  }
+}
+
+inline uint64_t unpack(const uint64_t* words, const size_t pos, const int32_t bit_width) {
+  const size_t bit_pos = pos * bit_width;
+  const size_t word = bit_pos >> 6;
+  const size_t shift = bit_pos & 63;
+  uint64_t code = words[word] >> shift;
+  if (shift + bit_width > 64) {
+    code |= words[word + 1] << (64 - shift);
+  }
+  return code & null_code(bit_width);
+}
+
+inline uint64_t get_code(const Header& header, const int64_t value, const int64_t null) {
+  return value == null ? null_code(header.bit_width)
+                       : static_cast<uint64_t>(value) - static_cast<uint64_t>(header.base);
+}
+
+inline std::vector<int8_t> encode(const int64_t* values,
+                                  const size_t num_values,
+                                  const int64_t null) {
+  int64_t min{std::numeric_limits<int64_t>::max()};
+  int64_t max{std::numeric_limits<int64_t>::min()};
+  for (size_t i = 0; i < num_values; ++i) {
+    if (values[i] != null) {
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+    }
+  }
+  const auto header = min <= max ? make_header(min, max) : make_header(0, 0);
+  std::vector<int8_t> buffer(buffer_size(num_values, header.bit_width), 0);
+  memcpy(buffer.data(), &header, kHeaderSize);
+  auto words = reinterpret_cast<uint64_t*>(buffer.data() + kHeaderSize);
+  for (size_t i = 0; i < num_values; ++i) {
+    pack(words, i * header.bit_width, header.bit_width, get_code(header, values[i], null));
+  }
+  return buffer;
+}
+
+inline void decode(const int8_t* buffer,
+                   const size_t num_values,
+                   const int64_t null,
+                   int64_t* values) {
+  if (num_values == 0) {
+    return;
+  }
+  const auto header = reinterpret_cast<const Header*>(buffer);
+  const auto words = reinterpret_cast<const uint64_t*>(buffer + kHeaderSize);
+  const auto null_code_val = null_code(header->bit_width);
+  for (size_t i = 0; i < num_values; ++i) {
+    const auto code = unpack(words, i, header->bit_width);
+    values[i] = code == null_code_val
+                    ? null
+                    : static_cast<int64_t>(static_cast<uint64_t>(header->base) + code);
+  }
+}
+
+}  // namespace frame_of_reference
+
+template <typename T>
+class FrameOfReferenceEncoder : public Encoder {
+ public:
+  FrameOfReferenceEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer)
+      , dataMin(std::numeric_limits<T>::max())
+      , dataMax(std::numeric_limits<T>::min())
+      , has_nulls(false) {}
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo& ti,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    std::vector<int64_t> values(num_elems_to_append);
+    int64_t min{std::numeric_limits<int64_t>::max()};
+    int64_t max{std::numeric_limits<int64_t>::min()};
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      const size_t ri = replicating ? 0 : i;
+      values[i] = unencoded_data[ri];
+      if (updateStatsForValue(unencoded_data[ri])) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+      }
+    }
+
+    if (offset == -1) {
+      if (!packInFrame(values, min, max)) {
+        reencode(num_elems_, values);
+      }
+      num_elems_ += num_elems_to_append;
+      if (!replicating) {
+        src_data += num_elems_to_append * sizeof(T);
+      }
+    } else {
+      // overwritten values may still be in the sketch, but the element count no longer
+      // says whether every value was added to it
+      dropValueSketch();
+      CHECK(!replicating);
+      CHECK_GE(offset, 0);
+      reencode(offset, values);
+      num_elems_ = offset + num_elems_to_append;
+    }
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      dropValueSketch();
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      dropValueSketch();
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsForValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto& that_typed = static_cast<const FrameOfReferenceEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceValueSketch(that);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder =
+        reinterpret_cast<const FrameOfReferenceEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+    copyValueSketch(*copyFromEncoder);
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  // Returns false for nulls.
+  bool updateStatsForValue(const T data) {
+    if (data == inline_int_null_value<T>()) {
+      has_nulls = true;
+      addNullToValueSketch();
+      return false;
+    }
+    decimal_overflow_validator_.validate(data);
+    dataMin = std::min(dataMin, data);
+    dataMax = std::max(dataMax, data);
+    addToValueSketch(static_cast<int64_t>(data));
+    return true;
+  }
+
+  // Packs the values after the codes of the chunk if they fit its frame of reference and
+  // bit width, only the last, partially filled word of the chunk gets rewritten.
+  bool packInFrame(const std::vector<int64_t>& values,
+                   const int64_t min,
+                   const int64_t max) {
+    if (num_elems_ == 0 || values.empty()) {
+      return num_elems_ > 0;
+    }
+    frame_of_reference::Header header;
+    buffer_->read(reinterpret_cast<int8_t*>(&header), frame_of_reference::kHeaderSize);
+    if (min <= max) {
+      const auto max_code = frame_of_reference::null_code(header.bit_width) - 1;
+      if (min < header.base ||
+          static_cast<uint64_t>(max) - static_cast<uint64_t>(header.base) > max_code) {
+        return false;
+      }
+    }
+    const size_t first_bit = num_elems_ * header.bit_width;
+    const size_t first_word = first_bit / 64;
+    const size_t word_count =
+        frame_of_reference::word_count(num_elems_ + values.size(), header.bit_width);
+    std::vector<uint64_t> words(word_count - first_word, 0);
+    if (first_bit % 64) {
+      buffer_->read(reinterpret_cast<int8_t*>(words.data()),
+                    sizeof(uint64_t),
+                    frame_of_reference::kHeaderSize + first_word * sizeof(uint64_t));
+    }
+    const auto null = static_cast<int64_t>(inline_int_null_value<T>());
+    for (size_t i = 0; i < values.size(); ++i) {
+      frame_of_reference::pack(words.data(),
+                               first_bit % 64 + i * header.bit_width,
+                               header.bit_width,
+                               frame_of_reference::get_code(header, values[i], null));
+    }
+    buffer_->write(reinterpret_cast<int8_t*>(words.data()),
+                   words.size() * sizeof(uint64_t),
+                   frame_of_reference::kHeaderSize + first_word * sizeof(uint64_t));
+    return true;
+  }
+
+  // Encodes the first num_elems values of the chunk followed by the given ones again,
+  // with a frame of reference and bit width covering all of them.
+  void reencode(const size_t num_elems, const std::vector<int64_t>& values) {
+    const auto null = static_cast<int64_t>(inline_int_null_value<T>());
+    std::vector<int64_t> chunk_values(num_elems_);
+    if (num_elems_ > 0) {
+      std::vector<int8_t> encoded(buffer_->size());
+      buffer_->read(encoded.data(), encoded.size());
+      frame_of_reference::decode(encoded.data(), num_elems_, null, chunk_values.data());
+    }
+    chunk_values.resize(num_elems);
+    chunk_values.insert(chunk_values.end(), values.begin(), values.end());
+    auto encoded =
+        frame_of_reference::encode(chunk_values.data(), chunk_values.size(), null);
+    buffer_->write(encoded.data(), encoded.size(), 0);
+    buffer_->setSize(encoded.size());
+  }
+};  // FrameOfReferenceEncoder
+
+#endif  // FRAME_OF_REFERENCE_ENCODER_H
@@ -19,6 +19,7 @@
 
 #include "AbstractBuffer.h"
 #include "Encoder.h"
+#include "EncoderKernels.h"
 
 #include <Shared/DatumFetchers.h>
 
@@ -51,12 +52,12 @@ class NoneEncoder : public Encoder {
     if (replicating) {
       encoded_data.resize(num_elems_to_append);
     }
-    for (size_t i = 0; i < num_elems_to_append; ++i) {
-      size_t ri = replicating ? 0 : i;
-      T data = validateDataAndUpdateStats(unencodedData[ri]);
-      if (replicating) {
-        encoded_data[i] = data;
+    if (replicating) {
+      for (size_t i = 0; i < num_elems_to_append; ++i) {
+        encoded_data[i] = validateDataAndUpdateStats(unencodedData[0]);
       }
+    } else {
+      validateDataAndUpdateStats(unencodedData, num_elems_to_append);
     }
     if (offset == -1) {
       num_elems_ += num_elems_to_append;
@@ -67,6 +68,9 @@ class NoneEncoder : public Encoder {
         src_data += num_elems_to_append * sizeof(T);
       }
     } else {
+      // overwritten values may still be in the sketch, but the element count no longer
+      // says whether every value was added to it
+      dropValueSketch();
       num_elems_ = offset + num_elems_to_append;
       CHECK(!replicating);
       CHECK_GE(offset, 0);
@@ -95,6 +99,7 @@ class NoneEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -106,6 +111,7 @@ class NoneEncoder : public Encoder {
     if (is_null) {
       has_nulls = true;
     } else {
+      dropValueSketch();
       const auto data = static_cast<T>(val);
       dataMin = std::min(dataMin, data);
       dataMax = std::max(dataMax, data);
@@ -113,10 +119,7 @@ class NoneEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
-    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
-    for (size_t i = 0; i < num_elements; ++i) {
-      validateDataAndUpdateStats(unencoded_data[i]);
-    }
+    validateDataAndUpdateStats(reinterpret_cast<const T*>(src_data), num_elements);
   }
 
   void updateStats(const std::vector<std::string>* const src_data,
@@ -133,12 +136,13 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const NoneEncoder&>(that);
+    const auto& that_typed = static_cast<const NoneEncoder&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceValueSketch(that);
   }
 
   void writeMetadata(FILE* f) override {
@@ -177,6 +181,7 @@ class NoneEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copyValueSketch(*copyFromEncoder);
   }
 
   T dataMin;
@@ -184,13 +189,37 @@ class NoneEncoder : public Encoder {
   bool has_nulls;
 
  private:
+  void validateDataAndUpdateStats(const T* unencoded_data, const size_t num_elems) {
+    const T null_val = none_encoded_null_value<T>();
+    T batch_min = std::numeric_limits<T>::max();
+    T batch_max = std::numeric_limits<T>::lowest();
+    bool batch_has_nulls{false};
+    encoder_kernels::update_stats(
+        unencoded_data, num_elems, null_val, batch_min, batch_max, batch_has_nulls);
+    if (batch_min <= batch_max) {
+      // the extremes are the only values which can overflow
+      decimal_overflow_validator_.validate(batch_min);
+      decimal_overflow_validator_.validate(batch_max);
+      dataMin = std::min(dataMin, batch_min);
+      dataMax = std::max(dataMax, batch_max);
+    }
+    has_nulls = has_nulls || batch_has_nulls;
+    if constexpr (std::is_integral<T>::value) {
+      addToValueSketch(unencoded_data, num_elems, null_val);
+    }
+  }
+
   T validateDataAndUpdateStats(const T& unencoded_data) {
     if (unencoded_data == none_encoded_null_value<T>()) {
       has_nulls = true;
+      addNullToValueSketch();
     } else {
       decimal_overflow_validator_.validate(unencoded_data);
       dataMin = std::min(dataMin, unencoded_data);
       dataMax = std::max(dataMax, unencoded_data);
+      if constexpr (std::is_integral<T>::value) {
+        addToValueSketch(static_cast<int64_t>(unencoded_data));
+      }
     }
     return unencoded_data;
   }
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file RunLengthEncoder.h
+ * @brief Encoder of ENCODING RL integer, date and time columns
+ *
+ * The chunk buffer holds the number of runs, followed by one {row_end, value} pair of
+ * int64_t per run, row_end being the exclusive end of the run in the chunk. Nulls are
+ * stored as the null value of the logical type. The generated code finds the run of a
+ * row with a binary search over the run ends, see run_length_decode in DecodersImpl.h.
+ */
+
+#ifndef RUN_LENGTH_ENCODER_H
+#define RUN_LENGTH_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+
+namespace run_length {
+
+struct Run {
+  int64_t row_end;
+  int64_t value;
+};
+
+constexpr size_t kHeaderSize{sizeof(int64_t)};
+
+inline size_t buffer_size(const size_t run_count) {
+  return kHeaderSize + run_count * sizeof(Run);
+}
+
+inline int64_t run_count(const int8_t* buffer) {
+  return *reinterpret_cast<const int64_t*>(buffer);
+}
+
+// Extends the runs with the values of the rows starting at first_row.
+inline void add_values(std::vector<Run>& runs,
+                       const int64_t* values,
+                       const size_t num_values,
+                       const int64_t first_row) {
+  for (size_t i = 0; i < num_values; ++i) {
+    if (runs.empty() || runs.back().value != values[i]) {
+      runs.push_back({first_row + static_cast<int64_t>(i), values[i]});
+    }
+    runs.back().row_end = first_row + static_cast<int64_t>(i) + 1;
+  }
+}
+
+inline std::vector<int8_t> encode(const int64_t* values, const size_t num_values) {
+  std::vector<Run> runs;
+  add_values(runs, values, num_values, 0);
+  std::vector<int8_t> buffer(buffer_size(runs.size()));
+  *reinterpret_cast<int64_t*>(buffer.data()) = runs.size();
+  if (!runs.empty()) {
+    memcpy(buffer.data() + kHeaderSize, runs.data(), runs.size() * sizeof(Run));
+  }
+  return buffer;
+}
+
+inline void decode(const int8_t* buffer, const size_t num_values, int64_t* values) {
+  if (num_values == 0) {
+    return;
+  }
+  const auto runs = reinterpret_cast<const Run*>(buffer + kHeaderSize);
+  int64_t row{0};
+  for (int64_t i = 0; i < run_count(buffer); ++i) {
+    const auto row_end = std::min(runs[i].row_end, static_cast<int64_t>(num_values));
+    std::fill(values + row, values + row_end, runs[i].value);
+    row = row_end;
+  }
+  CHECK_EQ(row, static_cast<int64_t>(num_values));
+}
+
+}  // namespace run_length
+
+template <typename T>
+class RunLengthEncoder : public Encoder {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer)
+      , dataMin(std::numeric_limits<T>::max())
+      , dataMax(std::numeric_limits<T>::min())
+      , has_nulls(false) {}
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo& ti,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    std::vector<int64_t> values(num_elems_to_append);
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      const size_t ri = replicating ? 0 : i;
+      values[i] = unencoded_data[ri];
+      updateStatsForValue(unencoded_data[ri]);
+    }
+
+    if (offset == -1) {
+      appendRuns(values);
+      num_elems_ += num_elems_to_append;
+      if (!replicating) {
+        src_data += num_elems_to_append * sizeof(T);
+      }
+    } else {
+      // overwritten values may still be in the sketch, but the element count no longer
+      // says whether every value was added to it
+      dropValueSketch();
+      CHECK(!replicating);
+      CHECK_GE(offset, 0);
+      // the run containing the offset may continue past it, re-encode the chunk
+      std::vector<int64_t> chunk_values(num_elems_);
+      if (num_elems_ > 0) {
+        std::vector<int8_t> encoded(buffer_->size());
+        buffer_->read(encoded.data(), encoded.size());
+        run_length::decode(encoded.data(), num_elems_, chunk_values.data());
+      }
+      chunk_values.resize(offset);
+      chunk_values.insert(chunk_values.end(), values.begin(), values.end());
+      auto encoded = run_length::encode(chunk_values.data(), chunk_values.size());
+      buffer_->write(encoded.data(), encoded.size(), 0);
+      buffer_->setSize(encoded.size());
+      num_elems_ = chunk_values.size();
+    }
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      dropValueSketch();
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      dropValueSketch();
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsForValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto& that_typed = static_cast<const RunLengthEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceValueSketch(that);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const RunLengthEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+    copyValueSketch(*copyFromEncoder);
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  void updateStatsForValue(const T data) {
+    if (data == inline_int_null_value<T>()) {
+      has_nulls = true;
+      addNullToValueSketch();
+    } else {
+      decimal_overflow_validator_.validate(data);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+      addToValueSketch(static_cast<int64_t>(data));
+    }
+  }
+
+  // Only the last run of the chunk can change on append, write it and the new runs
+  // after it, then the run count.
+  void appendRuns(const std::vector<int64_t>& values) {
+    if (values.empty()) {
+      return;
+    }
+    int64_t run_count{0};
+    std::vector<run_length::Run> runs;
+    if (buffer_->size() >= run_length::kHeaderSize) {
+      buffer_->read(reinterpret_cast<int8_t*>(&run_count), run_length::kHeaderSize);
+    }
+    if (run_count > 0) {
+      runs.resize(1);
+      buffer_->read(reinterpret_cast<int8_t*>(runs.data()),
+                    sizeof(run_length::Run),
+                    run_length::buffer_size(run_count - 1));
+      CHECK_EQ(runs.back().row_end, static_cast<int64_t>(num_elems_));
+    }
+    const size_t first_run = run_count > 0 ? run_count - 1 : 0;
+    run_length::add_values(runs, values.data(), values.size(), num_elems_);
+    run_count = first_run + runs.size();
+    buffer_->write(reinterpret_cast<int8_t*>(runs.data()),
+                   runs.size() * sizeof(run_length::Run),
+                   run_length::buffer_size(first_run));
+    buffer_->write(reinterpret_cast<int8_t*>(&run_count), run_length::kHeaderSize, 0);
+  }
+};  // RunLengthEncoder
+
+#endif  // RUN_LENGTH_ENCODER_H
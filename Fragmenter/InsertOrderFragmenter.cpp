@@ -41,6 +41,7 @@ using Data_Namespace::AbstractBuffer;
 using Data_Namespace::DataMgr;
 
 bool g_use_table_device_offset{true};
+bool g_enable_chunk_value_sketches{false};
 
 using namespace std;
 
@@ -719,6 +720,9 @@ FragmentInfo* InsertOrderFragmenter::createNewFragment(
         newFragmentInfo->deviceIds[static_cast<int>(memoryLevel)],
         pageSize_);
     colMapIt->second.initEncoder();
+    if (g_enable_chunk_value_sketches) {
+      colMapIt->second.getBuffer()->getEncoder()->enableValueSketch();
+    }
   }
 
   mapd_lock_guard<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
@@ -141,6 +141,42 @@ struct ScalarChunkConverter : public ChunkToInsertDataConverter {
   }
 };
 
+template <typename INSERT_DATA_TYPE>
+struct PackedChunkConverter : public ChunkToInsertDataConverter {
+  using ColumnDataPtr =
+      std::unique_ptr<INSERT_DATA_TYPE, CheckedMallocDeleter<INSERT_DATA_TYPE>>;
+
+  const Chunk_NS::Chunk* chunk_;
+  ColumnDataPtr column_data_;
+  const ColumnDescriptor* column_descriptor_;
+  std::vector<int64_t> chunk_values_;
+
+  PackedChunkConverter(const size_t num_rows, const Chunk_NS::Chunk* chunk)
+      : chunk_(chunk), column_descriptor_(chunk->getColumnDesc()) {
+    column_data_ = ColumnDataPtr(reinterpret_cast<INSERT_DATA_TYPE*>(
+        checked_malloc(num_rows * sizeof(INSERT_DATA_TYPE))));
+    // run-length and frame-of-reference encoded chunks have no per row offsets
+    const auto buffer = chunk->getBuffer();
+    chunk_values_ = Encoder::decodePackedChunk(buffer->getMemoryPtr(),
+                                               buffer->getEncoder()->getNumElems(),
+                                               column_descriptor_->columnType);
+  }
+
+  ~PackedChunkConverter() override {}
+
+  void convertToColumnarFormat(size_t row, size_t indexInFragment) override {
+    column_data_.get()[row] =
+        static_cast<INSERT_DATA_TYPE>(chunk_values_[indexInFragment]);
+  }
+
+  void addDataBlocksToInsertData(Fragmenter_Namespace::InsertData& insertData) override {
+    DataBlockPtr dataBlock;
+    dataBlock.numbersPtr = reinterpret_cast<int8_t*>(column_data_.get());
+    insertData.data.push_back(dataBlock);
+    insertData.columnIds.push_back(column_descriptor_->columnId);
+  }
+};
+
 struct FixedLenArrayChunkConverter : public ChunkToInsertDataConverter {
   const Chunk_NS::Chunk* chunk_;
   const ColumnDescriptor* column_descriptor_;
@@ -375,6 +411,29 @@ void InsertOrderFragmenter::updateColumns(
 
         chunkConverters.push_back(std::move(converter));
 
+      } else if (chunk_cd->columnType.has_packed_encoding()) {
+        std::unique_ptr<ChunkToInsertDataConverter> converter;
+        switch (chunk_cd->columnType.get_size()) {
+          case 1:
+            converter = std::make_unique<PackedChunkConverter<int8_t>>(num_rows,
+                                                                       chunk.get());
+            break;
+          case 2:
+            converter = std::make_unique<PackedChunkConverter<int16_t>>(num_rows,
+                                                                        chunk.get());
+            break;
+          case 4:
+            converter = std::make_unique<PackedChunkConverter<int32_t>>(num_rows,
+                                                                        chunk.get());
+            break;
+          case 8:
+            converter = std::make_unique<PackedChunkConverter<int64_t>>(num_rows,
+                                                                        chunk.get());
+            break;
+          default:
+            CHECK(false);
+        }
+        chunkConverters.push_back(std::move(converter));
       } else if (chunk_cd->columnType.is_date_in_days()) {
         /* Q: Why do we need this?
            A: In variable length updates path we move the chunk content of column
@@ -1249,8 +1308,48 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
       set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
     };
 
+    auto packed_vacuum = [=,
+                          &has_null_per_thread,
+                          &min_int64t_per_thread,
+                          &max_int64t_per_thread,
+                          &updel_roll,
+                          &frag_offsets,
+                          &fragment] {
+      // run-length and frame-of-reference encoded chunks have no per row offsets to move
+      // rows around, encode the rows to keep again
+      const auto values = Encoder::decodePackedChunk(
+          data_addr, data_buffer->getEncoder()->getNumElems(), col_type);
+      const auto null_val = inline_int_null_val(get_logical_type_info(col_type));
+      std::vector<int64_t> values_to_keep;
+      values_to_keep.reserve(nrows_to_keep);
+      size_t ioffset = 0;
+      for (size_t irow = 0; irow < values.size(); ++irow) {
+        if (ioffset < frag_offsets.size() && frag_offsets[ioffset] == irow) {
+          ++ioffset;
+          continue;
+        }
+        const auto v = values[irow];
+        values_to_keep.push_back(v);
+        if (v == null_val) {
+          has_null_per_thread[ci] = has_null_per_thread[ci] || !col_type.get_notnull();
+        } else {
+          set_minmax(min_int64t_per_thread[ci], max_int64t_per_thread[ci], v);
+        }
+      }
+      CHECK_EQ(values_to_keep.size(), nrows_to_keep);
+      auto encoded = Encoder::encodePackedChunk(values_to_keep, col_type);
+      data_buffer->write(encoded.data(), encoded.size(), 0);
+      data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+      data_buffer->setSize(encoded.size());
+      data_buffer->setUpdated();
+
+      set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+    };
+
     if (is_varlen) {
       threads.emplace_back(std::async(std::launch::async, varlen_vacuum));
+    } else if (col_type.has_packed_encoding()) {
+      threads.emplace_back(std::async(std::launch::async, packed_vacuum));
     } else {
       threads.emplace_back(std::async(std::launch::async, fixlen_vacuum));
     }
@@ -22,8 +22,15 @@
 
 #include "ImportExport/DelimitedParserUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <string_view>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "Logger/Logger.h"
 #include "StringDictionary/StringDictionary.h"
 
@@ -32,6 +39,67 @@ inline bool is_eol(const char& c, const import_export::CopyParams& copy_params)
   return c == copy_params.line_delim || c == '\n' || c == '\r';
 }
 
+// Finds the next character get_row has to look at. Everything in between is plain field
+// content, which makes up most of the input.
+class SpecialCharScanner {
+ public:
+  SpecialCharScanner(const import_export::CopyParams& copy_params, const bool has_arrays)
+      : is_special_{} {
+    addChar(copy_params.delimiter);
+    addChar(copy_params.line_delim);
+    addChar('\n');
+    addChar('\r');
+    addChar(copy_params.escape);
+    addChar(copy_params.quote);
+    if (has_arrays) {
+      addChar(copy_params.array_begin);
+    }
+#ifdef __SSE2__
+    for (size_t i = 0; i < char_count_; ++i) {
+      patterns_[i] = _mm_set1_epi8(chars_[i]);
+    }
+#endif
+  }
+
+  const char* find(const char* p, const char* end) const {
+#ifdef __SSE2__
+    for (; p + 16 <= end; p += 16) {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      auto matches = _mm_setzero_si128();
+      for (size_t i = 0; i < char_count_; ++i) {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, patterns_[i]));
+      }
+      const int mask = _mm_movemask_epi8(matches);
+      if (mask) {
+        return p + __builtin_ctz(mask);
+      }
+    }
+#endif
+    while (p < end && !is_special_[static_cast<unsigned char>(*p)]) {
+      ++p;
+    }
+    return p;
+  }
+
+ private:
+  static constexpr size_t kMaxSpecialChars{7};
+
+  void addChar(const char c) {
+    if (!is_special_[static_cast<unsigned char>(c)]) {
+      is_special_[static_cast<unsigned char>(c)] = true;
+      CHECK_LT(char_count_, kMaxSpecialChars);
+      chars_[char_count_++] = c;
+    }
+  }
+
+  std::array<bool, 256> is_special_;
+  std::array<char, kMaxSpecialChars> chars_;
+  size_t char_count_{0};
+#ifdef __SSE2__
+  std::array<__m128i, kMaxSpecialChars> patterns_;
+#endif
+};
+
 inline void trim_space(const char*& field_begin, const char*& field_end) {
   while (field_begin < field_end && (*field_begin == ' ' || *field_begin == '\r')) {
     ++field_begin;
@@ -58,6 +126,21 @@ inline void trim_quotes(const char*& field_begin,
 
 namespace import_export {
 namespace delimited_parser {
+
+char* FieldBufferArena::allocate(const size_t size) {
+  for (; block_idx_ < blocks_.size(); ++block_idx_, block_offset_ = 0) {
+    auto& [block, block_size] = blocks_[block_idx_];
+    if (block_offset_ + size <= block_size) {
+      auto field_buf = block.get() + block_offset_;
+      block_offset_ += size;
+      return field_buf;
+    }
+  }
+  const auto block_size = std::max(kBlockSize, size);
+  blocks_.emplace_back(std::make_unique<char[]>(block_size), block_size);
+  block_offset_ = size;
+  return blocks_.back().first.get();
+}
 size_t find_beginning(const char* buffer,
                       size_t begin,
                       size_t end,
@@ -203,8 +286,9 @@ const char* get_row(const char* buf,
                     const import_export::CopyParams& copy_params,
                     const bool* is_array,
                     std::vector<T>& row,
-                    std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                    FieldBufferArena& field_buffers,
                     bool& try_single_thread) {
+  const SpecialCharScanner scanner(copy_params, is_array != nullptr);
   const char* field = buf;
   const char* p;
   bool in_quote = false;
@@ -213,6 +297,10 @@ const char* get_row(const char* buf,
   bool strip_quotes = false;
   try_single_thread = false;
   for (p = buf; p < entire_buf_end; ++p) {
+    p = scanner.find(p, entire_buf_end);
+    if (p == entire_buf_end) {
+      break;
+    }
     if (*p == copy_params.escape && p < entire_buf_end - 1 &&
         *(p + 1) == copy_params.quote) {
       p++;
@@ -239,8 +327,7 @@ const char* get_row(const char* buf,
           trim_space(field, field_end);
           row.emplace_back(field, field_end - field);
         } else {
-          tmp_buffers.emplace_back(std::make_unique<char[]>(p - field + 1));
-          auto field_buf = tmp_buffers.back().get();
+          auto field_buf = field_buffers.allocate(p - field + 1);
           int j = 0, i = 0;
           for (; i < p - field; i++, j++) {
             if (has_escape && field[i] == copy_params.escape &&
@@ -291,7 +378,7 @@ template const char* get_row(const char* buf,
                              const import_export::CopyParams& copy_params,
                              const bool* is_array,
                              std::vector<std::string>& row,
-                             std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                             FieldBufferArena& field_buffers,
                              bool& try_single_thread);
 
 template const char* get_row(const char* buf,
@@ -300,7 +387,7 @@ template const char* get_row(const char* buf,
                              const import_export::CopyParams& copy_params,
                              const bool* is_array,
                              std::vector<std::string_view>& row,
-                             std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                             FieldBufferArena& field_buffers,
                              bool& try_single_thread);
 
 void parse_string_array(const std::string& s,
@@ -321,14 +408,14 @@ void parse_string_array(const std::string& s,
   bool try_single_thread = false;
   import_export::CopyParams array_params = copy_params;
   array_params.delimiter = copy_params.array_delim;
-  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  FieldBufferArena field_buffers;
   get_row(row.c_str(),
           row.c_str() + row.length(),
           row.c_str() + row.length(),
           array_params,
           nullptr,
           string_vec,
-          tmp_buffers,
+          field_buffers,
           try_single_thread);
 
   for (size_t i = 0; i < string_vec.size(); ++i) {
@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "DataMgr/ForeignStorage/CsvReader.h"
@@ -37,6 +39,29 @@ class InsufficientBufferSizeException : public std::runtime_error {
       : std::runtime_error(message) {}
 };
 
+/**
+ * @brief Scratch space for the fields of a row that have to be unescaped or unquoted.
+ * Memory is kept across rows, so that parsing does not allocate once the arena has
+ * grown to the size of the widest row.
+ */
+class FieldBufferArena {
+ public:
+  char* allocate(const size_t size);
+
+  // Invalidates the fields of the previous row.
+  void reset() {
+    block_idx_ = 0;
+    block_offset_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBlockSize{64 * 1024};
+
+  std::vector<std::pair<std::unique_ptr<char[]>, size_t>> blocks_;
+  size_t block_idx_{0};
+  size_t block_offset_{0};
+};
+
 /**
  * @brief Finds the closest possible row beginning in the given buffer.
  *
@@ -100,6 +125,8 @@ size_t find_row_end_pos(size_t& alloc_size,
  * @param copy_params          Copy params for the table.
  * @param is_array             Array of bools which tells if a column is an array type.
  * @param row                  Given vector to be populated with parsed fields.
+ * @param field_buffers        Holds fields with removed escape chars and quotes, must
+ * outlive the use of the fields.
  * @param try_single_thread    In case of parse errors, this will tell if parsing
  * should continue with single thread.
  *
@@ -112,7 +139,7 @@ const char* get_row(const char* buf,
                     const import_export::CopyParams& copy_params,
                     const bool* is_array,
                     std::vector<T>& row,
-                    std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                    FieldBufferArena& field_buffers,
                     bool& try_single_thread);
 
 /**
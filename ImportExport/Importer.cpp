@@ -67,6 +67,7 @@
 #include "Shared/scope.h"
 #include "Shared/shard_key.h"
 #include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
 #include "Utils/ChunkAccessorTable.h"
 
 #include "gen-cpp/OmniSci.h"
@@ -1833,11 +1834,11 @@ static ImportStatus import_thread_delimited(
       p->clear();
     }
     std::vector<std::string_view> row;
+    delimited_parser::FieldBufferArena field_buffers;
     size_t row_index_plus_one = 0;
     for (const char* p = thread_buf; p < thread_buf_end; p++) {
       row.clear();
-      std::vector<std::unique_ptr<char[]>>
-          tmp_buffers;  // holds string w/ removed escape chars, etc
+      field_buffers.reset();
       if (DEBUG_TIMING) {
         us = measure<std::chrono::microseconds>::execution([&]() {
           p = import_export::delimited_parser::get_row(p,
@@ -1846,7 +1847,7 @@ static ImportStatus import_thread_delimited(
                                                        copy_params,
                                                        importer->get_is_array(),
                                                        row,
-                                                       tmp_buffers,
+                                                       field_buffers,
                                                        try_single_thread);
         });
         total_get_row_time_us += us;
@@ -1857,7 +1858,7 @@ static ImportStatus import_thread_delimited(
                                                      copy_params,
                                                      importer->get_is_array(),
                                                      row,
-                                                     tmp_buffers,
+                                                     field_buffers,
                                                      try_single_thread);
       }
       row_index_plus_one++;
@@ -2727,7 +2728,7 @@ bool Loader::loadImpl(
 std::vector<DataBlockPtr> Loader::get_data_block_pointers(
     const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers) {
   std::vector<DataBlockPtr> result(import_buffers.size());
-  std::vector<std::pair<const size_t, std::future<int8_t*>>>
+  std::vector<std::pair<const size_t, threadpool::Future<int8_t*>>>
       encoded_data_block_ptrs_futures;
   // make all async calls to string dictionary here and then continue execution
   for (size_t buf_idx = 0; buf_idx < import_buffers.size(); buf_idx++) {
@@ -2738,7 +2739,7 @@ std::vector<DataBlockPtr> Loader::get_data_block_pointers(
 
       encoded_data_block_ptrs_futures.emplace_back(std::make_pair(
           buf_idx,
-          std::async(std::launch::async, [buf_idx, &import_buffers, string_payload_ptr] {
+          threadpool::async([buf_idx, &import_buffers, string_payload_ptr] {
             import_buffers[buf_idx]->addDictEncodedString(*string_payload_ptr);
             return import_buffers[buf_idx]->getStringDictBuffer();
           })));
@@ -2943,9 +2944,9 @@ void Detector::split_raw_data() {
   bool try_single_thread = false;
   for (const char* p = buf; p < buf_end; p++) {
     std::vector<std::string> row;
-    std::vector<std::unique_ptr<char[]>> tmp_buffers;
+    import_export::delimited_parser::FieldBufferArena field_buffers;
     p = import_export::delimited_parser::get_row(
-        p, buf_end, buf_end, copy_params, nullptr, row, tmp_buffers, try_single_thread);
+        p, buf_end, buf_end, copy_params, nullptr, row, field_buffers, try_single_thread);
     raw_rows.push_back(row);
     if (try_single_thread) {
       break;
@@ -2956,9 +2957,15 @@ void Detector::split_raw_data() {
     raw_rows.clear();
     for (const char* p = buf; p < buf_end; p++) {
       std::vector<std::string> row;
-      std::vector<std::unique_ptr<char[]>> tmp_buffers;
-      p = import_export::delimited_parser::get_row(
-          p, buf_end, buf_end, copy_params, nullptr, row, tmp_buffers, try_single_thread);
+      import_export::delimited_parser::FieldBufferArena field_buffers;
+      p = import_export::delimited_parser::get_row(p,
+                                                   buf_end,
+                                                   buf_end,
+                                                   copy_params,
+                                                   nullptr,
+                                                   row,
+                                                   field_buffers,
+                                                   try_single_thread);
       raw_rows.push_back(row);
     }
   }
@@ -4015,7 +4022,7 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
                        loader->getTableDesc()->tableId};
   auto table_epochs = loader->getTableEpochs();
   {
-    std::list<std::future<ImportStatus>> threads;
+    std::list<threadpool::Future<ImportStatus>> threads;
 
     // use a stack to track thread_ids which must not overlap among threads
     // because thread_id is used to index import_buffers_vec[]
@@ -4050,16 +4057,15 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
       stack_thread_ids.pop();
       // LOG(INFO) << " stack_thread_ids.pop " << thread_id << std::endl;
 
-      threads.push_back(std::async(std::launch::async,
-                                   import_thread_delimited,
-                                   thread_id,
-                                   this,
-                                   std::move(scratch_buffer),
-                                   begin_pos,
-                                   end_pos,
-                                   end_pos,
-                                   columnIdToRenderGroupAnalyzerMap,
-                                   first_row_index_this_buffer));
+      threads.push_back(threadpool::async(import_thread_delimited,
+                                          thread_id,
+                                          this,
+                                          std::move(scratch_buffer),
+                                          begin_pos,
+                                          end_pos,
+                                          end_pos,
+                                          columnIdToRenderGroupAnalyzerMap,
+                                          first_row_index_this_buffer));
 
       first_row_index_this_buffer += num_rows_this_buffer;
 
@@ -4074,7 +4080,7 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
 
       while (threads.size() > 0) {
         int nready = 0;
-        for (std::list<std::future<ImportStatus>>::iterator it = threads.begin();
+        for (std::list<threadpool::Future<ImportStatus>>::iterator it = threads.begin();
              it != threads.end();) {
           auto& p = *it;
           std::chrono::milliseconds span(
@@ -4810,7 +4816,7 @@ ImportStatus Importer::importGDAL(
 
 #if !DISABLE_MULTI_THREADED_SHAPEFILE_IMPORT
   // threads
-  std::list<std::future<ImportStatus>> threads;
+  std::list<threadpool::Future<ImportStatus>> threads;
 
   // use a stack to track thread_ids which must not overlap among threads
   // because thread_id is used to index import_buffers_vec[]
@@ -4869,22 +4875,21 @@ ImportStatus Importer::importGDAL(
     set_import_status(import_id, import_status);
 #else
     // fire up that thread to import this geometry
-    threads.push_back(std::async(std::launch::async,
-                                 import_thread_shapefile,
-                                 thread_id,
-                                 this,
-                                 poGeographicSR.get(),
-                                 std::move(features[thread_id]),
-                                 firstFeatureThisChunk,
-                                 numFeaturesThisChunk,
-                                 fieldNameToIndexMap,
-                                 columnNameToSourceNameMap,
-                                 columnIdToRenderGroupAnalyzerMap));
+    threads.push_back(threadpool::async(import_thread_shapefile,
+                                        thread_id,
+                                        this,
+                                        poGeographicSR.get(),
+                                        std::move(features[thread_id]),
+                                        firstFeatureThisChunk,
+                                        numFeaturesThisChunk,
+                                        fieldNameToIndexMap,
+                                        columnNameToSourceNameMap,
+                                        columnIdToRenderGroupAnalyzerMap));
 
     // let the threads run
     while (threads.size() > 0) {
       int nready = 0;
-      for (std::list<std::future<ImportStatus>>::iterator it = threads.begin();
+      for (std::list<threadpool::Future<ImportStatus>>::iterator it = threads.begin();
            it != threads.end();) {
         auto& p = *it;
         std::chrono::milliseconds span(
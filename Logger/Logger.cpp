@@ -524,7 +524,7 @@ using DurationTreeMap = std::unordered_map<ThreadId, std::unique_ptr<DurationTre
 std::mutex g_duration_tree_map_mutex;
 DurationTreeMap g_duration_tree_map;
 std::atomic<ThreadId> g_next_thread_id{0};
-ThreadId thread_local const g_thread_id = g_next_thread_id++;
+ThreadId thread_local g_thread_id = g_next_thread_id++;
 
 template <typename... Ts>
 Duration* newDuration(Severity severity, Ts&&... args) {
@@ -732,6 +732,20 @@ ThreadId thread_id() {
   return g_thread_id;
 }
 
+DebugTimerNewTask::DebugTimerNewTask(ThreadId parent_thread_id)
+    : thread_id_(g_thread_id), registered_(g_enable_debug_timer) {
+  if (registered_) {
+    g_thread_id = g_next_thread_id++;
+    debug_timer_new_thread(parent_thread_id);
+  }
+}
+
+DebugTimerNewTask::~DebugTimerNewTask() {
+  if (registered_) {
+    g_thread_id = thread_id_;
+  }
+}
+
 }  // namespace logger
 
 #endif  // #ifndef __CUDACC__
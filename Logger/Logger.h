@@ -321,6 +321,20 @@ ThreadId thread_id();
       logger::debug_timer_new_thread(parent_thread_id); \
   } while (false)
 
+// Registers a task run on a thread which may run others, such as a thread pool worker or
+// a thread waiting on the task's future, as a new thread of its parent. The task gets a
+// thread id of its own until the object goes out of scope, so any number of tasks can be
+// registered on the same thread. Typical usage:
+//   logger::DebugTimerNewTask debug_timer_task(parent_thread_id);
+class DebugTimerNewTask {
+  ThreadId const thread_id_;
+  bool const registered_;
+
+ public:
+  DebugTimerNewTask(ThreadId parent_thread_id);
+  ~DebugTimerNewTask();
+};
+
 }  // namespace logger
 
 #endif  // SHARED_LOGGER_H
@@ -19,6 +19,7 @@
 #include <sys/fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "Logger/Logger.h"
 
@@ -69,6 +70,14 @@ void close(const int fd) {
   ::close(fd);
 }
 
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset) {
+  return ::pread(fd, buf, count, static_cast<off_t>(offset));
+}
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset) {
+  return ::pwrite(fd, buf, count, static_cast<off_t>(offset));
+}
+
 ::FILE* fopen(const char* filename, const char* mode) {
   return ::fopen(filename, mode);
 }
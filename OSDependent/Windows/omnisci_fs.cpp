@@ -71,6 +71,40 @@ void close(const int fd) {
   _close(fd);
 }
 
+namespace {
+
+OVERLAPPED overlapped_for_offset(const size_t offset) {
+  OVERLAPPED overlapped{};
+  overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+  return overlapped;
+}
+
+}  // namespace
+
+// Unlike POSIX pread/pwrite, ReadFile/WriteFile with an OVERLAPPED offset on a
+// synchronous handle also moves the file pointer, so stream I/O on the same
+// descriptor must always seek first.
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset) {
+  auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  auto overlapped = overlapped_for_offset(offset);
+  DWORD bytes_read{0};
+  if (!ReadFile(handle, buf, static_cast<DWORD>(count), &bytes_read, &overlapped)) {
+    return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+  }
+  return bytes_read;
+}
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset) {
+  auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  auto overlapped = overlapped_for_offset(offset);
+  DWORD bytes_written{0};
+  if (!WriteFile(handle, buf, static_cast<DWORD>(count), &bytes_written, &overlapped)) {
+    return -1;
+  }
+  return bytes_written;
+}
+
 ::FILE* fopen(const char* filename, const char* mode) {
   FILE* f;
   const auto err = fopen_s(&f, filename, mode);
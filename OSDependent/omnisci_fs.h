@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 namespace omnisci {
@@ -35,6 +36,13 @@ int open(const char* path, int flags, int mode);
 
 void close(const int fd);
 
+// Positional I/O: does not use or move the file offset, so concurrent calls on the
+// same descriptor do not need to be serialized. Returns -1 on error, like the
+// POSIX calls they wrap.
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset);
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset);
+
 ::FILE* fopen(const char* filename, const char* mode);
 
 int get_page_size();
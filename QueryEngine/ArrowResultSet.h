@@ -198,6 +198,8 @@ class ArrowResultSetConverter {
     std::unique_ptr<arrow::ArrayBuilder> builder;
     SQLTypeInfo col_type;
     SQLTypes physical_type;
+    // Strings of a dictionary encoded column, with the string ids as indices.
+    std::shared_ptr<arrow::StringArray> dictionary;
   };
 
  private:
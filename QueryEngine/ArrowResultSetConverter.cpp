@@ -155,61 +155,21 @@ struct null_type<TYPE, std::enable_if_t<std::is_floating_point<TYPE>::value>> {
 template <typename TYPE>
 using null_type_t = typename null_type<TYPE>::type;
 
-template <typename C_TYPE, typename ARROW_TYPE = typename CTypeTraits<C_TYPE>::ArrowType>
-void convert_column(ResultSetPtr result,
-                    size_t col,
-                    std::unique_ptr<int8_t[]>& values,
-                    std::unique_ptr<uint8_t[]>& is_valid,
-                    size_t entry_count,
-                    std::shared_ptr<Array>& out) {
-  CHECK(sizeof(C_TYPE) == result->getColType(col).get_size());
-  CHECK(!values);
-  CHECK(!is_valid);
-
-  const int8_t* data_ptr;
-  if (result->isZeroCopyColumnarConversionPossible(col)) {
-    data_ptr = result->getColumnarBuffer(col);
-  } else {
-    values.reset(new int8_t[entry_count * sizeof(C_TYPE)]);
-    result->copyColumnIntoBuffer(col, values.get(), entry_count * sizeof(C_TYPE));
-    data_ptr = values.get();
-  }
-
+// Sets the bit of every value which is not the null sentinel, eight values at a time so
+// that the comparisons vectorize. Returns the null count.
+template <typename TYPE>
+int64_t create_validity_bitmap(const TYPE* vals,
+                               const TYPE null_val,
+                               const size_t entry_count,
+                               uint8_t* is_valid) {
   int64_t null_count = 0;
-  is_valid.reset(new uint8_t[(entry_count + 7) / 8]);
-
-  const null_type_t<C_TYPE>* vals =
-      reinterpret_cast<const null_type_t<C_TYPE>*>(data_ptr);
-  null_type_t<C_TYPE> null_val = null_type<C_TYPE>::value;
-
   size_t unroll_count = entry_count & 0xFFFFFFFFFFFFFFF8ULL;
   for (size_t i = 0; i < unroll_count; i += 8) {
     uint8_t valid_byte = 0;
-    uint8_t valid;
-    valid = vals[i + 0] != null_val;
-    valid_byte |= valid << 0;
-    null_count += !valid;
-    valid = vals[i + 1] != null_val;
-    valid_byte |= valid << 1;
-    null_count += !valid;
-    valid = vals[i + 2] != null_val;
-    valid_byte |= valid << 2;
-    null_count += !valid;
-    valid = vals[i + 3] != null_val;
-    valid_byte |= valid << 3;
-    null_count += !valid;
-    valid = vals[i + 4] != null_val;
-    valid_byte |= valid << 4;
-    null_count += !valid;
-    valid = vals[i + 5] != null_val;
-    valid_byte |= valid << 5;
-    null_count += !valid;
-    valid = vals[i + 6] != null_val;
-    valid_byte |= valid << 6;
-    null_count += !valid;
-    valid = vals[i + 7] != null_val;
-    valid_byte |= valid << 7;
-    null_count += !valid;
+    for (size_t j = 0; j < 8; ++j) {
+      valid_byte |= static_cast<uint8_t>(vals[i + j] != null_val) << j;
+    }
+    null_count += 8 - __builtin_popcount(valid_byte);
     is_valid[i >> 3] = valid_byte;
   }
   if (unroll_count != entry_count) {
@@ -221,22 +181,90 @@ void convert_column(ResultSetPtr result,
     }
     is_valid[unroll_count >> 3] = valid_byte;
   }
+  return null_count;
+}
+
+// Returns the column data, without a copy if the result set storage can be wrapped.
+template <typename C_TYPE>
+const int8_t* get_column_data(const ResultSetPtr& result,
+                              const size_t col,
+                              std::unique_ptr<int8_t[]>& values,
+                              const size_t entry_count) {
+  CHECK(sizeof(C_TYPE) == result->getColType(col).get_size());
+  CHECK(!values);
+  if (result->isZeroCopyColumnarConversionPossible(col)) {
+    return result->getColumnarBuffer(col);
+  }
+  values.reset(new int8_t[entry_count * sizeof(C_TYPE)]);
+  result->copyColumnIntoBuffer(col, values.get(), entry_count * sizeof(C_TYPE));
+  return values.get();
+}
+
+template <typename C_TYPE>
+void convert_column(ResultSetPtr result,
+                    size_t col,
+                    std::unique_ptr<int8_t[]>& values,
+                    std::unique_ptr<uint8_t[]>& is_valid,
+                    size_t entry_count,
+                    const std::shared_ptr<arrow::DataType>& type,
+                    std::shared_ptr<Array>& out) {
+  CHECK(!is_valid);
+  const int8_t* data_ptr = get_column_data<C_TYPE>(result, col, values, entry_count);
 
+  is_valid.reset(new uint8_t[(entry_count + 7) / 8]);
+  const int64_t null_count =
+      create_validity_bitmap(reinterpret_cast<const null_type_t<C_TYPE>*>(data_ptr),
+                             null_type<C_TYPE>::value,
+                             entry_count,
+                             is_valid.get());
   if (!null_count) {
     is_valid.reset();
   }
 
   // TODO: support date/time + scaling
-  // TODO: support booleans
   std::shared_ptr<Buffer> data(new Buffer(reinterpret_cast<const uint8_t*>(data_ptr),
                                           entry_count * sizeof(C_TYPE)));
+  std::shared_ptr<Buffer> null_bitmap;
+  if (null_count) {
+    null_bitmap.reset(new Buffer(is_valid.get(), (entry_count + 7) / 8));
+  }
+  out = MakeArray(ArrayData::Make(type, entry_count, {null_bitmap, data}, null_count));
+}
+
+// Booleans are stored one per byte in the result set, while Arrow packs them into a
+// bitmap, so the values are always copied.
+void convert_boolean_column(ResultSetPtr result,
+                            size_t col,
+                            std::unique_ptr<int8_t[]>& values,
+                            std::unique_ptr<uint8_t[]>& is_valid,
+                            size_t entry_count,
+                            std::shared_ptr<Array>& out) {
+  CHECK(!is_valid);
+  std::unique_ptr<int8_t[]> column_copy;
+  const auto vals = get_column_data<int8_t>(result, col, column_copy, entry_count);
+
+  const size_t bitmap_size = (entry_count + 7) / 8;
+  is_valid.reset(new uint8_t[bitmap_size]);
+  const int64_t null_count = create_validity_bitmap(
+      vals, inline_int_null_value<int8_t>(), entry_count, is_valid.get());
+  values.reset(new int8_t[bitmap_size]);
+  create_validity_bitmap(
+      vals, int8_t(0), entry_count, reinterpret_cast<uint8_t*>(values.get()));
+  std::shared_ptr<Buffer> null_bitmap;
   if (null_count) {
-    std::shared_ptr<Buffer> null_bitmap(
-        new Buffer(is_valid.get(), (entry_count + 7) / 8));
-    out.reset(new NumericArray<ARROW_TYPE>(entry_count, data, null_bitmap, null_count));
+    // The null sentinel is non-zero, clear the value bits of the nulls.
+    for (size_t i = 0; i < bitmap_size; ++i) {
+      values[i] &= is_valid[i];
+    }
+    null_bitmap.reset(new Buffer(is_valid.get(), bitmap_size));
   } else {
-    out.reset(new NumericArray<ARROW_TYPE>(entry_count, data));
+    is_valid.reset();
   }
+
+  std::shared_ptr<Buffer> data(
+      new Buffer(reinterpret_cast<const uint8_t*>(values.get()), bitmap_size));
+  out = MakeArray(
+      ArrayData::Make(boolean(), entry_count, {null_bitmap, data}, null_count));
 }
 
 #ifndef _MSC_VER
@@ -584,7 +612,6 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     initializeColumnBuilder(builders[i], results_->getColType(i), schema->field(i));
   }
 
-  // TODO(miyu): speed up for columnar buffers
   auto fetch = [&](std::vector<std::shared_ptr<ValueArray>>& value_seg,
                    std::vector<std::shared_ptr<std::vector<bool>>>& null_bitmap_seg,
                    const std::vector<bool>& non_lazy_cols,
@@ -695,30 +722,45 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       }
 
       const auto& column = builders[col];
+      const auto& type = column.field->type();
+      if (column.col_type.is_dict_encoded_string()) {
+        // The string ids index the dictionary payload directly.
+        CHECK_EQ(column.physical_type, kINT);
+        std::shared_ptr<arrow::Array> indices;
+        convert_column<int32_t>(
+            results_, col, values[col], is_valid[col], entry_count, int32(), indices);
+        result[col] = std::make_shared<DictionaryArray>(type, indices, column.dictionary);
+        continue;
+      }
       switch (column.physical_type) {
+        case kBOOLEAN:
+          convert_boolean_column(
+              results_, col, values[col], is_valid[col], entry_count, result[col]);
+          break;
         case kTINYINT:
           convert_column<int8_t>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         case kSMALLINT:
           convert_column<int16_t>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         case kINT:
           convert_column<int32_t>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         case kBIGINT:
+        case kTIMESTAMP:
           convert_column<int64_t>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         case kFLOAT:
           convert_column<float>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         case kDOUBLE:
           convert_column<double>(
-              results_, col, values[col], is_valid[col], entry_count, result[col]);
+              results_, col, values[col], is_valid[col], entry_count, type, result[col]);
           break;
         default:
           throw std::runtime_error(column.col_type.get_type_name() +
@@ -749,16 +791,20 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       // Currently column converter cannot handle some data types.
       // Treat them as lazy.
       switch (builders[i].physical_type) {
-        case kBOOLEAN:
         case kTIME:
         case kDATE:
-        case kTIMESTAMP:
           is_lazy = true;
           break;
         default:
           break;
       }
-      if (builders[i].field->type()->id() == Type::DICTIONARY) {
+      if (builders[i].field->type()->id() == Type::DICTIONARY &&
+          builders[i].physical_type != kINT) {
+        is_lazy = true;
+      }
+      // The column buffers are read with the logical type width.
+      if (results_->getQueryMemDesc().getPaddedSlotWidthBytes(i) !=
+          builders[i].col_type.get_size()) {
         is_lazy = true;
       }
       non_lazy_cols.emplace_back(!is_lazy);
@@ -807,6 +853,14 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
   if (!use_columnar_converter || !non_lazy_cols.empty()) {
     auto timer = DEBUG_TIMER("row converter");
     row_count = 0;
+    for (size_t i = 0; i < col_count; ++i) {
+      if ((non_lazy_cols.empty() || !non_lazy_cols[i]) && builders[i].dictionary) {
+        auto dict_builder =
+            dynamic_cast<arrow::StringDictionary32Builder*>(builders[i].builder.get());
+        CHECK(dict_builder);
+        ARROW_THROW_NOT_OK(dict_builder->InsertMemoValues(*builders[i].dictionary));
+      }
+    }
     if (multithreaded) {
       const size_t cpu_count = cpu_threads();
       std::vector<std::future<size_t>> child_threads;
@@ -1004,14 +1058,9 @@ void ArrowResultSetConverter::initializeColumnBuilder(
 
     arrow::StringBuilder str_array_builder;
     ARROW_THROW_NOT_OK(str_array_builder.AppendValues(*str_list));
-    std::shared_ptr<StringArray> string_array;
-    ARROW_THROW_NOT_OK(str_array_builder.Finish(&string_array));
-
-    auto dict_builder =
-        dynamic_cast<arrow::StringDictionary32Builder*>(column_builder.builder.get());
-    CHECK(dict_builder);
-
-    ARROW_THROW_NOT_OK(dict_builder->InsertMemoValues(*string_array));
+    ARROW_THROW_NOT_OK(str_array_builder.Finish(&column_builder.dictionary));
+    // The strings are added to the builder memo table only if the column goes through
+    // the row converter, the columnar converter uses the dictionary array as is.
   } else {
     ARROW_THROW_NOT_OK(
         arrow::MakeBuilder(default_memory_pool(), value_type, &column_builder.builder));
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file BatchFilterIR.cpp
+ * @brief Filters evaluated over blocks of rows ahead of the row function
+ *
+ * The quals of a single table scan which compare a fixed width column with a literal are
+ * evaluated by the batch_filter_<op>_<type> runtime functions for BATCH_FILTER_BLOCK_SIZE
+ * rows at a time, into a mask which is then turned into a selection vector. The scan
+ * loop only calls the row function for the selected rows, see
+ * Executor::insertBatchFilter, and the row function evaluates the remaining quals.
+ *
+ * With hoisted literals, the batch filter reads the literals from the literal buffer of
+ * the query like the row function does, so that queries which only differ by their
+ * constants share the same code.
+ */
+
+#include "CodeGenerator.h"
+#include "Execute.h"
+#include "RuntimeFunctions.h"
+
+#include <optional>
+
+namespace {
+
+struct BatchFilterQual {
+  const Analyzer::ColumnVar* col_var;
+  SQLOps optype;
+  const Analyzer::Constant* literal;
+};
+
+std::string batch_filter_op_name(const SQLOps optype) {
+  switch (optype) {
+    case kEQ:
+      return "eq";
+    case kNE:
+      return "ne";
+    case kLT:
+      return "lt";
+    case kLE:
+      return "le";
+    case kGT:
+      return "gt";
+    case kGE:
+      return "ge";
+    default:
+      UNREACHABLE();
+  }
+  return "";
+}
+
+int64_t get_int_literal(const Analyzer::Constant* literal) {
+  const auto& ti = literal->get_type_info();
+  const auto datum = literal->get_constval();
+  switch (ti.get_type()) {
+    case kTINYINT:
+      return datum.tinyintval;
+    case kSMALLINT:
+      return datum.smallintval;
+    case kINT:
+      return datum.intval;
+    case kBIGINT:
+    case kDECIMAL:
+    case kNUMERIC:
+      return datum.bigintval;
+    default:
+      UNREACHABLE();
+  }
+  return 0;
+}
+
+// Whether the literal can be compared with the values of the column as stored, the
+// null sentinel of the storage type being excluded.
+bool is_storable_literal(const Analyzer::Constant* literal, const SQLTypeInfo& col_ti) {
+  if (col_ti.is_fp()) {
+    const auto datum = literal->get_constval();
+    return col_ti.get_type() == kFLOAT
+               ? datum.floatval != inline_fp_null_value<float>()
+               : datum.doubleval != inline_fp_null_value<double>();
+  }
+  const auto val = get_int_literal(literal);
+  const auto null_val = inline_fixed_encoding_null_val(col_ti);
+  const auto max_val = static_cast<int64_t>(
+      (uint64_t(1) << (8 * col_ti.get_size() - 1)) - 1);
+  return val > null_val && val <= max_val;
+}
+
+std::optional<BatchFilterQual> to_batch_filter_qual(
+    const Analyzer::Expr* qual,
+    const Catalog_Namespace::Catalog& cat) {
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!bin_oper || bin_oper->get_qualifier() != kONE) {
+    return std::nullopt;
+  }
+  auto optype = bin_oper->get_optype();
+  if (optype != kEQ && optype != kNE && optype != kLT && optype != kLE &&
+      optype != kGT && optype != kGE) {
+    return std::nullopt;
+  }
+  auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_left_operand());
+  auto literal = dynamic_cast<const Analyzer::Constant*>(bin_oper->get_right_operand());
+  if (!col_var || !literal) {
+    col_var = dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_right_operand());
+    literal = dynamic_cast<const Analyzer::Constant*>(bin_oper->get_left_operand());
+    optype = COMMUTE_COMPARISON(optype);
+  }
+  if (!col_var || !literal || dynamic_cast<const Analyzer::Var*>(col_var) ||
+      col_var->get_rte_idx() > 0 || literal->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto cd = get_column_descriptor_maybe(
+      col_var->get_column_id(), col_var->get_table_id(), cat);
+  if (!cd || cd->isVirtualCol) {
+    return std::nullopt;
+  }
+  const auto& col_ti = col_var->get_type_info();
+  const auto& literal_ti = literal->get_type_info();
+  if (!col_ti.is_integer() && !col_ti.is_decimal() && !col_ti.is_fp()) {
+    return std::nullopt;
+  }
+  if (col_ti.get_compression() != kENCODING_NONE &&
+      col_ti.get_compression() != kENCODING_FIXED) {
+    return std::nullopt;
+  }
+  if (col_ti.get_type() != literal_ti.get_type() ||
+      col_ti.get_scale() != literal_ti.get_scale()) {
+    return std::nullopt;
+  }
+  // the row function compares floating point values with ordered predicates, which
+  // treat a NaN as different from nothing
+  if (col_ti.is_fp() && optype == kNE) {
+    return std::nullopt;
+  }
+  if (!is_storable_literal(literal, col_ti)) {
+    return std::nullopt;
+  }
+  return BatchFilterQual{col_var, optype, literal};
+}
+
+}  // namespace
+
+llvm::Function* Executor::codegenBatchFilter(RelAlgExecutionUnit& ra_exe_unit,
+                                             const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  if (ra_exe_unit.input_descs.size() != 1 ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE) {
+    return nullptr;
+  }
+  std::vector<BatchFilterQual> batch_quals;
+  auto take_batch_quals = [this, &batch_quals](
+                              std::list<std::shared_ptr<Analyzer::Expr>>& quals) {
+    for (auto qual_it = quals.begin(); qual_it != quals.end();) {
+      const auto batch_qual = to_batch_filter_qual(qual_it->get(), *getCatalog());
+      if (batch_qual) {
+        batch_quals.push_back(*batch_qual);
+        qual_it = quals.erase(qual_it);
+      } else {
+        ++qual_it;
+      }
+    }
+  };
+  take_batch_quals(ra_exe_unit.simple_quals);
+  take_batch_quals(ra_exe_unit.quals);
+  if (batch_quals.empty()) {
+    return nullptr;
+  }
+  VLOG(1) << "Evaluating " << batch_quals.size() << " quals in blocks of "
+          << BATCH_FILTER_BLOCK_SIZE << " rows";
+
+  // the signature is the one batch_filter_next_row calls through
+  auto next_row_func = cgen_state_->module_->getFunction("batch_filter_next_row");
+  CHECK(next_row_func);
+  const auto batch_filter_ptr_type =
+      llvm::cast<llvm::PointerType>(next_row_func->getFunctionType()->getParamType(5));
+  auto batch_filter_func = llvm::Function::Create(
+      llvm::cast<llvm::FunctionType>(batch_filter_ptr_type->getElementType()),
+      llvm::Function::ExternalLinkage,
+      "batch_filter",
+      cgen_state_->module_);
+  auto arg_it = batch_filter_func->arg_begin();
+  llvm::Value* sel = &*arg_it;
+  sel->setName("sel");
+  llvm::Value* col_buffers = &*(++arg_it);
+  col_buffers->setName("col_buffers");
+  llvm::Value* literals = &*(++arg_it);
+  literals->setName("literals");
+  llvm::Value* start = &*(++arg_it);
+  start->setName("start");
+  llvm::Value* num_rows = &*(++arg_it);
+  num_rows->setName("num_rows");
+
+  auto& ir_builder = cgen_state_->ir_builder_;
+  llvm::IRBuilderBase::InsertPointGuard insert_point_guard(ir_builder);
+  ir_builder.SetInsertPoint(
+      llvm::BasicBlock::Create(cgen_state_->context_, "entry", batch_filter_func));
+  auto mask = ir_builder.CreateAlloca(get_int_type(8, cgen_state_->context_),
+                                      cgen_state_->llInt(BATCH_FILTER_BLOCK_SIZE),
+                                      "mask");
+  cgen_state_->emitCall("batch_filter_init_mask", {mask, num_rows});
+  // Loads the literal from the literal buffer, stored with the width of its own type
+  // which can be wider than the fixed encoding of the column.
+  auto load_hoisted_literal = [this, &ir_builder, literals](
+                                  const Analyzer::Constant* literal,
+                                  llvm::Type* col_val_type) -> llvm::Value* {
+    const auto& literal_ti = literal->get_type_info();
+    const auto lit_off = cgen_state_->getOrAddLiteral(literal, kENCODING_NONE, 0, 0);
+    const auto literal_bit_width = 8 * literal_ti.get_size();
+    auto literal_type = literal_ti.is_fp()
+                            ? col_val_type
+                            : get_int_type(literal_bit_width, cgen_state_->context_);
+    auto literal_ptr = ir_builder.CreateBitCast(
+        ir_builder.CreateGEP(literals, cgen_state_->llInt(static_cast<int64_t>(lit_off))),
+        llvm::PointerType::get(literal_type, 0));
+    auto literal_lv = ir_builder.CreateLoad(literal_ptr);
+    if (literal_type == col_val_type) {
+      return literal_lv;
+    }
+    return ir_builder.CreateTrunc(literal_lv, col_val_type);
+  };
+  for (const auto& batch_qual : batch_quals) {
+    const auto& col_ti = batch_qual.col_var->get_type_info();
+    const int local_col_id = plan_state_->getLocalColumnId(batch_qual.col_var, true);
+    auto col = ir_builder.CreateLoad(
+        ir_builder.CreateGEP(col_buffers, cgen_state_->llInt(local_col_id)));
+    llvm::Value* literal_lv{nullptr};
+    llvm::Value* null_lv{nullptr};
+    std::string type_name;
+    if (col_ti.is_fp()) {
+      const auto datum = batch_qual.literal->get_constval();
+      if (col_ti.get_type() == kFLOAT) {
+        literal_lv = cgen_state_->llFp(datum.floatval);
+        null_lv = cgen_state_->llFp(inline_fp_null_value<float>());
+        type_name = "float";
+      } else {
+        literal_lv = cgen_state_->llFp(datum.doubleval);
+        null_lv = cgen_state_->llFp(inline_fp_null_value<double>());
+        type_name = "double";
+      }
+    } else {
+      const auto bit_width = 8 * col_ti.get_size();
+      auto int_type = get_int_type(bit_width, cgen_state_->context_);
+      literal_lv =
+          llvm::ConstantInt::get(int_type, get_int_literal(batch_qual.literal), true);
+      null_lv =
+          llvm::ConstantInt::get(int_type, inline_fixed_encoding_null_val(col_ti), true);
+      type_name = "int" + std::to_string(bit_width) + "_t";
+    }
+    if (co.hoist_literals) {
+      literal_lv = load_hoisted_literal(batch_qual.literal, literal_lv->getType());
+    }
+    cgen_state_->emitCall(
+        "batch_filter_" + batch_filter_op_name(batch_qual.optype) + "_" + type_name,
+        {mask,
+         col,
+         start,
+         num_rows,
+         literal_lv,
+         null_lv,
+         cgen_state_->llBool(!col_ti.get_notnull())});
+  }
+  ir_builder.CreateRet(
+      cgen_state_->emitCall("batch_filter_select", {sel, mask, num_rows}));
+  verify_function_ir(batch_filter_func);
+  return batch_filter_func;
+}
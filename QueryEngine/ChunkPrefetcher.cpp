@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ChunkPrefetcher.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+
+std::atomic<size_t> ChunkPrefetcher::prefetched_count_{0};
+std::atomic<size_t> ChunkPrefetcher::wasted_count_{0};
+std::atomic<size_t> ChunkPrefetcher::stalled_count_{0};
+
+ChunkPrefetcher::ChunkPrefetcher(Data_Namespace::DataMgr* data_mgr,
+                                 std::vector<Request>&& requests,
+                                 const size_t fragment_window,
+                                 const size_t thread_count)
+    : data_mgr_(data_mgr)
+    , requests_(std::move(requests))
+    , states_(requests_.size(), State::kQueued)
+    , fragment_window_(fragment_window) {
+  CHECK(data_mgr_);
+  CHECK_GT(fragment_window_, size_t(0));
+  for (size_t i = 0; i < requests_.size(); ++i) {
+    CHECK(i == 0 || requests_[i - 1].fragment_seq <= requests_[i].fragment_seq);
+    request_index_.emplace(requests_[i].key, i);
+  }
+  const auto worker_count = std::min(thread_count, requests_.size());
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  wasted_count_ += std::count(states_.begin(), states_.end(), State::kRead);
+}
+
+void ChunkPrefetcher::waitFor(const ChunkKey& key) {
+  const auto it = request_index_.find(key);
+  if (it == request_index_.end()) {
+    return;
+  }
+  const auto request_idx = it->second;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (requests_[request_idx].fragment_seq > started_fragment_seq_) {
+    started_fragment_seq_ = requests_[request_idx].fragment_seq;
+    cv_.notify_all();
+  }
+  auto& state = states_[request_idx];
+  if (state == State::kReading) {
+    ++stalled_count_;
+    cv_.wait(lock, [&state] { return state != State::kReading; });
+  }
+  state = State::kDone;
+}
+
+ChunkPrefetcher::Stats ChunkPrefetcher::getStats() {
+  Stats stats;
+  stats.prefetched_count = prefetched_count_;
+  stats.wasted_count = wasted_count_;
+  stats.stalled_count = stalled_count_;
+  return stats;
+}
+
+void ChunkPrefetcher::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] {
+      return shutdown_ ||
+             (next_request_ < requests_.size() &&
+              requests_[next_request_].fragment_seq <
+                  started_fragment_seq_ + fragment_window_);
+    });
+    if (shutdown_) {
+      return;
+    }
+    const auto request_idx = next_request_++;
+    if (states_[request_idx] != State::kQueued) {
+      // A kernel got to the chunk first.
+      continue;
+    }
+    states_[request_idx] = State::kReading;
+    lock.unlock();
+
+    const auto& request = requests_[request_idx];
+    bool read = false;
+    try {
+      Chunk_NS::Chunk chunk(request.cd);
+      if (!chunk.isChunkOnDevice(data_mgr_, request.key, Data_Namespace::CPU_LEVEL, 0)) {
+        // The chunk is unpinned right away and stays in the CPU buffer pool.
+        Chunk_NS::Chunk::getChunk(request.cd,
+                                  data_mgr_,
+                                  request.key,
+                                  Data_Namespace::CPU_LEVEL,
+                                  0,
+                                  request.num_bytes,
+                                  request.num_elements);
+        read = true;
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Prefetch of chunk " << show_chunk(request.key)
+                   << " failed: " << e.what();
+    }
+    if (read) {
+      ++prefetched_count_;
+    }
+
+    lock.lock();
+    states_[request_idx] = read ? State::kRead : State::kDone;
+    cv_.notify_all();
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkPrefetcher.h
+ * @brief   Background reads of the chunks of upcoming fragments of a query.
+ *
+ * The chunks are read into the CPU buffer pool in the order of the fragments the
+ * kernels scan, at most a fixed number of fragments ahead of the last fragment a kernel
+ * has started on, so that disk reads overlap with kernel execution instead of
+ * preceding it.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataMgr/Chunk/Chunk.h"
+
+class ChunkPrefetcher {
+ public:
+  struct Request {
+    ChunkKey key;
+    const ColumnDescriptor* cd;
+    size_t num_bytes;
+    size_t num_elements;
+    // Position of the fragment in the scan order of the query.
+    size_t fragment_seq;
+  };
+
+  struct Stats {
+    // Chunks read from disk by the prefetcher.
+    size_t prefetched_count{0};
+    // Prefetched chunks no kernel asked for before the query finished.
+    size_t wasted_count{0};
+    // Chunk fetches which had to wait for a prefetch in flight.
+    size_t stalled_count{0};
+  };
+
+  ChunkPrefetcher(Data_Namespace::DataMgr* data_mgr,
+                  std::vector<Request>&& requests,
+                  const size_t fragment_window,
+                  const size_t thread_count);
+
+  ~ChunkPrefetcher();
+
+  ChunkPrefetcher(const ChunkPrefetcher&) = delete;
+
+  ChunkPrefetcher& operator=(const ChunkPrefetcher&) = delete;
+
+  // Called before a kernel fetches a chunk. Waits for the prefetch of the chunk if it
+  // is in flight, keeps it from being read twice otherwise, and moves the prefetch
+  // window forward.
+  void waitFor(const ChunkKey& key);
+
+  // Process-wide counters.
+  static Stats getStats();
+
+ private:
+  enum class State { kQueued, kReading, kRead, kDone };
+
+  void workerLoop();
+
+  Data_Namespace::DataMgr* data_mgr_;
+  const std::vector<Request> requests_;
+  std::map<ChunkKey, size_t> request_index_;
+  std::vector<State> states_;
+  const size_t fragment_window_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t next_request_{0};
+  size_t started_fragment_seq_{0};
+  bool shutdown_{false};
+  std::vector<std::thread> workers_;
+
+  static std::atomic<size_t> prefetched_count_;
+  static std::atomic<size_t> wasted_count_;
+  static std::atomic<size_t> stalled_count_;
+};
@@ -19,6 +19,7 @@
 #include <llvm/IR/Value.h>
 
 #include "../Analyzer/Analyzer.h"
+#include "DiskCodeCache.h"
 #include "Execute.h"
 
 // Code generation utility to be used for queries and scalar expressions.
@@ -70,10 +71,22 @@ class CodeGenerator {
       const std::vector<llvm::Function*>& roots,
       const std::vector<llvm::Function*>& leaves);
 
+  // If a persistent cache entry is given, the object is loaded from it when present
+  // and written to it otherwise.
   static ExecutionEngineWrapper generateNativeCPUCode(
       llvm::Function* func,
       const std::unordered_set<llvm::Function*>& live_funcs,
-      const CompilationOptions& co);
+      const CompilationOptions& co,
+      DiskCodeCache::ModuleEntry* disk_cache_entry = nullptr);
+
+  // The optimizing tier of tiered compilation: compiles the bitcode of a query module
+  // with the -O3 pipeline, loop and SLP vectorizers included, for the host CPU and swaps
+  // the code into cpu_compilation_context. Throws on failure, the baseline code stays.
+  static void tierUpCPUCode(const std::string& bitcode,
+                            const std::string& entry_name,
+                            const std::vector<std::string>& live_func_names,
+                            const CompilationOptions& co,
+                            CpuCompilationContext& cpu_compilation_context);
 
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
@@ -100,3 +100,27 @@ llvm::Instruction* FixedWidthSmallDate::codegenDecode(llvm::Value* byte_stream,
       pos};
   return llvm::CallInst::Create(f, args);
 }
+
+llvm::Instruction* RunLengthInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* module) const {
+  auto f = module->getFunction("run_length_decode");
+  CHECK(f);
+  llvm::Value* args[] = {byte_stream, pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+FrameOfReferenceInt::FrameOfReferenceInt(const int64_t null_val) : null_val_{null_val} {}
+
+llvm::Instruction* FrameOfReferenceInt::codegenDecode(llvm::Value* byte_stream,
+                                                      llvm::Value* pos,
+                                                      llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("frame_of_reference_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
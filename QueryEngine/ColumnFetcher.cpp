@@ -18,6 +18,7 @@
 
 #include <memory>
 
+#include "DataMgr/Encoder.h"
 #include "QueryEngine/Execute.h"
 
 ColumnFetcher::ColumnFetcher(Executor* executor, const ColumnCacheMap& column_cache)
@@ -47,6 +48,17 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
       get_column_descriptor_maybe(hash_col.get_column_id(), table_id, catalog);
   CHECK(!cd || !(cd->isVirtualCol));
   const int8_t* col_buff = nullptr;
+  if (cd && cd->columnType.has_packed_encoding()) {
+    // The callers index the buffer by row, decode the chunk to the logical type.
+    return {getDecodedColumnFragment(executor,
+                                     *cd,
+                                     fragment,
+                                     effective_mem_lvl,
+                                     device_id,
+                                     device_allocator,
+                                     chunks_owner),
+            fragment.getNumTuples()};
+  }
   if (cd) {  // real table
     ChunkKey chunk_key{catalog.getCurrentDB().dbId,
                        fragment.physicalTableId,
@@ -96,6 +108,65 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
   return {col_buff, fragment.getNumTuples()};
 }
 
+const int8_t* ColumnFetcher::getDecodedColumnFragment(
+    Executor* executor,
+    const ColumnDescriptor& cd,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const Data_Namespace::MemoryLevel effective_mem_lvl,
+    const int device_id,
+    DeviceAllocator* device_allocator,
+    std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner) {
+  const auto& catalog = *executor->getCatalog();
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(cd.columnId);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+  ChunkKey chunk_key{catalog.getCurrentDB().dbId,
+                     fragment.physicalTableId,
+                     cd.columnId,
+                     fragment.fragmentId};
+  const auto chunk = Chunk_NS::Chunk::getChunk(&cd,
+                                               &catalog.getDataMgr(),
+                                               chunk_key,
+                                               Data_Namespace::CPU_LEVEL,
+                                               0,
+                                               chunk_meta_it->second->numBytes,
+                                               chunk_meta_it->second->numElements);
+  chunks_owner.push_back(chunk);
+  CHECK(chunk);
+  auto ab = chunk->getBuffer();
+  CHECK(ab->getMemoryPtr());
+  const auto num_tuples = fragment.getNumTuples();
+  const auto values =
+      Encoder::decodePackedChunk(ab->getMemoryPtr(), num_tuples, cd.columnType);
+  const auto byte_width = cd.columnType.get_size();
+  const auto num_bytes = num_tuples * byte_width;
+  auto col_buff = executor->row_set_mem_owner_->allocate(num_bytes);
+  for (size_t i = 0; i < num_tuples; ++i) {
+    switch (byte_width) {
+      case 1:
+        reinterpret_cast<int8_t*>(col_buff)[i] = values[i];
+        break;
+      case 2:
+        reinterpret_cast<int16_t*>(col_buff)[i] = values[i];
+        break;
+      case 4:
+        reinterpret_cast<int32_t*>(col_buff)[i] = values[i];
+        break;
+      case 8:
+        reinterpret_cast<int64_t*>(col_buff)[i] = values[i];
+        break;
+      default:
+        CHECK(false);
+    }
+  }
+  if (effective_mem_lvl == Data_Namespace::GPU_LEVEL && num_bytes > 0) {
+    CHECK(device_allocator);
+    auto gpu_col_buff = device_allocator->alloc(num_bytes);
+    device_allocator->copyToDevice(gpu_col_buff, col_buff, num_bytes);
+    return gpu_col_buff;
+  }
+  return col_buff;
+}
+
 //! makeJoinColumn() creates a JoinColumn struct containing a array of
 //! JoinChunk structs, col_chunks_buff, malloced in CPU memory. Although
 //! the col_chunks_buff array is in CPU memory here, each JoinChunk struct
@@ -191,6 +262,9 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     ChunkKey chunk_key{
         cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
     std::unique_ptr<std::lock_guard<std::mutex>> varlen_chunk_lock;
+    if (executor_->chunk_prefetcher_) {
+      executor_->chunk_prefetcher_->waitFor(chunk_key);
+    }
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_mutex));
     }
@@ -318,8 +392,7 @@ const int8_t* ColumnFetcher::transferColumnIfNeeded(
   const auto& col_buffers = columnar_results->getColumnBuffers();
   CHECK_LT(static_cast<size_t>(col_id), col_buffers.size());
   if (memory_level == Data_Namespace::GPU_LEVEL) {
-    const auto& col_ti = columnar_results->getColumnType(col_id);
-    const auto num_bytes = columnar_results->size() * col_ti.get_size();
+    const auto num_bytes = columnar_results->getColumnBufferSize(col_id);
     CHECK(device_allocator);
     auto gpu_col_buffer = device_allocator->alloc(num_bytes);
     device_allocator->copyToDevice(gpu_col_buffer, col_buffers[col_id], num_bytes);
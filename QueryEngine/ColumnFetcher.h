@@ -104,6 +104,17 @@ class ColumnFetcher {
       const int device_id,
       DeviceAllocator* device_allocator);
 
+  //! Decodes a run-length or frame-of-reference encoded chunk to one value of the
+  //! logical type per row.
+  static const int8_t* getDecodedColumnFragment(
+      Executor* executor,
+      const ColumnDescriptor& cd,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const Data_Namespace::MemoryLevel effective_mem_lvl,
+      const int device_id,
+      DeviceAllocator* device_allocator,
+      std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
+
   const int8_t* getResultSetColumn(const ResultSetPtr& buffer,
                                    const int table_id,
                                    const int col_id,
@@ -73,6 +73,11 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       return col_var->get_comp_param() == 16 ? std::make_shared<FixedWidthSmallDate>(2)
                                              : std::make_shared<FixedWidthSmallDate>(4);
     }
+    case kENCODING_RL:
+      return std::make_shared<RunLengthInt>();
+    case kENCODING_DIFF:
+      return std::make_shared<FrameOfReferenceInt>(
+          inline_int_null_val(get_logical_type_info(ti)));
     default:
       abort();
   }
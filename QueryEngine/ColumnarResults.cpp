@@ -15,6 +15,7 @@
  */
 
 #include "ColumnarResults.h"
+#include "DataMgr/Encoder.h"
 #include "Descriptors/RowSetMemoryOwner.h"
 #include "Shared/Intervals.h"
 #include "Shared/thread_count.h"
@@ -96,11 +97,23 @@ ColumnarResults::ColumnarResults(std::shared_ptr<RowSetMemoryOwner> row_set_mem_
   if (is_varlen) {
     throw ColumnarConversionNotSupported();
   }
-  const auto buf_size = num_rows * target_type.get_size();
+  const auto buf_size =
+      target_type.has_packed_encoding()
+          ? Encoder::getPackedChunkSize(one_col_buffer, num_rows, target_type)
+          : num_rows * target_type.get_size();
   column_buffers_[0] = reinterpret_cast<int8_t*>(row_set_mem_owner->allocate(buf_size));
   memcpy(((void*)column_buffers_[0]), one_col_buffer, buf_size);
 }
 
+size_t ColumnarResults::getColumnBufferSize(const size_t col_id) const {
+  CHECK_LT(col_id, column_buffers_.size());
+  const auto& col_ti = getColumnType(col_id);
+  if (col_ti.has_packed_encoding()) {
+    return Encoder::getPackedChunkSize(column_buffers_[col_id], num_rows_, col_ti);
+  }
+  return num_rows_ * col_ti.get_size();
+}
+
 std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const std::vector<std::unique_ptr<ColumnarResults>>& sub_results) {
@@ -125,7 +138,23 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
     return nullptr;
   }
   for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
-    const auto byte_width = (*nonempty_it)->getColumnType(col_idx).get_size();
+    const auto& col_ti = (*nonempty_it)->getColumnType(col_idx);
+    if (col_ti.has_packed_encoding()) {
+      // the encoded chunks can't be concatenated, encode the values of all of them
+      std::vector<int64_t> values;
+      values.reserve(total_row_count);
+      for (auto& rs : sub_results) {
+        const auto rs_values = Encoder::decodePackedChunk(
+            rs->column_buffers_[col_idx], rs->size(), rs->getColumnType(col_idx));
+        values.insert(values.end(), rs_values.begin(), rs_values.end());
+      }
+      const auto encoded = Encoder::encodePackedChunk(values, col_ti);
+      auto write_ptr = row_set_mem_owner->allocate(encoded.size());
+      memcpy(write_ptr, encoded.data(), encoded.size());
+      merged_results->column_buffers_.push_back(write_ptr);
+      continue;
+    }
+    const auto byte_width = col_ti.get_size();
     auto write_ptr = row_set_mem_owner->allocate(byte_width * total_row_count);
     merged_results->column_buffers_.push_back(write_ptr);
     for (auto& rs : sub_results) {
@@ -79,6 +79,10 @@ class ColumnarResults {
 
   const size_t size() const { return num_rows_; }
 
+  //! Bytes of the column buffer, which may hold a run-length or frame-of-reference
+  //! encoded chunk instead of one value per row.
+  size_t getColumnBufferSize(const size_t col_id) const;
+
   const SQLTypeInfo& getColumnType(const int col_id) const {
     CHECK_GE(col_id, 0);
     CHECK_LT(static_cast<size_t>(col_id), target_types_.size());
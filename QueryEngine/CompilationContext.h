@@ -18,10 +18,14 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
+#include <atomic>
 #include <memory>
 
+#include "Logger/Logger.h"
+
 class CompilationContext {
  public:
   virtual ~CompilationContext() {}
@@ -68,9 +72,39 @@ class CpuCompilationContext : public CompilationContext {
     CHECK(func_);
   }
 
-  void* func() const { return func_; }
+  void* func() const { return func_.load(std::memory_order_acquire); }
+
+  // Tiered compilation: counts the executions served from the code cache and returns
+  // true once the code is hot, until the optimizing tier has been requested.
+  bool recordCacheHit(const size_t hot_count) {
+    return ++cache_hit_count_ >= hot_count && !tier_up_requested_;
+  }
+
+  void setTierUpRequested() { tier_up_requested_ = true; }
+
+  // Swaps in the code of the optimizing tier. The baseline code is kept alive, since
+  // kernels which loaded func() before the swap may still run it.
+  void setOptimizedCode(std::unique_ptr<llvm::LLVMContext> context,
+                        ExecutionEngineWrapper&& execution_engine,
+                        void* func) {
+    CHECK(func);
+    CHECK(!isOptimized());
+    optimized_context_ = std::move(context);
+    optimized_execution_engine_ = std::move(execution_engine);
+    func_.store(func, std::memory_order_release);
+    optimized_ = true;
+  }
+
+  bool isOptimized() const { return optimized_; }
 
  private:
-  void* func_{nullptr};
+  std::atomic<void*> func_{nullptr};
   ExecutionEngineWrapper execution_engine_;
+  std::atomic<size_t> cache_hit_count_{0};
+  std::atomic<bool> tier_up_requested_{false};
+  std::atomic<bool> optimized_{false};
+  // the optimizing tier compiles in a context of its own, declared before the engine
+  // so that it outlives the module the engine owns
+  std::unique_ptr<llvm::LLVMContext> optimized_context_;
+  ExecutionEngineWrapper optimized_execution_engine_;
 };
@@ -37,6 +37,7 @@ struct CompilationOptions {
                                         // scans. Primarily disabled for delete queries.
   ExecutorExplainType explain_type{ExecutorExplainType::Default};
   bool register_intel_jit_listener{false};
+  bool batch_filters{false};  // evaluate the simple quals of a scan over blocks of rows
 
   static CompilationOptions makeCpuOnly(const CompilationOptions& in) {
     return CompilationOptions{ExecutorDeviceType::CPU,
@@ -46,7 +47,8 @@ struct CompilationOptions {
                               in.allow_lazy_fetch,
                               in.filter_on_deleted_column,
                               in.explain_type,
-                              in.register_intel_jit_listener};
+                              in.register_intel_jit_listener,
+                              in.batch_filters};
   }
 
   static CompilationOptions defaults(
@@ -58,6 +60,7 @@ struct CompilationOptions {
                               true,
                               true,
                               ExecutorExplainType::Default,
+                              false,
                               false};
   }
 };
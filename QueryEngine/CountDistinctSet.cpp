@@ -0,0 +1,128 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/CountDistinctSet.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+
+namespace {
+
+std::vector<int64_t> merge_runs(const std::vector<int64_t>& lhs,
+                                const std::vector<int64_t>& rhs) {
+  std::vector<int64_t> merged;
+  merged.reserve(lhs.size() + rhs.size());
+  std::set_union(
+      lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(merged));
+  return merged;
+}
+
+}  // namespace
+
+CountDistinctSet::CountDistinctSet(RowSetMemoryOwner* row_set_mem_owner)
+    : row_set_mem_owner_(row_set_mem_owner)
+    , table_(nullptr)
+    , table_capacity_(0)
+    , table_entry_count_(0)
+    , has_empty_key_(false) {
+  CHECK(row_set_mem_owner_);
+}
+
+size_t CountDistinctSet::size() {
+  return compact().size() + (has_empty_key_ ? 1 : 0);
+}
+
+void CountDistinctSet::merge(CountDistinctSet& other) {
+  if (&other == this) {
+    return;
+  }
+  has_empty_key_ = has_empty_key_ || other.has_empty_key_;
+  const auto& other_values = other.compact();
+  if (other_values.size() < kMaxTableCapacity / 2) {
+    for (const auto val : other_values) {
+      insert(val);
+    }
+  } else {
+    addRun(std::vector<int64_t>(other_values));
+  }
+}
+
+const std::vector<int64_t>& CountDistinctSet::compact() {
+  if (table_entry_count_) {
+    spillTable();
+  }
+  while (runs_.size() > 1) {
+    auto merged = merge_runs(runs_[runs_.size() - 2], runs_.back());
+    runs_.pop_back();
+    runs_.back() = std::move(merged);
+  }
+  if (runs_.empty()) {
+    runs_.emplace_back();
+  }
+  return runs_.front();
+}
+
+void CountDistinctSet::growOrSpill() {
+  if (table_capacity_ >= kMaxTableCapacity) {
+    spillTable();
+    return;
+  }
+  const auto old_table = table_;
+  const auto old_table_capacity = table_capacity_;
+  allocateTable(old_table_capacity ? old_table_capacity * 2 : kInitialTableCapacity);
+  // The old table stays in the arena until the query finishes, which at most doubles
+  // the memory used by the table.
+  for (size_t i = 0; i < old_table_capacity; ++i) {
+    if (old_table[i] != kEmptyKey) {
+      insertIntoTable(old_table[i]);
+    }
+  }
+}
+
+void CountDistinctSet::allocateTable(const size_t capacity) {
+  table_ = reinterpret_cast<int64_t*>(
+      row_set_mem_owner_->allocate(capacity * sizeof(*table_)));
+  std::fill(table_, table_ + capacity, kEmptyKey);
+  table_capacity_ = capacity;
+  table_entry_count_ = 0;
+}
+
+void CountDistinctSet::spillTable() {
+  std::vector<int64_t> run;
+  run.reserve(table_entry_count_);
+  for (size_t i = 0; i < table_capacity_; ++i) {
+    if (table_[i] != kEmptyKey) {
+      run.push_back(table_[i]);
+      table_[i] = kEmptyKey;
+    }
+  }
+  table_entry_count_ = 0;
+  std::sort(run.begin(), run.end());
+  addRun(std::move(run));
+}
+
+void CountDistinctSet::addRun(std::vector<int64_t>&& run) {
+  runs_.push_back(std::move(run));
+  // Merging runs of similar size keeps the number of runs logarithmic and the total
+  // merge work at O(n log n).
+  while (runs_.size() > 1 && runs_[runs_.size() - 2].size() <= 2 * runs_.back().size()) {
+    auto merged = merge_runs(runs_[runs_.size() - 2], runs_.back());
+    runs_.pop_back();
+    runs_.back() = std::move(merged);
+  }
+}
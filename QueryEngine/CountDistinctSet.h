@@ -0,0 +1,110 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CountDistinctSet.h
+ * @brief   Exact COUNT(DISTINCT) set for value ranges too wide for a bitmap.
+ *
+ * New values go to an open addressing hash table with linear probing, allocated from
+ * the arena of the RowSetMemoryOwner which owns the set. Once the table reaches its
+ * maximum capacity, its contents are sorted and spilled to a run. Runs of similar size
+ * are merged, so a large set ends up as a few sorted, duplicate free arrays, at 8 bytes
+ * per value. Values can occur both in the table and in the runs; compaction takes care
+ * of the duplicates.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class RowSetMemoryOwner;
+
+class CountDistinctSet {
+ public:
+  CountDistinctSet(RowSetMemoryOwner* row_set_mem_owner);
+
+  CountDistinctSet(const CountDistinctSet&) = delete;
+
+  CountDistinctSet& operator=(const CountDistinctSet&) = delete;
+
+  void insert(const int64_t val) {
+    if (val == kEmptyKey) {
+      has_empty_key_ = true;
+      return;
+    }
+    if (table_entry_count_ * 2 >= table_capacity_) {
+      growOrSpill();
+    }
+    insertIntoTable(val);
+  }
+
+  // Number of distinct values. Compacts the set, which must not be updated concurrently.
+  size_t size();
+
+  // Adds all values of the other set to this one.
+  void merge(CountDistinctSet& other);
+
+  // Sorted distinct values, without the empty key. Valid until the next update.
+  const std::vector<int64_t>& compact();
+
+  static constexpr size_t kMaxTableCapacity{1 << 16};
+
+ private:
+  static constexpr int64_t kEmptyKey{std::numeric_limits<int64_t>::min()};
+  static constexpr size_t kInitialTableCapacity{16};
+
+  static size_t hash(const int64_t val) {
+    auto h = static_cast<uint64_t>(val);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  void insertIntoTable(const int64_t val) {
+    const size_t mask = table_capacity_ - 1;
+    for (size_t slot = hash(val) & mask;; slot = (slot + 1) & mask) {
+      if (table_[slot] == val) {
+        return;
+      }
+      if (table_[slot] == kEmptyKey) {
+        table_[slot] = val;
+        ++table_entry_count_;
+        return;
+      }
+    }
+  }
+
+  void growOrSpill();
+
+  void allocateTable(const size_t capacity);
+
+  // Moves the hash table contents to a new sorted run.
+  void spillTable();
+
+  void addRun(std::vector<int64_t>&& run);
+
+  RowSetMemoryOwner* row_set_mem_owner_;
+  int64_t* table_;
+  size_t table_capacity_;
+  size_t table_entry_count_;
+  // Sorted, duplicate free runs, in decreasing order of size.
+  std::vector<std::vector<int64_t>> runs_;
+  bool has_empty_key_;
+};
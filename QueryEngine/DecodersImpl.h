@@ -147,6 +147,68 @@ SUFFIX(fixed_width_small_date_decode_noinline)(const int8_t* byte_stream,
       byte_stream, byte_width, null_val, ret_null_val, pos);
 }
 
+// Run-length encoded chunks, see DataMgr/RunLengthEncoder.h for the layout: the number
+// of runs followed by {row_end, value} pairs. Binary search for the first run ending
+// after the position.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_decode)(const int8_t* byte_stream, const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto run_count = *reinterpret_cast<const int64_t*>(byte_stream);
+  const auto runs = reinterpret_cast<const int64_t*>(byte_stream + sizeof(int64_t));
+  int64_t l = 0;
+  int64_t h = run_count - 1;
+  while (l < h) {
+    const int64_t mid = l + (h - l) / 2;
+    if (runs[2 * mid] <= pos) {
+      l = mid + 1;
+    } else {
+      h = mid;
+    }
+  }
+  return runs[2 * l + 1];
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(run_length_decode_noinline)(const int8_t* byte_stream, const int64_t pos) {
+  return SUFFIX(run_length_decode)(byte_stream, pos);
+}
+
+// Frame-of-reference encoded chunks, see DataMgr/FrameOfReferenceEncoder.h for the
+// layout: the frame of reference and the bit width of the codes, followed by the codes
+// packed into 64-bit words. The code with all bits set is null.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(frame_of_reference_decode)(const int8_t* byte_stream,
+                                  const int64_t null_val,
+                                  const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto base = *reinterpret_cast<const int64_t*>(byte_stream);
+  const auto bit_width =
+      *reinterpret_cast<const int32_t*>(byte_stream + sizeof(int64_t));
+  const auto words = reinterpret_cast<const uint64_t*>(byte_stream + 2 * sizeof(int64_t));
+  const uint64_t mask = bit_width == 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+  const uint64_t bit_pos = static_cast<uint64_t>(pos) * bit_width;
+  const uint64_t word = bit_pos >> 6;
+  const uint64_t shift = bit_pos & 63;
+  uint64_t code = words[word] >> shift;
+  if (shift + bit_width > 64) {
+    code |= words[word + 1] << (64 - shift);
+  }
+  code &= mask;
+  return code == mask ? null_val
+                      : static_cast<int64_t>(static_cast<uint64_t>(base) + code);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(frame_of_reference_decode_noinline)(const int8_t* byte_stream,
+                                           const int64_t null_val,
+                                           const int64_t pos) {
+  return SUFFIX(frame_of_reference_decode)(byte_stream, null_val, pos);
+}
+
 #undef SUFFIX
 
 #endif  // QUERYENGINE_DECODERSIMPL_H
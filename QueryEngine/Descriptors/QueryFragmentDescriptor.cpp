@@ -101,6 +101,7 @@ void QueryFragmentDescriptor::buildFragmentKernelMap(
                               device_count,
                               num_bytes_for_row,
                               device_type,
+                              enable_inner_join_fragment_skipping,
                               executor);
   }
 }
@@ -116,6 +117,7 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     const ChunkMetadataVector& deleted_chunk_metadata_vec,
     const std::optional<size_t> table_desc_offset,
     const ExecutorDeviceType& device_type,
+    const bool enable_inner_join_fragment_skipping,
     Executor* executor) {
   auto get_fragment_tuple_count = [&deleted_chunk_metadata_vec, &is_temporary_table](
                                       const auto& fragment) -> std::optional<size_t> {
@@ -150,8 +152,13 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     }
 
     const auto& fragment = (*fragments)[i];
-    const auto skip_frag = executor->skipFragment(
+    auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
+    if (enable_inner_join_fragment_skipping &&
+        (skip_frag == std::pair<bool, int64_t>(false, -1))) {
+      skip_frag = executor->skipFragmentInnerJoins(
+          table_desc, ra_exe_unit, fragment, frag_offsets, i);
+    }
     if (skip_frag.first) {
       continue;
     }
@@ -261,6 +268,7 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMapForUnion(
                                    {},
                                    j,
                                    device_type,
+                                   /*enable_inner_join_fragment_skipping=*/false,
                                    executor);
 
     std::vector<int> table_ids =
@@ -284,6 +292,7 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
     const int device_count,
     const size_t num_bytes_for_row,
     const ExecutorDeviceType& device_type,
+    const bool enable_inner_join_fragment_skipping,
     Executor* executor) {
   const auto& outer_table_desc = ra_exe_unit.input_descs.front();
   const int outer_table_id = outer_table_desc.getTableId();
@@ -329,6 +338,7 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
                                  deleted_chunk_metadata_vec,
                                  std::nullopt,
                                  device_type,
+                                 enable_inner_join_fragment_skipping,
                                  executor);
 }
 
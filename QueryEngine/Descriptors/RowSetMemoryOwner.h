@@ -28,6 +28,7 @@
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
+#include "QueryEngine/CountDistinctSet.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
 class ResultSet;
@@ -65,9 +66,11 @@ class RowSetMemoryOwner : boost::noncopyable {
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(std::set<int64_t>* count_distinct_set) {
+  CountDistinctSet* makeCountDistinctSet() {
+    auto count_distinct_set = new CountDistinctSet(this);
     std::lock_guard<std::mutex> lock(state_mutex_);
     count_distinct_sets_.push_back(count_distinct_set);
+    return count_distinct_set;
   }
 
   void addGroupByBuffer(int64_t* group_by_buffer) {
@@ -177,7 +180,7 @@ class RowSetMemoryOwner : boost::noncopyable {
   };
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<std::set<int64_t>*> count_distinct_sets_;
+  std::vector<CountDistinctSet*> count_distinct_sets_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/DiskCodeCache.h"
+
+#include <boost/filesystem.hpp>
+#if BOOST_VERSION >= 106600
+#include <boost/uuid/detail/sha1.hpp>
+#else
+#include <boost/uuid/sha1.hpp>
+#endif
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "OSDependent/omnisci_path.h"
+
+bool g_enable_persistent_code_cache{false};
+extern float g_fraction_code_cache_to_evict;
+
+std::unique_ptr<DiskCodeCache> DiskCodeCache::instance_;
+
+namespace {
+
+// Bounds the disk footprint, a cached query object is typically tens of kilobytes.
+constexpr size_t kMaxEntryCount{10000};
+
+const std::string kModuleIdPrefix{"omnisci_query_"};
+
+std::string sha1_hex(const std::string& data) {
+  boost::uuids::detail::sha1 sha1;
+  unsigned int digest[5];
+  sha1.process_bytes(data.c_str(), data.length());
+  sha1.get_digest(digest);
+  std::ostringstream oss;
+  for (size_t i = 0; i < 5; ++i) {
+    oss << std::hex << std::setw(8) << std::setfill('0') << digest[i];
+  }
+  return oss.str();
+}
+
+// Length-prefix every component so that different splits of the same bytes don't
+// serialize identically.
+std::string serialize_key(const CodeCacheKey& key) {
+  std::string serialized_key;
+  for (const auto& component : key) {
+    serialized_key += std::to_string(component.size());
+    serialized_key += ':';
+    serialized_key += component;
+  }
+  return serialized_key;
+}
+
+bool read_file(const std::string& path, std::string& contents) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << in.rdbuf();
+  contents = oss.str();
+  return !in.bad();
+}
+
+// Written to a temporary file and renamed into place, so that a crash or a concurrent
+// reader never observes a partial file.
+bool write_file_atomically(const std::string& path, const char* data, size_t size) {
+  const auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    out.write(data, size);
+    if (!out) {
+      return false;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+// Anything that changes the generated code for a given key must be part of the
+// version: the runtime functions linked into every query, the code generator and the
+// target the code was generated for.
+std::string get_cache_version() {
+  std::string runtime_bitcode;
+  const auto runtime_path =
+      omnisci::get_root_abs_path() + "/QueryEngine/RuntimeFunctions.bc";
+  if (!read_file(runtime_path, runtime_bitcode)) {
+    throw std::runtime_error("Could not read " + runtime_path);
+  }
+  return sha1_hex(runtime_bitcode + "|" + LLVM_VERSION_STRING + "|" +
+                  llvm::sys::getHostCPUName().str());
+}
+
+}  // namespace
+
+void DiskCodeCache::init(const std::string& cache_root) {
+  instance_.reset();
+  if (!g_enable_persistent_code_cache) {
+    return;
+  }
+  try {
+    const auto version = get_cache_version();
+    boost::filesystem::path root_path(cache_root);
+    boost::filesystem::create_directories(root_path);
+    for (const auto& entry : boost::filesystem::directory_iterator(root_path)) {
+      if (entry.path().filename() != version) {
+        LOG(INFO) << "Removing code cached by another version at " << entry.path();
+        boost::filesystem::remove_all(entry.path());
+      }
+    }
+    const auto cache_dir = root_path / version;
+    boost::filesystem::create_directories(cache_dir);
+    instance_.reset(new DiskCodeCache(cache_dir.string()));
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Persistent code cache disabled, failed to initialize " << cache_root
+               << ": " << e.what();
+  }
+}
+
+DiskCodeCache* DiskCodeCache::get() {
+  return instance_.get();
+}
+
+DiskCodeCache::DiskCodeCache(const std::string& cache_dir) : cache_dir_(cache_dir) {
+  for (const auto& entry : boost::filesystem::directory_iterator(cache_dir_)) {
+    const auto& path = entry.path();
+    if (path.extension() == ".tmp") {
+      boost::filesystem::remove(path);
+    } else if (path.extension() == ".o" &&
+               boost::filesystem::exists(keyPath(path.stem().string()))) {
+      ids_.insert(path.stem().string());
+    }
+  }
+  if (ids_.size() > kMaxEntryCount) {
+    evictOldest(kMaxEntryCount);
+  }
+  LOG(INFO) << "Persistent code cache at " << cache_dir_ << " holds " << ids_.size()
+            << " entries";
+}
+
+std::unique_ptr<DiskCodeCache::ModuleEntry> DiskCodeCache::prepareModule(
+    llvm::Module* module,
+    const CodeCacheKey& key) {
+  CHECK(module);
+  auto serialized_key = serialize_key(key);
+  const auto id = sha1_hex(serialized_key);
+  // MCJIT looks up and stores objects by module identifier.
+  module->setModuleIdentifier(kModuleIdPrefix + id);
+  auto entry = std::make_unique<ModuleEntry>(*this, id, std::move(serialized_key));
+  bool known_id{false};
+  {
+    std::lock_guard<std::mutex> lock(ids_mutex_);
+    known_id = ids_.count(id);
+  }
+  if (known_id && keyMatches(id, entry->serialized_key_)) {
+    // Read the object now rather than in getObject: the module skips the optimization
+    // passes, it must not be compiled if the object turns out to be missing.
+    auto buffer_or_error = llvm::MemoryBuffer::getFile(objectPath(id));
+    if (buffer_or_error) {
+      entry->object_ = std::move(buffer_or_error.get());
+    } else {
+      LOG(WARNING) << "Could not load cached object " << objectPath(id) << ": "
+                   << buffer_or_error.getError().message();
+    }
+  }
+  entry->has_object_ = entry->object_ != nullptr;
+  if (entry->has_object_) {
+    ++hit_count_;
+    // Eviction goes by the key file's modification time, touch it to keep hot entries.
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time(keyPath(id), std::time(nullptr), ec);
+  } else {
+    ++miss_count_;
+  }
+  VLOG(1) << "Persistent code cache " << (entry->has_object_ ? "hit" : "miss")
+          << " for " << id << ", " << hit_count_ << " hits, " << miss_count_
+          << " misses";
+  return entry;
+}
+
+void DiskCodeCache::ModuleEntry::notifyObjectCompiled(const llvm::Module* module,
+                                                      llvm::MemoryBufferRef obj) {
+  // A module matching a cached object was not optimized, its code is never persisted.
+  if (has_object_ || module->getModuleIdentifier() != kModuleIdPrefix + id_) {
+    return;
+  }
+  cache_.storeObject(id_, serialized_key_, obj);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> DiskCodeCache::ModuleEntry::getObject(
+    const llvm::Module* module) {
+  if (module->getModuleIdentifier() != kModuleIdPrefix + id_) {
+    return nullptr;
+  }
+  CHECK(!has_object_ || object_);
+  return std::move(object_);
+}
+
+std::string DiskCodeCache::objectPath(const std::string& id) const {
+  return cache_dir_ + "/" + id + ".o";
+}
+
+std::string DiskCodeCache::keyPath(const std::string& id) const {
+  return cache_dir_ + "/" + id + ".key";
+}
+
+bool DiskCodeCache::keyMatches(const std::string& id,
+                               const std::string& serialized_key) const {
+  std::string stored_key;
+  return read_file(keyPath(id), stored_key) && stored_key == serialized_key;
+}
+
+void DiskCodeCache::storeObject(const std::string& id,
+                                const std::string& serialized_key,
+                                llvm::MemoryBufferRef obj) {
+  // The key goes last: an entry is only visible once both files are complete.
+  if (!write_file_atomically(
+          objectPath(id), obj.getBufferStart(), obj.getBufferSize()) ||
+      !write_file_atomically(keyPath(id), serialized_key.data(), serialized_key.size())) {
+    ++write_error_count_;
+    LOG(WARNING) << "Could not write cached object " << objectPath(id);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(ids_mutex_);
+  ids_.insert(id);
+  if (ids_.size() > kMaxEntryCount) {
+    evictOldest(kMaxEntryCount * (1 - g_fraction_code_cache_to_evict));
+  }
+}
+
+// Called with ids_mutex_ held, or from the constructor.
+void DiskCodeCache::evictOldest(const size_t target_count) {
+  std::vector<std::pair<std::time_t, std::string>> ids_by_age;
+  for (const auto& id : ids_) {
+    boost::system::error_code ec;
+    const auto last_write_time = boost::filesystem::last_write_time(keyPath(id), ec);
+    ids_by_age.emplace_back(ec ? 0 : last_write_time, id);
+  }
+  std::sort(ids_by_age.begin(), ids_by_age.end());
+  for (size_t i = 0; i < ids_by_age.size() && ids_.size() > target_count; ++i) {
+    const auto& id = ids_by_age[i].second;
+    boost::system::error_code ec;
+    boost::filesystem::remove(keyPath(id), ec);
+    boost::filesystem::remove(objectPath(id), ec);
+    ids_.erase(id);
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DiskCodeCache.h
+ * @brief   On-disk cache of native CPU query code, shared across server restarts.
+ *
+ * Objects are stored under a directory named after a hash of the runtime bitcode, the
+ * LLVM version and the host CPU, so an upgrade or a different machine never picks up
+ * incompatible code. Each entry is the relocatable object emitted by MCJIT plus the
+ * full code cache key it was compiled from, which is compared on lookup to rule out
+ * hash collisions.
+ */
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "QueryEngine/CodeCache.h"
+
+class DiskCodeCache {
+ public:
+  // MCJIT object cache for the compilation of a single query module.
+  class ModuleEntry : public llvm::ObjectCache {
+   public:
+    ModuleEntry(DiskCodeCache& cache, std::string id, std::string serialized_key)
+        : cache_(cache), id_(std::move(id)), serialized_key_(std::move(serialized_key)) {}
+
+    void notifyObjectCompiled(const llvm::Module* module,
+                              llvm::MemoryBufferRef obj) override;
+
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+    // True if a matching object was loaded from disk, in which case the module doesn't
+    // need to be optimized since its code won't be generated.
+    bool hasObject() const { return has_object_; }
+
+   private:
+    DiskCodeCache& cache_;
+    const std::string id_;
+    const std::string serialized_key_;
+    bool has_object_{false};
+    // Handed over to MCJIT by getObject.
+    std::unique_ptr<llvm::MemoryBuffer> object_;
+
+    friend class DiskCodeCache;
+  };
+
+  // Sets up the cache under the given directory and drops entries left behind by
+  // other versions of the runtime. Disables the cache unless
+  // g_enable_persistent_code_cache.
+  static void init(const std::string& cache_root);
+
+  // Returns nullptr if the persistent cache is disabled or failed to initialize.
+  static DiskCodeCache* get();
+
+  // Tags the module with the id of the key and returns the object cache to attach to
+  // its execution engine.
+  std::unique_ptr<ModuleEntry> prepareModule(llvm::Module* module,
+                                             const CodeCacheKey& key);
+
+  size_t getHitCount() const { return hit_count_; }
+  size_t getMissCount() const { return miss_count_; }
+  size_t getWriteErrorCount() const { return write_error_count_; }
+
+ private:
+  DiskCodeCache(const std::string& cache_dir);
+
+  std::string objectPath(const std::string& id) const;
+  std::string keyPath(const std::string& id) const;
+  bool keyMatches(const std::string& id, const std::string& serialized_key) const;
+  void storeObject(const std::string& id,
+                   const std::string& serialized_key,
+                   llvm::MemoryBufferRef obj);
+  void evictOldest(const size_t target_count);
+
+  const std::string cache_dir_;
+
+  mutable std::mutex ids_mutex_;
+  std::unordered_set<std::string> ids_;
+
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+  std::atomic<size_t> write_error_count_{0};
+
+  static std::unique_ptr<DiskCodeCache> instance_;
+};
@@ -31,6 +31,7 @@
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JsonAccessors.h"
+#include "KernelScheduler.h"
 #include "OutputBufferInitialization.h"
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryRewrite.h"
@@ -50,6 +51,7 @@
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
+#include "Shared/numa.h"
 #include "Shared/scope.h"
 #include "Shared/shard_key.h"
 #include "Shared/threadpool.h"
@@ -65,6 +67,7 @@
 #include <cuda.h>
 #endif  // HAVE_CUDA
 #include <future>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -73,6 +76,10 @@
 bool g_enable_watchdog{false};
 bool g_enable_dynamic_watchdog{false};
 bool g_use_tbb_pool{false};
+bool g_enable_kernel_scheduler{false};
+size_t g_kernel_scheduler_min_morsel_rows{64 * 1024};
+size_t g_chunk_prefetch_fragment_count{0};
+size_t g_chunk_prefetch_threads{2};
 bool g_enable_filter_function{true};
 unsigned g_dynamic_watchdog_time_limit{10000};
 bool g_allow_cpu_retry{true};
@@ -80,6 +87,7 @@ bool g_null_div_by_zero{false};
 unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_enable_join_key_range_skipping{true};
 extern bool g_enable_smem_group_by;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -135,7 +143,6 @@ Executor::Executor(const ExecutorId executor_id,
                    const std::string& debug_dir,
                    const std::string& debug_file)
     : cgen_state_(new CgenState({}, false))
-    , cpu_code_cache_(code_cache_size)
     , gpu_code_cache_(code_cache_size)
     , block_size_x_(block_size_x)
     , grid_size_x_(grid_size_x)
@@ -1422,7 +1429,8 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                             co.allow_lazy_fetch,
                                             co.filter_on_deleted_column,
                                             co.explain_type,
-                                            co.register_intel_jit_listener},
+                                            co.register_intel_jit_listener,
+                                            co.batch_filters},
                                            eo,
                                            render_info,
                                            this);
@@ -1467,7 +1475,25 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                      render_info,
                                      available_gpus,
                                      available_cpus);
-        if (g_use_tbb_pool) {
+        chunk_prefetcher_ = createChunkPrefetcher(ra_exe_unit, query_infos, kernels);
+        ScopeGuard reset_chunk_prefetcher = [this] { chunk_prefetcher_.reset(); };
+        const bool all_cpu_kernels =
+            std::all_of(kernels.begin(), kernels.end(), [](const auto& kernel) {
+              return kernel->getDeviceType() == ExecutorDeviceType::CPU;
+            });
+        if (g_enable_kernel_scheduler && all_cpu_kernels) {
+          // Only the results of aggregates are reduced, projections are concatenated in
+          // fragment order. A morsel starts mid fragment, which the generated code only
+          // supports for the first combination of fragments, i.e. without loop joins.
+          const auto& join_info = plan_state_->join_info_;
+          const bool split_into_morsels =
+              is_agg && !ra_exe_unit.estimator &&
+              ra_exe_unit.join_quals.size() + 1 == ra_exe_unit.input_descs.size() &&
+              join_info.join_hash_tables_.size() == ra_exe_unit.join_quals.size() &&
+              join_info.sharded_range_table_indices_.empty();
+          launchKernelsOnScheduler(
+              shared_context, std::move(kernels), split_into_morsels);
+        } else if (g_use_tbb_pool) {
 #ifdef HAVE_TBB
           VLOG(1) << "Using TBB thread pool for kernel dispatch.";
           launchKernels<threadpool::TbbThreadPool<void>>(shared_context,
@@ -1680,10 +1706,9 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
         continue;
       }
       if (count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet) {
-        auto count_distinct_set = new std::set<int64_t>();
         CHECK(row_set_mem_owner);
-        row_set_mem_owner->addCountDistinctSet(count_distinct_set);
-        entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
+        entry.push_back(
+            reinterpret_cast<int64_t>(row_set_mem_owner->makeCountDistinctSet()));
         continue;
       }
     }
@@ -2084,7 +2109,8 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
         [this, &shared_context, parent_thread_id = logger::thread_id()](
             ExecutionKernel* kernel) {
           CHECK(kernel);
-          DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+          // pool workers run the kernels of many queries
+          logger::DebugTimerNewTask debug_timer_task(parent_thread_id);
           kernel->run(this, shared_context);
         },
         kernel.get());
@@ -2092,6 +2118,152 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   thread_pool.join();
 }
 
+void Executor::launchKernelsOnScheduler(
+    SharedKernelContext& shared_context,
+    std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+    const bool split_into_morsels) {
+  // No kernel lock: the state of the query lives in this executor and the shared
+  // context, so the kernels of concurrent queries share the scheduler workers.
+  auto& scheduler = KernelScheduler::instance();
+  const auto& query_infos = shared_context.getQueryInfos();
+  if (split_into_morsels) {
+    // Aim for a couple of morsels per worker, so a fragment much larger than the others
+    // doesn't leave the rest of the workers idle at the end of the query.
+    size_t total_row_count = 0;
+    for (const auto& kernel : kernels) {
+      total_row_count += kernel->getOuterRowCount(query_infos);
+    }
+    const size_t morsel_row_count =
+        std::max(g_kernel_scheduler_min_morsel_rows,
+                 (total_row_count + 2 * scheduler.workerCount() - 1) /
+                     (2 * scheduler.workerCount()));
+    std::vector<std::unique_ptr<ExecutionKernel>> morsels;
+    for (auto& kernel : kernels) {
+      auto kernel_morsels = kernel->splitIntoMorsels(morsel_row_count, query_infos);
+      if (kernel_morsels.empty()) {
+        morsels.push_back(std::move(kernel));
+      } else {
+        std::move(
+            kernel_morsels.begin(), kernel_morsels.end(), std::back_inserter(morsels));
+      }
+    }
+    VLOG(1) << "Split " << kernels.size() << " kernels into " << morsels.size()
+            << " morsels of at most " << morsel_row_count << " rows.";
+    kernels = std::move(morsels);
+  }
+  std::vector<std::function<void()>> tasks;
+  std::vector<size_t> weights;
+  std::vector<int> numa_nodes;
+  tasks.reserve(kernels.size());
+  weights.reserve(kernels.size());
+  numa_nodes.reserve(kernels.size());
+  for (auto& kernel : kernels) {
+    CHECK(kernel);
+    weights.push_back(kernel->getOuterRowCount(query_infos));
+    // The CPU buffer pool caches the chunks of a fragment on the node picked by its id,
+    // so run the kernel on the node of its first outer fragment.
+    const auto& frag_list = kernel->getFragmentsList();
+    numa_nodes.push_back(
+        !frag_list.empty() && !frag_list.front().fragment_ids.empty()
+            ? numa::fragment_node(
+                  static_cast<int>(frag_list.front().fragment_ids.front()))
+            : -1);
+    tasks.emplace_back([this,
+                        &shared_context,
+                        kernel = kernel.get(),
+                        parent_thread_id = logger::thread_id()]() {
+      logger::DebugTimerNewTask debug_timer_task(parent_thread_id);
+      kernel->run(this, shared_context);
+    });
+  }
+  VLOG(1) << "Scheduling " << kernels.size() << " kernels for query.";
+  const auto stats = scheduler.run(std::move(tasks), weights, numa_nodes);
+  kernel_queue_time_ms_ += stats.queue_time_us / 1000;
+  VLOG(1) << "Executor " << executor_id_ << " kernel scheduler: " << stats.toString();
+}
+
+std::unique_ptr<ChunkPrefetcher> Executor::createChunkPrefetcher(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const std::vector<std::unique_ptr<ExecutionKernel>>& kernels) {
+  if (g_chunk_prefetch_fragment_count == 0 || g_chunk_prefetch_threads == 0 ||
+      ra_exe_unit.input_descs.empty() || query_infos.empty()) {
+    return nullptr;
+  }
+  const int outer_table_id = ra_exe_unit.input_descs[0].getTableId();
+  if (outer_table_id <= 0) {
+    return nullptr;
+  }
+  CHECK(plan_state_);
+  const auto& cat = *getCatalog();
+  std::vector<const ColumnDescriptor*> cds;
+  for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+    if (col_desc->getScanDesc().getNestLevel() != 0 ||
+        !plan_state_->columns_to_fetch_.count(
+            std::make_pair(outer_table_id, col_desc->getColId()))) {
+      continue;
+    }
+    const auto cd =
+        get_column_descriptor_maybe(col_desc->getColId(), outer_table_id, cat);
+    if (cd && !cd->isVirtualCol) {
+      cds.push_back(cd);
+    }
+  }
+  if (cds.empty()) {
+    return nullptr;
+  }
+  const auto& outer_fragments = query_infos.front().info.fragments;
+  std::vector<ChunkPrefetcher::Request> requests;
+  std::set<ChunkKey> requested_keys;
+  size_t fragment_seq = 0;
+  for (const auto& kernel : kernels) {
+    if (kernel->getDeviceType() != ExecutorDeviceType::CPU) {
+      continue;
+    }
+    for (const auto& frags_per_table : kernel->getFragmentsList()) {
+      if (frags_per_table.table_id != outer_table_id) {
+        continue;
+      }
+      for (const auto frag_id : frags_per_table.fragment_ids) {
+        CHECK_LT(frag_id, outer_fragments.size());
+        const auto& fragment = outer_fragments[frag_id];
+        if (fragment.isEmptyPhysicalFragment()) {
+          continue;
+        }
+        const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+        for (const auto cd : cds) {
+          const auto chunk_meta_it = chunk_metadata_map.find(cd->columnId);
+          if (chunk_meta_it == chunk_metadata_map.end()) {
+            continue;
+          }
+          ChunkKey key{cat.getCurrentDB().dbId,
+                       fragment.physicalTableId,
+                       cd->columnId,
+                       fragment.fragmentId};
+          if (!requested_keys.insert(key).second) {
+            continue;
+          }
+          requests.push_back({std::move(key),
+                              cd,
+                              chunk_meta_it->second->numBytes,
+                              chunk_meta_it->second->numElements,
+                              fragment_seq});
+        }
+        ++fragment_seq;
+      }
+    }
+  }
+  if (requests.empty()) {
+    return nullptr;
+  }
+  VLOG(1) << "Prefetching " << requests.size() << " chunks of " << fragment_seq
+          << " fragments.";
+  return std::make_unique<ChunkPrefetcher>(&cat.getDataMgr(),
+                                           std::move(requests),
+                                           g_chunk_prefetch_fragment_count,
+                                           g_chunk_prefetch_threads);
+}
+
 std::vector<size_t> Executor::getTableFragmentIndices(
     const RelAlgExecutionUnit& ra_exe_unit,
     const ExecutorDeviceType device_type,
@@ -3273,6 +3445,39 @@ std::tuple<bool, int64_t, int64_t> get_hpt_overflow_underflow_safe_scaled_values
   return std::make_tuple(false, chunk_min, chunk_max);
 }
 
+const ChunkValueSketch* get_value_sketch(
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const int col_id) {
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  const auto chunk_meta_it = chunk_metadata_map.find(col_id);
+  if (chunk_meta_it == chunk_metadata_map.end()) {
+    return nullptr;
+  }
+  return chunk_meta_it->second->valueSketch.get();
+}
+
+// Returns true if the chunk's value sketch proves that none of its values equals `val`.
+bool value_sketch_rules_out(const Fragmenter_Namespace::FragmentInfo& fragment,
+                            const int col_id,
+                            const int64_t val) {
+  const auto value_sketch = get_value_sketch(fragment, col_id);
+  return value_sketch && !value_sketch->mayContain(val);
+}
+
+// String literals compared to a dictionary-encoded column are wrapped in a cast to the
+// column's dictionary.
+const Analyzer::Constant* get_string_literal(const Analyzer::Expr* expr) {
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (uoper && uoper->get_optype() == kCAST) {
+    expr = uoper->get_operand();
+  }
+  const auto literal = dynamic_cast<const Analyzer::Constant*>(expr);
+  if (!literal || literal->get_is_null() || !literal->get_type_info().is_string()) {
+    return nullptr;
+  }
+  return literal;
+}
+
 }  // namespace
 
 std::pair<bool, int64_t> Executor::skipFragment(
@@ -3306,6 +3511,31 @@ std::pair<bool, int64_t> Executor::skipFragment(
       }
     }
     const auto rhs = comp_expr->get_right_operand();
+    if (lhs->get_type_info().is_dict_encoded_string()) {
+      // dictionary ids carry no order, only equality can be ruled out
+      const auto rhs_literal = get_string_literal(rhs);
+      const auto value_sketch =
+          comp_expr->get_optype() == kEQ && lhs == lhs_col && rhs_literal
+              ? get_value_sketch(fragment, lhs_col->get_column_id())
+              : nullptr;
+      if (value_sketch) {
+        CHECK(plan_state_);
+        auto& sketch_string_ids = plan_state_->sketch_string_ids_;
+        auto str_id_it = sketch_string_ids.find(rhs_literal);
+        if (str_id_it == sketch_string_ids.end()) {
+          const auto sdp = getStringDictionaryProxy(
+              lhs_col->get_type_info().get_comp_param(), row_set_mem_owner_, true);
+          CHECK(sdp);
+          const auto& str = *rhs_literal->get_constval().stringval;
+          str_id_it =
+              sketch_string_ids.emplace(rhs_literal, sdp->getIdOfString(str)).first;
+        }
+        if (str_id_it->second >= 0 && !value_sketch->mayContain(str_id_it->second)) {
+          return {true, -1};
+        }
+      }
+      continue;
+    }
     const auto rhs_const = dynamic_cast<const Analyzer::Constant*>(rhs);
     if (!rhs_const) {
       // is this possible?
@@ -3400,6 +3630,15 @@ std::pair<bool, int64_t> Executor::skipFragment(
           return {true, -1};
         } else if (is_rowid) {
           return {false, rhs_val - start_rowid};
+        } else if (lhs == lhs_col &&
+                   lhs_col->get_type_info().get_type() ==
+                       rhs_const->get_type_info().get_type() &&
+                   lhs_col->get_type_info().get_dimension() ==
+                       rhs_const->get_type_info().get_dimension() &&
+                   value_sketch_rules_out(fragment, col_id, rhs_val)) {
+          // the sketch holds the column's own values, so only probe it when the
+          // constant is of the same type and precision and no cast is involved
+          return {true, -1};
         }
         break;
       default:
@@ -3456,6 +3695,10 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     }
     auto temp_skip_frag = skipFragment(
         table_desc, fragment, inner_join_simple_quals, frag_offsets, frag_idx);
+    if (!temp_skip_frag.first && temp_skip_frag.second == -1 &&
+        g_enable_join_key_range_skipping) {
+      temp_skip_frag.first = skipFragmentJoinKeyRange(table_desc, inner_join, fragment);
+    }
     if (temp_skip_frag.second != -1) {
       skip_frag.second = temp_skip_frag.second;
       return skip_frag;
@@ -3466,6 +3709,60 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
+bool Executor::skipFragmentJoinKeyRange(
+    const InputDescriptor& table_desc,
+    const JoinCondition& inner_join,
+    const Fragmenter_Namespace::FragmentInfo& fragment) const {
+  CHECK(plan_state_);
+  for (const auto& join_hash_table : plan_state_->join_info_.join_hash_tables_) {
+    const auto key_range = join_hash_table->getKeyRange();
+    if (!key_range) {
+      continue;
+    }
+    const auto outer_col = key_range->outer_col;
+    CHECK(outer_col);
+    if (outer_col->get_rte_idx() ||
+        outer_col->get_table_id() != table_desc.getTableId()) {
+      continue;
+    }
+    const bool built_for_inner_join =
+        std::any_of(inner_join.quals.begin(),
+                    inner_join.quals.end(),
+                    [&key_range](const std::shared_ptr<Analyzer::Expr>& qual) {
+                      return *qual == *key_range->qual_bin_oper;
+                    });
+    if (!built_for_inner_join) {
+      continue;
+    }
+    if (key_range->min > key_range->max) {
+      // nothing to join with
+      ++join_key_range_skipped_fragment_count_;
+      return true;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(outer_col->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      continue;
+    }
+    const auto& chunk_stats = chunk_meta_it->second->chunkStats;
+    const auto& chunk_type = outer_col->get_type_info();
+    const auto chunk_min = extract_min_stat(chunk_stats, chunk_type);
+    const auto chunk_max = extract_max_stat(chunk_stats, chunk_type);
+    if (chunk_min > chunk_max) {
+      // invalid metadata range, do not skip fragment
+      continue;
+    }
+    if (chunk_max < key_range->min || chunk_min > key_range->max) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " of table "
+              << table_desc.getTableId() << ", its keys are outside of the range ["
+              << key_range->min << ", " << key_range->max << "] of the inner join";
+      ++join_key_range_skipped_fragment_count_;
+      return true;
+    }
+  }
+  return false;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -3671,6 +3968,7 @@ void* Executor::gpu_active_modules_[max_gpu_count];
 std::atomic<bool> Executor::interrupted_{false};
 
 std::mutex Executor::compilation_mutex_;
+CodeCache Executor::cpu_code_cache_(code_cache_size);
 std::mutex Executor::kernel_mutex_;
 
 mapd_shared_mutex Executor::recycler_mutex_;
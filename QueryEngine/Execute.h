@@ -21,6 +21,7 @@
 #include "BufferCompaction.h"
 #include "CartesianProduct.h"
 #include "CgenState.h"
+#include "ChunkPrefetcher.h"
 #include "CodeCache.h"
 #include "DateTimeUtils.h"
 #include "Descriptors/QueryFragmentDescriptor.h"
@@ -406,6 +407,12 @@ class Executor {
   void enableRuntimeQueryInterrupt(const double runtime_query_check_freq,
                                    const unsigned pending_query_check_freq) const;
 
+  // Number of outer fragments skipped so far because none of their keys is in the key
+  // range of an inner join hash table.
+  size_t getJoinKeyRangeSkippedFragmentCount() const {
+    return join_key_range_skipped_fragment_count_;
+  }
+
   static const size_t high_scan_limit{32000000};
 
   int8_t warpSize() const;
@@ -556,6 +563,26 @@ class Executor {
   void launchKernels(SharedKernelContext& shared_context,
                      std::vector<std::unique_ptr<ExecutionKernel>>&& kernels);
 
+  /**
+   * Runs CPU execution kernels on the process-wide work-stealing KernelScheduler,
+   * without the kernel lock, so concurrent queries share the workers. With
+   * split_into_morsels, kernels over a large outer fragment are split into row range
+   * morsels whose results are reduced like those of separate fragments.
+   */
+  void launchKernelsOnScheduler(SharedKernelContext& shared_context,
+                                std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                                const bool split_into_morsels);
+
+  /**
+   * Starts reading the chunks of the outer table fragments the kernels scan into the
+   * CPU buffer pool, in dispatch order. Returns nullptr when prefetching is disabled or
+   * there is nothing to read.
+   */
+  std::unique_ptr<ChunkPrefetcher> createChunkPrefetcher(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& query_infos,
+      const std::vector<std::unique_ptr<ExecutionKernel>>& kernels);
+
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
       const ExecutorDeviceType device_type,
@@ -759,6 +786,18 @@ class Executor {
                    const CompilationOptions& co,
                    const GpuSharedMemoryContext& gpu_smem_context = {});
 
+  // Generate a filter over blocks of rows for the quals of a single table scan which
+  // compare a fixed width column with a literal and take them out of the execution unit.
+  // Returns nullptr if there are no such quals.
+  llvm::Function* codegenBatchFilter(RelAlgExecutionUnit& ra_exe_unit,
+                                     const CompilationOptions& co);
+
+  // Make the scan loop of the query function visit only the rows which pass the batch
+  // filter.
+  void insertBatchFilter(llvm::Function* query_func,
+                         llvm::Function* batch_filter_func,
+                         const CompilationOptions& co);
+
   void createErrorCheckControlFlow(llvm::Function* query_func,
                                    bool run_with_dynamic_watchdog,
                                    bool run_with_allowing_runtime_interrupt,
@@ -838,6 +877,12 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Whether the key range of a hash table built for the inner join rules out all the
+  // rows of the outer fragment.
+  bool skipFragmentJoinKeyRange(const InputDescriptor& table_desc,
+                                const JoinCondition& inner_join,
+                                const Fragmenter_Namespace::FragmentInfo& fragment) const;
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
@@ -887,6 +932,12 @@ class Executor {
  private:
   std::shared_ptr<CompilationContext> getCodeFromCache(const CodeCacheKey&,
                                                        const CodeCache&);
+  // Tiered compilation: once the cached CPU code for the key is hot, recompiles the
+  // query with the optimizing pipeline in the background.
+  void requestTierUp(const CodeCacheKey& key,
+                     llvm::Function* multifrag_query_func,
+                     const std::unordered_set<llvm::Function*>& live_funcs,
+                     const CompilationOptions& co);
 
   std::vector<int8_t> serializeLiterals(
       const std::unordered_map<int, CgenState::LiteralValues>& literals,
@@ -917,6 +968,8 @@ class Executor {
 
   std::unique_ptr<PlanState> plan_state_;
   std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner_;
+  // Set while the kernels of a query step run, see createChunkPrefetcher.
+  std::unique_ptr<ChunkPrefetcher> chunk_prefetcher_;
 
   static const int max_gpu_count{16};
   std::mutex gpu_exec_mutex_[max_gpu_count];
@@ -931,7 +984,9 @@ class Executor {
 
   mutable std::unique_ptr<llvm::TargetMachine> nvptx_target_machine_;
 
-  CodeCache cpu_code_cache_;
+  // Shared by all executors, CPU code doesn't depend on per-executor device state.
+  // Guarded by compilation_mutex_.
+  static CodeCache cpu_code_cache_;
   CodeCache gpu_code_cache_;
 
   static const size_t baseline_threshold{
@@ -948,8 +1003,10 @@ class Executor {
   const Catalog_Namespace::Catalog* catalog_;
   const TemporaryTables* temporary_tables_;
 
-  int64_t kernel_queue_time_ms_ = 0;
-  int64_t compilation_queue_time_ms_ = 0;
+  // Atomic, kernels on the scheduler run outside of the kernel lock.
+  std::atomic<int64_t> kernel_queue_time_ms_{0};
+  std::atomic<int64_t> compilation_queue_time_ms_{0};
+  mutable std::atomic<size_t> join_key_range_skipped_fragment_count_{0};
 
   // Singleton instance used for an execution unit which is a project with window
   // functions.
@@ -87,6 +87,68 @@ SharedKernelContext::getFragmentResults() {
   return all_fragment_results_;
 }
 
+size_t ExecutionKernel::getOuterRowCount(
+    const std::vector<InputTableInfo>& query_infos) const {
+  if (outer_row_range_) {
+    return outer_row_range_->end - outer_row_range_->begin;
+  }
+  if (frag_list.empty()) {
+    return 0;
+  }
+  const auto& outer_frags = frag_list.front();
+  const auto table_info_it = std::find_if(
+      query_infos.begin(), query_infos.end(), [&outer_frags](const auto& query_info) {
+        return query_info.table_id == outer_frags.table_id;
+      });
+  if (table_info_it == query_infos.end()) {
+    return 0;
+  }
+  const auto& fragments = table_info_it->info.fragments;
+  size_t row_count = 0;
+  for (const auto frag_id : outer_frags.fragment_ids) {
+    if (frag_id < fragments.size()) {
+      row_count += fragments[frag_id].getNumTuples();
+    }
+  }
+  return row_count;
+}
+
+std::vector<std::unique_ptr<ExecutionKernel>> ExecutionKernel::splitIntoMorsels(
+    const size_t morsel_row_count,
+    const std::vector<InputTableInfo>& query_infos) const {
+  CHECK_GT(morsel_row_count, size_t(0));
+  std::vector<std::unique_ptr<ExecutionKernel>> morsels;
+  if (chosen_device_type != ExecutorDeviceType::CPU ||
+      kernel_dispatch_mode != ExecutorDispatchMode::KernelPerFragment ||
+      rowid_lookup_key >= 0 || outer_row_range_ || ra_exe_unit_.union_all ||
+      frag_list.empty() || frag_list.front().fragment_ids.size() != 1) {
+    return morsels;
+  }
+  const auto row_count = getOuterRowCount(query_infos);
+  if (row_count <= morsel_row_count) {
+    return morsels;
+  }
+  const size_t morsel_count = (row_count + morsel_row_count - 1) / morsel_row_count;
+  for (size_t i = 0; i < morsel_count; ++i) {
+    const OuterRowRange row_range{
+        static_cast<int64_t>(row_count * i / morsel_count),
+        static_cast<int64_t>(row_count * (i + 1) / morsel_count)};
+    morsels.push_back(std::make_unique<ExecutionKernel>(ra_exe_unit_,
+                                                        chosen_device_type,
+                                                        chosen_device_id,
+                                                        eo,
+                                                        column_fetcher,
+                                                        query_comp_desc,
+                                                        query_mem_desc,
+                                                        frag_list,
+                                                        kernel_dispatch_mode,
+                                                        render_info_,
+                                                        rowid_lookup_key,
+                                                        row_range));
+  }
+  return morsels;
+}
+
 void ExecutionKernel::run(Executor* executor, SharedKernelContext& shared_context) {
   DEBUG_TIMER("ExecutionKernel::run");
   INJECT_TIMER(kernel_run);
@@ -274,8 +336,22 @@ void ExecutionKernel::runImpl(Executor* executor, SharedKernelContext& shared_co
       const auto& all_frag_row_offsets = shared_context.getFragOffsets();
       start_rowid = rowid_lookup_key -
                     all_frag_row_offsets[frag_list.begin()->fragment_ids.front()];
+      if (chosen_device_type == ExecutorDeviceType::CPU) {
+        auto& outer_row_count = fetch_result.num_rows.front().front();
+        outer_row_count =
+            std::min(outer_row_count, static_cast<int64_t>(start_rowid) + 1);
+      }
     }
   }
+  if (outer_row_range_) {
+    // The generated code starts at the row passed in the error code, which only applies
+    // to the first combination of fragments.
+    CHECK(chosen_device_type == ExecutorDeviceType::CPU);
+    CHECK_EQ(fetch_result.num_rows.size(), size_t(1));
+    auto& outer_row_count = fetch_result.num_rows.front().front();
+    outer_row_count = std::min(outer_row_count, outer_row_range_->end);
+    start_rowid = outer_row_range_->begin;
+  }
 
   if (ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(ra_exe_unit_,
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
@@ -45,6 +47,12 @@ class SharedKernelContext {
   const std::vector<InputTableInfo>& query_infos_;
 };
 
+// Rows [begin, end) of the outer fragment of a kernel.
+struct OuterRowRange {
+  int64_t begin;
+  int64_t end;
+};
+
 class ExecutionKernel {
  public:
   ExecutionKernel(const RelAlgExecutionUnit& ra_exe_unit,
@@ -57,7 +65,8 @@ class ExecutionKernel {
                   const FragmentsList& frag_list,
                   const ExecutorDispatchMode kernel_dispatch_mode,
                   RenderInfo* render_info,
-                  const int64_t rowid_lookup_key)
+                  const int64_t rowid_lookup_key,
+                  const std::optional<OuterRowRange> outer_row_range = std::nullopt)
       : ra_exe_unit_(ra_exe_unit)
       , chosen_device_type(chosen_device_type)
       , chosen_device_id(chosen_device_id)
@@ -68,10 +77,26 @@ class ExecutionKernel {
       , frag_list(frag_list)
       , kernel_dispatch_mode(kernel_dispatch_mode)
       , render_info_(render_info)
-      , rowid_lookup_key(rowid_lookup_key) {}
+      , rowid_lookup_key(rowid_lookup_key)
+      , outer_row_range_(outer_row_range) {}
 
   void run(Executor* executor, SharedKernelContext& shared_context);
 
+  // Number of outer table rows this kernel scans, used to order kernels for dispatch.
+  size_t getOuterRowCount(const std::vector<InputTableInfo>& query_infos) const;
+
+  // Splits a CPU kernel over a single outer fragment into morsels, kernels scanning
+  // consecutive row ranges of at most morsel_row_count rows of the fragment. Each morsel
+  // has its own output buffers, the results are reduced like those of separate
+  // fragments. Returns an empty vector if the kernel can't be split.
+  std::vector<std::unique_ptr<ExecutionKernel>> splitIntoMorsels(
+      const size_t morsel_row_count,
+      const std::vector<InputTableInfo>& query_infos) const;
+
+  ExecutorDeviceType getDeviceType() const { return chosen_device_type; }
+
+  const FragmentsList& getFragmentsList() const { return frag_list; }
+
  private:
   const RelAlgExecutionUnit& ra_exe_unit_;
   const ExecutorDeviceType chosen_device_type;
@@ -84,6 +109,7 @@ class ExecutionKernel {
   const ExecutorDispatchMode kernel_dispatch_mode;
   RenderInfo* render_info_;
   const int64_t rowid_lookup_key;
+  const std::optional<OuterRowRange> outer_row_range_;
 
   ResultSetPtr device_results_;
 
@@ -19,6 +19,7 @@
 
 #include "CardinalityEstimator.h"
 #include "CodeGenerator.h"
+#include "CountDistinctSet.h"
 #include "Descriptors/QueryMemoryDescriptor.h"
 #include "ExpressionRange.h"
 #include "ExpressionRewrite.h"
@@ -1718,7 +1719,7 @@ void GroupByAndAggregate::codegenEstimator(
 }
 
 extern "C" void agg_count_distinct(int64_t* agg, const int64_t val) {
-  reinterpret_cast<std::set<int64_t>*>(*agg)->insert(val);
+  reinterpret_cast<CountDistinctSet*>(*agg)->insert(val);
 }
 
 extern "C" void agg_count_distinct_skip_val(int64_t* agg,
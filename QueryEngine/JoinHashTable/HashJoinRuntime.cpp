@@ -34,6 +34,7 @@
 #include "StringDictionary/StringDictionary.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <atomic>
 #include <future>
 #endif
 
@@ -1494,6 +1495,250 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                    launch_fill_row_ids);
 }
 
+namespace {
+
+// Slot of a build side row in a perfect hash table, with the row id.
+struct PartitionedSlot {
+  int64_t slot;
+  int32_t row_id;
+};
+
+// The slots of a join column grouped by radix partition, i.e. by range of
+// partition_entry_count hash table entries. Partition p holds the slots in
+// [partition_offsets[p], partition_offsets[p + 1]).
+struct PartitionedJoinColumn {
+  std::vector<PartitionedSlot> slots;
+  std::vector<size_t> partition_offsets;
+};
+
+// Calls visit(slot, row_id) for the rows of the thread's slice of the join column, with
+// the same null handling and string translation as fill_hash_join_buff_impl.
+template <typename SLOT_VISITOR>
+void visit_join_column_slots(const JoinColumn& join_column,
+                             const JoinColumnTypeInfo& type_info,
+                             const void* sd_inner_proxy,
+                             const void* sd_outer_proxy,
+                             const int64_t bucket_normalization,
+                             const int32_t cpu_thread_idx,
+                             const int32_t cpu_thread_count,
+                             SLOT_VISITOR visit) {
+  JoinColumnTyped col{&join_column, &type_info};
+  for (auto item : col.slice(cpu_thread_idx, cpu_thread_count)) {
+    int64_t elem = item.element;
+    if (elem == type_info.null_val) {
+      if (type_info.uses_bw_eq) {
+        elem = type_info.translated_null_val;
+      } else {
+        continue;
+      }
+    }
+    if (sd_inner_proxy &&
+        (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = translate_str_id_to_outer_dict(
+          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      if (outer_id == StringDictionary::INVALID_STR_ID) {
+        continue;
+      }
+      elem = outer_id;
+    }
+    CHECK_GE(elem, type_info.min_val)
+        << "Element " << elem << " less than min val " << type_info.min_val;
+    visit((elem - type_info.min_val) / bucket_normalization,
+          static_cast<int32_t>(item.index));
+  }
+}
+
+size_t get_partition_shift(const size_t partition_entry_count) {
+  size_t shift{0};
+  while ((size_t(2) << shift) <= partition_entry_count) {
+    ++shift;
+  }
+  return shift;
+}
+
+// Scatters the slots of the join column to their partitions. Every thread first
+// collects the slots of its slice, counting them per partition, and then copies them to
+// the offsets the counts give, so that the partitions are written sequentially.
+PartitionedJoinColumn partition_join_column(const JoinColumn& join_column,
+                                            const JoinColumnTypeInfo& type_info,
+                                            const void* sd_inner_proxy,
+                                            const void* sd_outer_proxy,
+                                            const int64_t bucket_normalization,
+                                            const size_t partition_shift,
+                                            const size_t partition_count,
+                                            const unsigned cpu_thread_count) {
+  std::vector<std::vector<PartitionedSlot>> thread_slots(cpu_thread_count);
+  std::vector<std::vector<size_t>> thread_offsets(cpu_thread_count,
+                                                  std::vector<size_t>(partition_count));
+  std::vector<std::future<void>> partition_threads;
+  for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+    partition_threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+      auto& slots = thread_slots[thread_idx];
+      auto& counts = thread_offsets[thread_idx];
+      slots.reserve(join_column.num_elems / cpu_thread_count + 1);
+      visit_join_column_slots(join_column,
+                              type_info,
+                              sd_inner_proxy,
+                              sd_outer_proxy,
+                              bucket_normalization,
+                              thread_idx,
+                              cpu_thread_count,
+                              [&slots, &counts, partition_shift](const int64_t slot,
+                                                                 const int32_t row_id) {
+                                slots.push_back({slot, row_id});
+                                ++counts[slot >> partition_shift];
+                              });
+    }));
+  }
+  for (auto& child : partition_threads) {
+    child.get();
+  }
+
+  PartitionedJoinColumn partitioned;
+  partitioned.partition_offsets.resize(partition_count + 1);
+  size_t offset{0};
+  for (size_t partition = 0; partition < partition_count; ++partition) {
+    partitioned.partition_offsets[partition] = offset;
+    for (auto& offsets : thread_offsets) {
+      const auto count = offsets[partition];
+      offsets[partition] = offset;
+      offset += count;
+    }
+  }
+  partitioned.partition_offsets[partition_count] = offset;
+  partitioned.slots.resize(offset);
+
+  partition_threads.clear();
+  for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+    partition_threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+      auto& offsets = thread_offsets[thread_idx];
+      for (const auto& slot : thread_slots[thread_idx]) {
+        partitioned.slots[offsets[slot.slot >> partition_shift]++] = slot;
+      }
+      thread_slots[thread_idx] = std::vector<PartitionedSlot>();
+    }));
+  }
+  for (auto& child : partition_threads) {
+    child.get();
+  }
+  return partitioned;
+}
+
+}  // namespace
+
+int fill_hash_join_buff_bucketized_partitioned(int32_t* buff,
+                                               const int32_t invalid_slot_val,
+                                               const JoinColumn& join_column,
+                                               const JoinColumnTypeInfo& type_info,
+                                               const void* sd_inner_proxy,
+                                               const void* sd_outer_proxy,
+                                               const int64_t hash_entry_count,
+                                               const int64_t bucket_normalization,
+                                               const size_t partition_entry_count,
+                                               const unsigned cpu_thread_count) {
+  CHECK_GT(hash_entry_count, int64_t(0));
+  const auto partition_shift = get_partition_shift(partition_entry_count);
+  const size_t partition_count = ((hash_entry_count - 1) >> partition_shift) + 1;
+  const auto partitioned = partition_join_column(join_column,
+                                                 type_info,
+                                                 sd_inner_proxy,
+                                                 sd_outer_proxy,
+                                                 bucket_normalization,
+                                                 partition_shift,
+                                                 partition_count,
+                                                 cpu_thread_count);
+  // Each partition covers its own range of entries, hence the threads fill them without
+  // atomics, each within a cache sized part of the table at a time.
+  std::atomic<size_t> next_partition{0};
+  std::atomic<int> err{0};
+  std::vector<std::future<void>> fill_threads;
+  for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+    fill_threads.push_back(std::async(std::launch::async, [&] {
+      for (size_t partition = next_partition++; partition < partition_count && !err;
+           partition = next_partition++) {
+        for (size_t i = partitioned.partition_offsets[partition];
+             i < partitioned.partition_offsets[partition + 1];
+             ++i) {
+          const auto& slot = partitioned.slots[i];
+          auto& entry = buff[slot.slot];
+          if (entry != invalid_slot_val) {
+            err = -1;
+            return;
+          }
+          entry = slot.row_id;
+        }
+      }
+    }));
+  }
+  for (auto& child : fill_threads) {
+    child.get();
+  }
+  return err;
+}
+
+void fill_one_to_many_hash_table_partitioned(int32_t* buff,
+                                             const int64_t hash_entry_count,
+                                             const int64_t bucket_normalization,
+                                             const int32_t invalid_slot_val,
+                                             const JoinColumn& join_column,
+                                             const JoinColumnTypeInfo& type_info,
+                                             const void* sd_inner_proxy,
+                                             const void* sd_outer_proxy,
+                                             const size_t partition_entry_count,
+                                             const unsigned cpu_thread_count) {
+  CHECK_GT(hash_entry_count, int64_t(0));
+  const auto partition_shift = get_partition_shift(partition_entry_count);
+  const size_t partition_count = ((hash_entry_count - 1) >> partition_shift) + 1;
+  const auto partitioned = partition_join_column(join_column,
+                                                 type_info,
+                                                 sd_inner_proxy,
+                                                 sd_outer_proxy,
+                                                 bucket_normalization,
+                                                 partition_shift,
+                                                 partition_count,
+                                                 cpu_thread_count);
+  // The threads take every cpu_thread_count-th partition, in both passes.
+  auto launch_count_matches = [count_buff = buff + hash_entry_count,
+                               &partitioned,
+                               partition_count](auto cpu_thread_idx,
+                                                auto cpu_thread_count) {
+    for (size_t partition = cpu_thread_idx; partition < partition_count;
+         partition += cpu_thread_count) {
+      for (size_t i = partitioned.partition_offsets[partition];
+           i < partitioned.partition_offsets[partition + 1];
+           ++i) {
+        ++count_buff[partitioned.slots[i].slot];
+      }
+    }
+  };
+  auto launch_fill_row_ids = [hash_entry_count, buff, &partitioned, partition_count](
+                                 auto cpu_thread_idx, auto cpu_thread_count) {
+    int32_t* pos_buff = buff;
+    int32_t* count_buff = buff + hash_entry_count;
+    int32_t* id_buff = count_buff + hash_entry_count;
+    for (size_t partition = cpu_thread_idx; partition < partition_count;
+         partition += cpu_thread_count) {
+      for (size_t i = partitioned.partition_offsets[partition];
+           i < partitioned.partition_offsets[partition + 1];
+           ++i) {
+        const auto& slot = partitioned.slots[i];
+        id_buff[pos_buff[slot.slot] + count_buff[slot.slot]++] = slot.row_id;
+      }
+    }
+  };
+
+  fill_one_to_many_hash_table_impl(buff,
+                                   hash_entry_count,
+                                   invalid_slot_val,
+                                   join_column,
+                                   type_info,
+                                   sd_inner_proxy,
+                                   sd_outer_proxy,
+                                   cpu_thread_count,
+                                   launch_count_matches,
+                                   launch_fill_row_ids);
+}
+
 template <typename COUNT_MATCHES_LAUNCH_FUNCTOR, typename FILL_ROW_IDS_LAUNCH_FUNCTOR>
 void fill_one_to_many_hash_table_sharded_impl(
     int32_t* buff,
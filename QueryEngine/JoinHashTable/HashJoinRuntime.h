@@ -222,6 +222,33 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                             const void* sd_outer_proxy,
                                             const unsigned cpu_thread_count);
 
+// Radix-partitioned CPU builds of perfect hash tables, equivalent to
+// fill_hash_join_buff_bucketized and fill_one_to_many_hash_table(_bucketized). The rows
+// are first partitioned by ranges of partition_entry_count hash table entries, then the
+// partitions are inserted in parallel, so that the writes of a thread stay within a
+// cache sized part of the table instead of missing the cache on every row.
+int fill_hash_join_buff_bucketized_partitioned(int32_t* buff,
+                                               const int32_t invalid_slot_val,
+                                               const JoinColumn& join_column,
+                                               const JoinColumnTypeInfo& type_info,
+                                               const void* sd_inner_proxy,
+                                               const void* sd_outer_proxy,
+                                               const int64_t hash_entry_count,
+                                               const int64_t bucket_normalization,
+                                               const size_t partition_entry_count,
+                                               const unsigned cpu_thread_count);
+
+void fill_one_to_many_hash_table_partitioned(int32_t* buff,
+                                             const int64_t hash_entry_count,
+                                             const int64_t bucket_normalization,
+                                             const int32_t invalid_slot_val,
+                                             const JoinColumn& join_column,
+                                             const JoinColumnTypeInfo& type_info,
+                                             const void* sd_inner_proxy,
+                                             const void* sd_outer_proxy,
+                                             const size_t partition_entry_count,
+                                             const unsigned cpu_thread_count);
+
 void fill_one_to_many_hash_table_sharded_bucketized(int32_t* buff,
                                                     const HashEntryInfo hash_entry_info,
                                                     const int32_t invalid_slot_val,
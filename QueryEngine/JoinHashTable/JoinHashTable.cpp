@@ -30,6 +30,10 @@
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
+bool g_enable_radix_join_build{true};
+size_t g_radix_join_min_hash_table_bytes{32 * 1024 * 1024};
+size_t g_radix_join_partition_bytes{256 * 1024};
+
 namespace {
 
 class NeedsOneToManyHash : public HashJoinFail {
@@ -37,6 +41,19 @@ class NeedsOneToManyHash : public HashJoinFail {
   NeedsOneToManyHash() : HashJoinFail("Needs one to many hash") {}
 };
 
+// Partitioning the build side costs two sequential passes over the rows, which only pays
+// off once both the hash table and the row ids written into it are larger than the last
+// level cache, i.e. once the global build misses the cache on most rows.
+bool use_radix_partitioned_build(const size_t hash_table_bytes, const size_t row_count) {
+  return g_enable_radix_join_build &&
+         hash_table_bytes > g_radix_join_min_hash_table_bytes &&
+         row_count * sizeof(int32_t) > g_radix_join_min_hash_table_bytes;
+}
+
+size_t get_radix_join_partition_entry_count() {
+  return std::max(g_radix_join_partition_bytes / sizeof(int32_t), size_t(1));
+}
+
 }  // namespace
 
 InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
@@ -777,39 +794,61 @@ void JoinHashTable::initOneToOneHashTableOnCpu(
     }
     init_cpu_buff_threads.clear();
     std::atomic<int> err{0};
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      init_cpu_buff_threads.emplace_back([this,
-                                          hash_join_invalid_val,
-                                          &join_column,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
-                                          thread_idx,
-                                          thread_count,
-                                          &ti,
-                                          &err,
-                                          hash_entry_info] {
-        int partial_err =
-            fill_hash_join_buff_bucketized(&(*cpu_hash_table_buff_)[0],
-                                           hash_join_invalid_val,
-                                           join_column,
-                                           {static_cast<size_t>(ti.get_size()),
-                                            col_range_.getIntMin(),
-                                            col_range_.getIntMax(),
-                                            inline_fixed_encoding_null_val(ti),
-                                            isBitwiseEq(),
-                                            col_range_.getIntMax() + 1,
-                                            get_join_column_type_kind(ti)},
-                                           sd_inner_proxy,
-                                           sd_outer_proxy,
-                                           thread_idx,
-                                           thread_count,
-                                           hash_entry_info.bucket_normalization);
-        int zero{0};
-        err.compare_exchange_strong(zero, partial_err);
-      });
-    }
-    for (auto& t : init_cpu_buff_threads) {
-      t.join();
+    if (use_radix_partitioned_build(
+            cpu_hash_table_buff_->size() * sizeof(int32_t), join_column.num_elems)) {
+      VLOG(1) << "Building the one-to-one hash table with radix partitioning";
+      err = fill_hash_join_buff_bucketized_partitioned(
+          &(*cpu_hash_table_buff_)[0],
+          hash_join_invalid_val,
+          join_column,
+          {static_cast<size_t>(ti.get_size()),
+           col_range_.getIntMin(),
+           col_range_.getIntMax(),
+           inline_fixed_encoding_null_val(ti),
+           isBitwiseEq(),
+           col_range_.getIntMax() + 1,
+           get_join_column_type_kind(ti)},
+          sd_inner_proxy,
+          sd_outer_proxy,
+          hash_entry_info.getNormalizedHashEntryCount(),
+          hash_entry_info.bucket_normalization,
+          get_radix_join_partition_entry_count(),
+          thread_count);
+    } else {
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        init_cpu_buff_threads.emplace_back([this,
+                                            hash_join_invalid_val,
+                                            &join_column,
+                                            sd_inner_proxy,
+                                            sd_outer_proxy,
+                                            thread_idx,
+                                            thread_count,
+                                            &ti,
+                                            &err,
+                                            hash_entry_info] {
+          int partial_err =
+              fill_hash_join_buff_bucketized(&(*cpu_hash_table_buff_)[0],
+                                             hash_join_invalid_val,
+                                             join_column,
+                                             {static_cast<size_t>(ti.get_size()),
+                                              col_range_.getIntMin(),
+                                              col_range_.getIntMax(),
+                                              inline_fixed_encoding_null_val(ti),
+                                              isBitwiseEq(),
+                                              col_range_.getIntMax() + 1,
+                                              get_join_column_type_kind(ti)},
+                                             sd_inner_proxy,
+                                             sd_outer_proxy,
+                                             thread_idx,
+                                             thread_count,
+                                             hash_entry_info.bucket_normalization);
+          int zero{0};
+          err.compare_exchange_strong(zero, partial_err);
+        });
+      }
+      for (auto& t : init_cpu_buff_threads) {
+        t.join();
+      }
     }
     if (err) {
       cpu_hash_table_buff_.reset();
@@ -869,7 +908,30 @@ void JoinHashTable::initOneToManyHashTableOnCpu(
     child.get();
   }
 
-  if (ti.get_type() == kDATE) {
+  if (use_radix_partitioned_build(cpu_hash_table_buff_->size() * sizeof(int32_t),
+                                  join_column.num_elems)) {
+    VLOG(1) << "Building the one-to-many hash table with radix partitioning";
+    // Tables other than date ones are filled with the raw entry count, unnormalized.
+    const bool bucketized = ti.get_type() == kDATE;
+    fill_one_to_many_hash_table_partitioned(
+        &(*cpu_hash_table_buff_)[0],
+        bucketized ? hash_entry_info.getNormalizedHashEntryCount()
+                   : hash_entry_info.hash_entry_count,
+        bucketized ? hash_entry_info.bucket_normalization : 1,
+        hash_join_invalid_val,
+        join_column,
+        {static_cast<size_t>(ti.get_size()),
+         col_range_.getIntMin(),
+         col_range_.getIntMax(),
+         inline_fixed_encoding_null_val(ti),
+         isBitwiseEq(),
+         col_range_.getIntMax() + 1,
+         get_join_column_type_kind(ti)},
+        sd_inner_proxy,
+        sd_outer_proxy,
+        get_radix_join_partition_entry_count(),
+        thread_count);
+  } else if (ti.get_type() == kDATE) {
     fill_one_to_many_hash_table_bucketized(&(*cpu_hash_table_buff_)[0],
                                            hash_entry_info,
                                            hash_join_invalid_val,
@@ -1422,6 +1484,32 @@ size_t JoinHashTable::payloadBufferOff() const noexcept {
   return 2 * getComponentBufferSize();
 }
 
+std::optional<JoinKeyRange> JoinHashTable::getKeyRange() const {
+  if (qual_bin_oper_->get_optype() != kEQ) {
+    // Nulls match each other with kBW_EQ and aren't part of the range.
+    return std::nullopt;
+  }
+  const auto cols = get_cols(
+      qual_bin_oper_.get(), *executor_->getCatalog(), executor_->temporary_tables_);
+  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+  if (!outer_col) {
+    return std::nullopt;
+  }
+  // Dictionary ids are only comparable through a translation and both sides of a time
+  // comparison must be in the same unit for the chunk metadata to compare to the range.
+  const auto& inner_ti = cols.first->get_type_info();
+  const auto& outer_ti = outer_col->get_type_info();
+  const bool comparable_types =
+      (inner_ti.is_integer() && outer_ti.is_integer()) ||
+      (inner_ti.is_time() && inner_ti.get_type() == outer_ti.get_type() &&
+       inner_ti.get_dimension() == outer_ti.get_dimension());
+  if (!comparable_types) {
+    return std::nullopt;
+  }
+  return JoinKeyRange{
+      qual_bin_oper_, outer_col, col_range_.getIntMin(), col_range_.getIntMax()};
+}
+
 size_t JoinHashTable::getComponentBufferSize() const noexcept {
   if (hash_type_ == JoinHashTableInterface::HashType::OneToMany) {
     return hash_entry_count_ * sizeof(int32_t);
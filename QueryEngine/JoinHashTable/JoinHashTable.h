@@ -100,6 +100,8 @@ class JoinHashTable : public JoinHashTableInterface {
 
   size_t payloadBufferOff() const noexcept override;
 
+  std::optional<JoinKeyRange> getKeyRange() const override;
+
   static HashJoinMatchingSet codegenMatchingSet(
       const std::vector<llvm::Value*>& hash_join_idx_args_in,
       const bool is_sharded,
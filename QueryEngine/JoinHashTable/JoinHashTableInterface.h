@@ -18,6 +18,8 @@
 
 #include <llvm/IR/Value.h>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -82,6 +84,16 @@ using DecodedJoinHashBufferSet = std::set<DecodedJoinHashBufferEntry>;
 
 using InnerOuter = std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>;
 
+//! Range of the inner keys of a join hash table, along with the qualifier it was built
+//! for and the outer column compared to the keys. Outer rows outside of the range can't
+//! have a match.
+struct JoinKeyRange {
+  std::shared_ptr<Analyzer::BinOper> qual_bin_oper;
+  const Analyzer::ColumnVar* outer_col;
+  int64_t min;
+  int64_t max;  // less than min if the inner column is empty
+};
+
 class DeviceAllocator;
 
 class JoinHashTableInterface {
@@ -140,6 +152,9 @@ class JoinHashTableInterface {
 
   virtual size_t payloadBufferOff() const noexcept = 0;
 
+  //! Key range for skipping outer fragments, if the table can tell.
+  virtual std::optional<JoinKeyRange> getKeyRange() const { return std::nullopt; }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
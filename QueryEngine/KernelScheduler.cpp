@@ -0,0 +1,268 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/KernelScheduler.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "Shared/measure.h"
+#include "Shared/numa.h"
+#include "Shared/thread_count.h"
+
+struct KernelScheduler::Batch {
+  std::atomic<size_t> pending_count{0};
+  std::atomic<size_t> steal_count{0};
+  std::atomic<size_t> off_node_count{0};
+  std::atomic<int64_t> busy_time_us{0};
+  std::atomic<bool> failed{false};
+  std::chrono::steady_clock::time_point submit_time;
+  std::atomic<bool> started{false};
+  std::atomic<int64_t> queue_time_us{0};
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  std::exception_ptr first_error;
+};
+
+double KernelScheduler::BatchStats::utilization() const {
+  if (!wall_time_us || !worker_count) {
+    return 0;
+  }
+  return static_cast<double>(busy_time_us) / (wall_time_us * worker_count);
+}
+
+std::string KernelScheduler::BatchStats::toString() const {
+  std::ostringstream oss;
+  oss << kernel_count << " kernels, " << steal_count << " stolen, ";
+  if (off_node_count) {
+    oss << off_node_count << " off NUMA node, ";
+  }
+  oss << queue_time_us << " us queued, " << wall_time_us << " us wall, " << busy_time_us
+      << " us busy, " << static_cast<int>(utilization() * 100) << "% utilization of "
+      << worker_count << " cores";
+  return oss.str();
+}
+
+KernelScheduler& KernelScheduler::instance() {
+  static KernelScheduler scheduler(static_cast<size_t>(cpu_threads()));
+  return scheduler;
+}
+
+KernelScheduler::KernelScheduler(const size_t worker_count)
+    : worker_numa_nodes_(worker_count, -1) {
+  CHECK_GT(worker_count, size_t(0));
+  if (g_enable_numa_placement && numa::node_count() > 1) {
+    // Consecutive workers share a node, so the nearest neighbours are on the same node.
+    const auto& nodes = numa::nodes();
+    for (size_t i = 0; i < worker_count; ++i) {
+      const int node = nodes[i * nodes.size() / worker_count];
+      worker_numa_nodes_[i] = node;
+      auto& node_workers = numa_node_workers_[node];
+      if (!node_workers) {
+        node_workers = std::make_unique<NumaNodeWorkers>();
+      }
+      node_workers->worker_idxs.push_back(i);
+    }
+  }
+  for (size_t i = 0; i < worker_count; ++i) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+    // Neighbours on the same node first, then the others, both in cyclic order.
+    std::vector<size_t> steal_order;
+    for (const bool same_node : {true, false}) {
+      for (size_t j = 0; j < worker_count; ++j) {
+        const size_t queue_idx = (i + j) % worker_count;
+        if ((worker_numa_nodes_[queue_idx] == worker_numa_nodes_[i]) == same_node) {
+          steal_order.push_back(queue_idx);
+        }
+      }
+    }
+    steal_orders_.push_back(std::move(steal_order));
+  }
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this, i] {
+      const int node = worker_numa_nodes_[i];
+      if (node >= 0 && !numa::bind_current_thread(node)) {
+        LOG(WARNING) << "Could not bind kernel scheduler worker " << i
+                     << " to NUMA node " << node;
+      }
+      workerLoop(i);
+    });
+  }
+}
+
+KernelScheduler::~KernelScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(wakeup_mutex_);
+    shutdown_ = true;
+  }
+  wakeup_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+KernelScheduler::BatchStats KernelScheduler::run(
+    std::vector<std::function<void()>>&& tasks,
+    const std::vector<size_t>& weights,
+    const std::vector<int>& numa_nodes) {
+  CHECK_EQ(tasks.size(), weights.size());
+  CHECK(numa_nodes.empty() || numa_nodes.size() == tasks.size());
+  BatchStats stats;
+  stats.kernel_count = tasks.size();
+  if (tasks.empty()) {
+    return stats;
+  }
+  stats.worker_count = std::min(tasks.size(), workers_.size());
+
+  auto batch = std::make_shared<Batch>();
+  batch->pending_count = tasks.size();
+
+  // Longest processing time first: the heaviest kernels start immediately and the
+  // small ones fill in the gaps at the end of the batch.
+  std::vector<size_t> order(tasks.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&weights](const size_t a, const size_t b) {
+    return weights[a] > weights[b];
+  });
+
+  const auto clock_begin = timer_start();
+  batch->submit_time = clock_begin;
+  const size_t first_queue = next_queue_.fetch_add(tasks.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    const int numa_node = numa_nodes.empty() ? -1 : numa_nodes[order[i]];
+    auto& queue =
+        *queues_[getQueueIdx(numa_node, (first_queue + i) % queues_.size())];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(Task{std::move(tasks[order[i]]), batch, numa_node});
+  }
+  {
+    std::lock_guard<std::mutex> lock(wakeup_mutex_);
+    queued_task_count_ += order.size();
+  }
+  wakeup_cv_.notify_all();
+
+  {
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done_cv.wait(lock, [&batch] { return batch->pending_count == 0; });
+  }
+  stats.wall_time_us = timer_stop<std::chrono::steady_clock::time_point,
+                                  std::chrono::microseconds>(clock_begin);
+  stats.busy_time_us = batch->busy_time_us;
+  stats.steal_count = batch->steal_count;
+  stats.off_node_count = batch->off_node_count;
+  stats.queue_time_us = batch->queue_time_us;
+  if (batch->first_error) {
+    std::rethrow_exception(batch->first_error);
+  }
+  return stats;
+}
+
+size_t KernelScheduler::getQueueIdx(const int numa_node,
+                                    const size_t default_queue_idx) {
+  const auto it = numa_node_workers_.find(numa_node);
+  if (it == numa_node_workers_.end()) {
+    return default_queue_idx;
+  }
+  auto& node_workers = *it->second;
+  const auto& worker_idxs = node_workers.worker_idxs;
+  return worker_idxs[node_workers.next_worker++ % worker_idxs.size()];
+}
+
+void KernelScheduler::workerLoop(const size_t worker_idx) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(wakeup_mutex_);
+      wakeup_cv_.wait(lock, [this] { return shutdown_ || queued_task_count_ > 0; });
+      if (shutdown_) {
+        return;
+      }
+    }
+    Task task;
+    bool stolen = false;
+    if (popTask(worker_idx, task, stolen)) {
+      runTask(task, worker_idx, stolen);
+    }
+  }
+}
+
+bool KernelScheduler::popTask(const size_t worker_idx, Task& task, bool& stolen) {
+  // Take the oldest task from our own deque, otherwise steal the newest task from the
+  // first non-empty neighbour. Stealing from the back leaves the heavier kernels,
+  // which were pushed first, to their owners.
+  const auto& steal_order = steal_orders_[worker_idx];
+  for (size_t i = 0; i < steal_order.size(); ++i) {
+    const size_t queue_idx = steal_order[i];
+    auto& queue = *queues_[queue_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      stolen = true;
+    }
+    std::lock_guard<std::mutex> wakeup_lock(wakeup_mutex_);
+    CHECK_GT(queued_task_count_, size_t(0));
+    --queued_task_count_;
+    return true;
+  }
+  return false;
+}
+
+void KernelScheduler::runTask(Task& task, const size_t worker_idx, const bool stolen) {
+  auto& batch = *task.batch;
+  if (stolen) {
+    ++batch.steal_count;
+  }
+  const int worker_numa_node = worker_numa_nodes_[worker_idx];
+  if (task.numa_node >= 0 && worker_numa_node >= 0 &&
+      task.numa_node != worker_numa_node) {
+    ++batch.off_node_count;
+  }
+  if (!batch.started.exchange(true)) {
+    batch.queue_time_us = timer_stop<std::chrono::steady_clock::time_point,
+                                     std::chrono::microseconds>(batch.submit_time);
+  }
+  if (!batch.failed) {
+    const auto clock_begin = timer_start();
+    try {
+      task.func();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      if (!batch.first_error) {
+        batch.first_error = std::current_exception();
+      }
+      batch.failed = true;
+    }
+    batch.busy_time_us += timer_stop<std::chrono::steady_clock::time_point,
+                                     std::chrono::microseconds>(clock_begin);
+  }
+  // Release the task's captures before the submitter is woken up, they may reference
+  // state owned by the submitting thread.
+  task.func = nullptr;
+  std::shared_ptr<Batch> batch_owner = std::move(task.batch);
+  if (--batch.pending_count == 0) {
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    batch.done_cv.notify_all();
+  }
+}
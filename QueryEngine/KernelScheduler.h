@@ -0,0 +1,123 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    KernelScheduler.h
+ * @brief   Process-wide work-stealing scheduler for CPU execution kernels.
+ *
+ * Kernels are handed out to a fixed set of worker threads, one per core. Each worker
+ * owns a deque; a submitted batch is spread over the deques heaviest kernel first, and
+ * idle workers steal from their neighbours. Batches of concurrent queries are queued on
+ * the same deques, each run() only waits for its own batch. The executor splits large
+ * fragments into row range morsels before submitting them, so a single heavy fragment
+ * is spread over the cores as well.
+ *
+ * With NUMA placement enabled, the workers are split over the NUMA nodes and pinned to
+ * the cores of their node. A task with a preferred node is queued on a worker of that
+ * node, and idle workers steal from the workers of their own node first.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class KernelScheduler {
+ public:
+  struct BatchStats {
+    size_t kernel_count{0};
+    size_t steal_count{0};
+    // Kernels with a preferred NUMA node which ran on a worker of another node.
+    size_t off_node_count{0};
+    size_t worker_count{0};
+    int64_t wall_time_us{0};
+    int64_t busy_time_us{0};
+    // Time from submission until the first kernel of the batch started.
+    int64_t queue_time_us{0};
+
+    // Fraction of the available core time (wall time times the number of workers
+    // the batch could have occupied) spent running kernels.
+    double utilization() const;
+    std::string toString() const;
+  };
+
+  static KernelScheduler& instance();
+
+  // Workers are placed on the NUMA nodes according to g_enable_numa_placement at
+  // construction. Queries use the process-wide instance().
+  explicit KernelScheduler(const size_t worker_count);
+
+  ~KernelScheduler();
+
+  // Runs all tasks to completion and rethrows the first exception thrown by any of
+  // them. Tasks still queued once a task has failed are skipped. Weights are relative
+  // cost estimates (e.g. row counts) used to start the most expensive tasks first.
+  // NUMA nodes, if given, are the nodes holding the data of each task, -1 for none.
+  BatchStats run(std::vector<std::function<void()>>&& tasks,
+                 const std::vector<size_t>& weights,
+                 const std::vector<int>& numa_nodes = {});
+
+  size_t workerCount() const { return workers_.size(); }
+
+ private:
+  struct Batch;
+
+  struct Task {
+    std::function<void()> func;
+    std::shared_ptr<Batch> batch;
+    int numa_node;
+  };
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  struct NumaNodeWorkers {
+    std::vector<size_t> worker_idxs;
+    std::atomic<size_t> next_worker{0};
+  };
+
+  size_t getQueueIdx(const int numa_node, const size_t default_queue_idx);
+
+  void workerLoop(const size_t worker_idx);
+  bool popTask(const size_t worker_idx, Task& task, bool& stolen);
+  void runTask(Task& task, const size_t worker_idx, const bool stolen);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  // NUMA node of each worker, -1 without NUMA placement.
+  std::vector<int> worker_numa_nodes_;
+  // Queues in the order a worker visits them, its own queue first.
+  std::vector<std::vector<size_t>> steal_orders_;
+  std::unordered_map<int, std::unique_ptr<NumaNodeWorkers>> numa_node_workers_;
+
+  std::mutex wakeup_mutex_;
+  std::condition_variable wakeup_cv_;
+  size_t queued_task_count_{0};
+  bool shutdown_{false};
+
+  std::atomic<size_t> next_queue_{0};
+};
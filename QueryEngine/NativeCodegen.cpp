@@ -21,6 +21,7 @@
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
 #include "QueryTemplateGenerator.h"
+#include "RuntimeFunctions.h"
 
 #include "OSDependent/omnisci_path.h"
 #include "Shared/MathUtils.h"
@@ -30,6 +31,7 @@
 static_assert(false, "LLVM Version >= 9 is required.");
 #endif
 
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
@@ -51,6 +53,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
@@ -62,11 +65,20 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
 #endif
 
 float g_fraction_code_cache_to_evict = 0.2;
+bool g_enable_tiered_compilation{false};
+size_t g_tiered_compilation_hot_count{3};
+bool g_enable_batch_filters{false};
 
 std::unique_ptr<llvm::Module> udf_gpu_module;
 std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -236,6 +248,106 @@ void optimize_ir(llvm::Function* query_func,
 }
 #endif
 
+// The pipeline of the optimizing tier. Everything but the entry point is internalized
+// first, so that the unused runtime functions are gone before the expensive passes run.
+void optimize_ir_aggressive(llvm::Module* module,
+                            const std::string& entry_name,
+                            llvm::TargetMachine* target_machine) {
+  llvm::legacy::PassManager internalize_pass_manager;
+  internalize_pass_manager.add(
+      llvm::createInternalizePass([&entry_name](const llvm::GlobalValue& gv) {
+        return gv.getName() == entry_name;
+      }));
+  internalize_pass_manager.add(llvm::createGlobalDCEPass());
+  internalize_pass_manager.run(*module);
+
+  llvm::PassManagerBuilder pass_manager_builder;
+  pass_manager_builder.OptLevel = 3;
+  pass_manager_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+  pass_manager_builder.LoopVectorize = true;
+  pass_manager_builder.SLPVectorize = true;
+  target_machine->adjustPassManager(pass_manager_builder);
+
+  // without the target's cost model the vectorizers don't know the vector width
+  llvm::legacy::FunctionPassManager function_pass_manager(module);
+  function_pass_manager.add(
+      llvm::createTargetTransformInfoWrapperPass(target_machine->getTargetIRAnalysis()));
+  pass_manager_builder.populateFunctionPassManager(function_pass_manager);
+  function_pass_manager.doInitialization();
+  for (auto& func : *module) {
+    function_pass_manager.run(func);
+  }
+  function_pass_manager.doFinalization();
+
+  llvm::legacy::PassManager module_pass_manager;
+  module_pass_manager.add(
+      llvm::createTargetTransformInfoWrapperPass(target_machine->getTargetIRAnalysis()));
+  pass_manager_builder.populateModulePassManager(module_pass_manager);
+  module_pass_manager.run(*module);
+}
+
+// Runs the compilations of the optimizing tier one at a time on a background thread, so
+// that they neither delay queries nor compete with each other for the CPU.
+class TierUpQueue {
+ public:
+  static TierUpQueue& instance() {
+    static TierUpQueue queue;
+    return queue;
+  }
+
+  // Returns false if too many compilations are pending already.
+  bool submit(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.size() >= kMaxPendingTasks) {
+      return false;
+    }
+    if (!worker_.joinable()) {
+      worker_ = std::thread([this] { run(); });
+    }
+    tasks_.push_back(std::move(task));
+    cv_.notify_one();
+    return true;
+  }
+
+  ~TierUpQueue() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      tasks_.clear();
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+ private:
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  // every pending task holds the bitcode of a query module
+  static constexpr size_t kMaxPendingTasks{16};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_{false};
+  std::thread worker_;
+};
+
 }  // namespace
 
 ExecutionEngineWrapper::ExecutionEngineWrapper() {}
@@ -325,12 +437,15 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    DiskCodeCache::ModuleEntry* disk_cache_entry) {
   auto module = func->getParent();
-  // run optimizations
+  // run optimizations, unless the optimized object is going to be loaded from disk
 #ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  optimize_ir(func, module, pass_manager, live_funcs, co);
+  if (!disk_cache_entry || !disk_cache_entry->hasObject()) {
+    llvm::legacy::PassManager pass_manager;
+    optimize_ir(func, module, pass_manager, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -356,11 +471,136 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   CHECK(execution_engine.get());
   LOG(ASM) << assemblyForCPU(execution_engine, module);
 
+  if (disk_cache_entry) {
+    execution_engine->setObjectCache(disk_cache_entry);
+  }
   execution_engine->finalizeObject();
+  if (disk_cache_entry) {
+    execution_engine->setObjectCache(nullptr);
+  }
 
   return execution_engine;
 }
 
+void CodeGenerator::tierUpCPUCode(const std::string& bitcode,
+                                  const std::string& entry_name,
+                                  const std::vector<std::string>& live_func_names,
+                                  const CompilationOptions& co,
+                                  CpuCompilationContext& cpu_compilation_context) {
+  auto timer = DEBUG_TIMER(__func__);
+  auto context = std::make_unique<llvm::LLVMContext>();
+  auto buffer = llvm::MemoryBuffer::getMemBuffer(bitcode, "", false);
+  auto module_or_err = llvm::parseBitcodeFile(buffer->getMemBufferRef(), *context);
+  if (!module_or_err) {
+    throw std::runtime_error("Could not read the bitcode of the query module: " +
+                             llvm::toString(module_or_err.takeError()));
+  }
+  auto module = module_or_err->get();
+  auto entry_func = module->getFunction(entry_name);
+  CHECK(entry_func);
+
+  llvm::StringMap<bool> host_features;
+  std::vector<std::string> host_attrs;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    for (const auto& feature : host_features) {
+      host_attrs.push_back((feature.second ? "+" : "-") + feature.first().str());
+    }
+  }
+  std::string err_str;
+  llvm::EngineBuilder eb(std::move(*module_or_err));
+  eb.setErrorStr(&err_str);
+  eb.setEngineKind(llvm::EngineKind::JIT);
+  eb.setMCPU(llvm::sys::getHostCPUName());
+  eb.setMAttrs(host_attrs);
+  eb.setOptLevel(llvm::CodeGenOpt::Aggressive);
+  auto target_machine = eb.selectTarget();
+  if (!target_machine) {
+    throw std::runtime_error("Could not create the host target machine: " + err_str);
+  }
+
+#ifndef WITH_JIT_DEBUG
+  // the baseline passes first, they inline the always_inline runtime functions
+  std::unordered_set<llvm::Function*> live_funcs;
+  for (const auto& name : live_func_names) {
+    if (auto func = module->getFunction(name)) {
+      live_funcs.insert(func);
+    }
+  }
+  llvm::legacy::PassManager pass_manager;
+  optimize_ir(entry_func, module, pass_manager, live_funcs, co);
+  module->setDataLayout(target_machine->createDataLayout());
+  optimize_ir_aggressive(module, entry_name, target_machine);
+#endif  // WITH_JIT_DEBUG
+
+  ExecutionEngineWrapper execution_engine(eb.create(target_machine), co);
+  if (!execution_engine.get()) {
+    throw std::runtime_error("Could not create the execution engine: " + err_str);
+  }
+  execution_engine->finalizeObject();
+  auto func = execution_engine->getPointerToFunction(module->getFunction(entry_name));
+  cpu_compilation_context.setOptimizedCode(
+      std::move(context), std::move(execution_engine), func);
+}
+
+void Executor::requestTierUp(const CodeCacheKey& key,
+                             llvm::Function* multifrag_query_func,
+                             const std::unordered_set<llvm::Function*>& live_funcs,
+                             const CompilationOptions& co) {
+  auto it = cpu_code_cache_.find(key);
+  if (it == cpu_code_cache_.cend()) {
+    return;
+  }
+  auto cpu_compilation_context =
+      std::dynamic_pointer_cast<CpuCompilationContext>(it->second.first);
+  CHECK(cpu_compilation_context);
+  if (!cpu_compilation_context->recordCacheHit(g_tiered_compilation_hot_count)) {
+    return;
+  }
+  // Like the persistent cache, leave code linked against UDFs or GEOS alone: that isn't
+  // linked into the module yet at this point.
+  if (cgen_state_->needs_geos_ || is_udf_module_present(true) ||
+      is_rt_udf_module_present(true)) {
+    cpu_compilation_context->setTierUpRequested();
+    return;
+  }
+
+  // The module generated for this execution is the same query as the cached code. The
+  // cache hit drops it, hand it to the optimizing tier first. As bitcode, since the
+  // background thread can't share the LLVM context of the executor.
+  std::string bitcode;
+  llvm::raw_string_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(*multifrag_query_func->getParent(), os);
+  os.flush();
+  std::vector<std::string> live_func_names;
+  for (const auto func : live_funcs) {
+    live_func_names.push_back(func->getName().str());
+  }
+  std::weak_ptr<CpuCompilationContext> weak_context = cpu_compilation_context;
+  const bool submitted = TierUpQueue::instance().submit(
+      [bitcode = std::move(bitcode),
+       entry_name = multifrag_query_func->getName().str(),
+       live_func_names = std::move(live_func_names),
+       co,
+       weak_context] {
+        auto cpu_compilation_context = weak_context.lock();
+        if (!cpu_compilation_context) {
+          // evicted from the code cache meanwhile
+          return;
+        }
+        try {
+          CodeGenerator::tierUpCPUCode(
+              bitcode, entry_name, live_func_names, co, *cpu_compilation_context);
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Optimizing tier compilation failed, keeping the baseline "
+                          "code: "
+                       << e.what();
+        }
+      });
+  if (submitted) {
+    cpu_compilation_context->setTierUpRequested();
+  }
+}
+
 std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     llvm::Function* query_func,
     llvm::Function* multifrag_query_func,
@@ -375,6 +615,9 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   for (const auto helper : cgen_state_->helper_functions_) {
     key.push_back(serialize_llvm_object(helper));
   }
+  if (g_enable_tiered_compilation) {
+    requestTierUp(key, multifrag_query_func, live_funcs, co);
+  }
   auto cached_code = getCodeFromCache(key, cpu_code_cache_);
   if (cached_code) {
     return cached_code;
@@ -405,8 +648,20 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  // Code linked against UDFs or the GEOS library depends on more than the runtime
+  // functions the persistent cache is versioned by, keep it in memory only. So is the
+  // unoptimized code of JIT debug builds.
+  std::unique_ptr<DiskCodeCache::ModuleEntry> disk_cache_entry;
+#ifndef WITH_JIT_DEBUG
+  auto disk_code_cache = DiskCodeCache::get();
+  if (disk_code_cache && !cgen_state_->needs_geos_ && !is_udf_module_present(true) &&
+      !is_rt_udf_module_present(true)) {
+    disk_cache_entry = disk_code_cache->prepareModule(module, key);
+  }
+#endif  // WITH_JIT_DEBUG
+
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, disk_cache_entry.get());
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
@@ -1173,7 +1428,11 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
-         func->getName() == "record_error_code" || func->getName() == "get_error_code";
+         func->getName() == "run_length_decode" ||
+         func->getName() == "frame_of_reference_decode" ||
+         func->getName() == "record_error_code" || func->getName() == "get_error_code" ||
+         func->getName() == "batch_filter_first_row" ||
+         func->getName() == "batch_filter_next_row";
 }
 
 llvm::Module* read_template_module(llvm::LLVMContext& context) {
@@ -1889,6 +2148,63 @@ void Executor::createErrorCheckControlFlow(
   CHECK(done_splitting);
 }
 
+void Executor::insertBatchFilter(llvm::Function* query_func,
+                                 llvm::Function* batch_filter_func,
+                                 const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+  auto row_count =
+      find_variable_in_basic_block<llvm::LoadInst>(query_func, ".entry", "row_count");
+  CHECK(row_count);
+  auto pos = find_variable_in_basic_block<llvm::PHINode>(query_func, "", "pos");
+  CHECK(pos);
+  // The scan loop starts at pos_start, coming from the preheader, and increments pos by
+  // pos_step everywhere else. Start at the first selected row and go to the next one
+  // instead.
+  auto pos_phi = llvm::cast<llvm::PHINode>(pos);
+  llvm::Instruction* pos_start{nullptr};
+  llvm::Instruction* pos_inc{nullptr};
+  for (unsigned i = 0; i < pos_phi->getNumIncomingValues(); ++i) {
+    auto incoming = llvm::cast<llvm::Instruction>(pos_phi->getIncomingValue(i));
+    if (pos_phi->getIncomingBlock(i)->getName() == ".loop.preheader") {
+      pos_start = incoming;
+    } else {
+      CHECK(!pos_inc || pos_inc == incoming);
+      pos_inc = incoming;
+    }
+  }
+  CHECK(pos_start && pos_start->getParent() == &query_func->getEntryBlock());
+  CHECK(pos_inc && pos_inc->getOpcode() == llvm::Instruction::Add);
+  CHECK(pos_inc->getOperand(0) == pos);
+
+  auto& context = cgen_state_->context_;
+  llvm::IRBuilder<> ir_builder(&*query_func->getEntryBlock().getFirstInsertionPt());
+  auto sel = ir_builder.CreateAlloca(
+      get_int_type(32, context), cgen_state_->llInt(BATCH_FILTER_BLOCK_SIZE), "sel");
+  auto state = ir_builder.CreateAlloca(
+      get_int_type(64, context), cgen_state_->llInt(int32_t(4)), "batch_filter_state");
+  const auto col_buffers = get_arg_by_name(query_func, "byte_stream");
+  // without hoisting, the literals are embedded in the batch filter
+  llvm::Value* literals =
+      co.hoist_literals
+          ? get_arg_by_name(query_func, "literals")
+          : llvm::ConstantPointerNull::get(
+                llvm::PointerType::get(get_int_type(8, context), 0));
+
+  ir_builder.SetInsertPoint(pos_start->getNextNode());
+  auto first_row = ir_builder.CreateCall(
+      cgen_state_->module_->getFunction("batch_filter_first_row"),
+      {state, sel, pos_start, row_count, col_buffers, literals, batch_filter_func});
+  pos_start->replaceAllUsesWith(first_row);
+  first_row->setArgOperand(2, pos_start);
+
+  ir_builder.SetInsertPoint(pos_inc);
+  auto next_row = ir_builder.CreateCall(
+      cgen_state_->module_->getFunction("batch_filter_next_row"),
+      {state, sel, row_count, col_buffers, literals, batch_filter_func});
+  pos_inc->replaceAllUsesWith(next_row);
+  pos_inc->eraseFromParent();
+}
+
 std::vector<llvm::Value*> Executor::inlineHoistedLiterals() {
   AUTOMATIC_IR_METADATA(cgen_state_.get());
 
@@ -2478,6 +2794,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
 
   preloadFragOffsets(ra_exe_unit.input_descs, query_infos);
   RelAlgExecutionUnit body_execution_unit = ra_exe_unit;
+  llvm::Function* batch_filter_func{nullptr};
   const auto join_loops =
       buildJoinLoops(body_execution_unit, co, eo, query_infos, column_cache);
 
@@ -2496,8 +2813,24 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                      co,
                      eo);
   } else {
-    const bool can_return_error = compileBody(
-        ra_exe_unit, group_by_and_aggregate, *query_mem_desc, co, gpu_smem_context);
+    RelAlgExecutionUnit row_execution_unit = ra_exe_unit;
+    // The dynamic watchdog and the interrupt check look at every 64th row position, which
+    // the selection could skip.
+    if ((co.batch_filters || g_enable_batch_filters) &&
+        co.device_type == ExecutorDeviceType::CPU && !eo.with_dynamic_watchdog &&
+        !eo.allow_runtime_query_interrupt) {
+      batch_filter_func = codegenBatchFilter(row_execution_unit, co);
+    }
+    const bool can_return_error = compileBody(row_execution_unit,
+                                              group_by_and_aggregate,
+                                              *query_mem_desc,
+                                              co,
+                                              gpu_smem_context);
+    if (batch_filter_func) {
+      insertBatchFilter(query_func, batch_filter_func, co);
+      // the filter is part of the code cache key, like the other helpers
+      cgen_state_->helper_functions_.push_back(batch_filter_func);
+    }
     if (can_return_error || cgen_state_->needs_error_check_ || eo.with_dynamic_watchdog ||
         eo.allow_runtime_query_interrupt) {
       createErrorCheckControlFlow(query_func,
@@ -2595,6 +2928,9 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   if (cgen_state_->filter_func_) {
     root_funcs.push_back(cgen_state_->filter_func_);
   }
+  if (batch_filter_func) {
+    root_funcs.push_back(batch_filter_func);
+  }
   auto live_funcs = CodeGenerator::markDeadRuntimeFuncs(
       *cgen_state_->module_, root_funcs, {multifrag_query_func});
 
@@ -2630,7 +2966,8 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
         serialize_llvm_object(multifrag_query_func) + serialize_llvm_object(query_func) +
         serialize_llvm_object(cgen_state_->row_func_) +
         (cgen_state_->filter_func_ ? serialize_llvm_object(cgen_state_->filter_func_)
-                                   : "");
+                                   : "") +
+        (batch_filter_func ? serialize_llvm_object(batch_filter_func) : "");
 
 #ifndef NDEBUG
     llvm_ir += serialize_llvm_metadata_footnotes(query_func, cgen_state_.get());
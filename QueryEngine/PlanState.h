@@ -63,6 +63,9 @@ struct PlanState {
   const DeletedColumnsMap deleted_columns_;
   const std::vector<InputTableInfo>& query_infos_;
   const Executor* executor_;
+  // dictionary ids of the string literals probed in the chunk value sketches, resolved
+  // once for all the fragments
+  std::unordered_map<const Analyzer::Constant*, int32_t> sketch_string_ids_;
 
   void allocateLocalColumnIds(
       const std::list<std::shared_ptr<const InputColDescriptor>>& global_col_ids);
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryDispatchQueue.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+#include "Shared/StringTransform.h"
+
+std::string g_query_priority_high_users;
+std::string g_query_priority_low_users;
+size_t g_dispatch_short_query_rows{0};
+size_t g_dispatch_priority_aging_ms{10000};
+bool g_enable_dispatch_admission_control{false};
+
+namespace {
+
+int64_t elapsed_ms(const QueryDispatchQueue::Clock::time_point begin,
+                   const QueryDispatchQueue::Clock::time_point end) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+}
+
+bool is_listed(const std::string& user_name, const std::string& user_list) {
+  for (const auto& listed_user : split(user_list, ",")) {
+    if (strip(listed_user) == user_name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void QueryDispatchQueue::LatencyHistogram::add(const int64_t duration_ms) {
+  const auto it = std::lower_bound(
+      kBucketUpperBoundsMs.begin(), kBucketUpperBoundsMs.end(), duration_ms);
+  ++counts[it - kBucketUpperBoundsMs.begin()];
+}
+
+size_t QueryDispatchQueue::LatencyHistogram::count() const {
+  size_t count{0};
+  for (const auto bucket_count : counts) {
+    count += bucket_count;
+  }
+  return count;
+}
+
+size_t QueryDispatchQueue::Stats::queuedCount() const {
+  size_t queued_count{0};
+  for (const auto& class_stats : classes) {
+    queued_count += class_stats.queued_count;
+  }
+  return queued_count;
+}
+
+QueryDispatchQueue::QueryDispatchQueue(const size_t parallel_executors_max)
+    : normal_worker_count_(parallel_executors_max) {
+  for (size_t i = 0; i < normal_worker_count_; i++) {
+    // worker IDs are 1-indexed, leaving Executor 0 for non-dispatch queue worker tasks
+    workers_.emplace_back(&QueryDispatchQueue::worker, this, i + 1, false);
+  }
+  if (g_dispatch_short_query_rows > 0) {
+    // Executor 2 runs the update and delete queries of a single worker queue.
+    const size_t fast_lane_worker_idx = std::max(normal_worker_count_, size_t(2)) + 1;
+    workers_.emplace_back(&QueryDispatchQueue::worker, this, fast_lane_worker_idx, true);
+  }
+}
+
+QueryDispatchQueue::~QueryDispatchQueue() {
+  {
+    std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+    threads_should_exit_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void QueryDispatchQueue::submit(std::shared_ptr<Task> task,
+                                const bool is_update_delete,
+                                const TaskInfo& info) {
+  CHECK(task);
+  if (normal_worker_count_ == 1 && is_update_delete) {
+    std::lock_guard<decltype(update_delete_mutex_)> update_delete_lock(
+        update_delete_mutex_);
+    // We only have 1 worker. Run this task on the calling thread on a special, second
+    // worker. The task is under the update delete lock, so we don't have to worry about
+    // contention on the special worker. This protects against deadlocks should the
+    // query running (or any pending queries) hold a read lock on something that
+    // requires a write lock during update/delete.
+    (*task)(2);
+    return;
+  }
+  QueuedTask queued_task;
+  queued_task.task = std::move(task);
+  queued_task.info = info;
+  queued_task.submit_time = Clock::now();
+  queued_task.fast_lane = g_dispatch_short_query_rows > 0 && !is_update_delete &&
+                          info.has_estimate &&
+                          info.estimated_rows <= g_dispatch_short_query_rows;
+
+  std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
+  auto& queue = queues_[static_cast<size_t>(info.priority)];
+  LOG(INFO) << "Dispatching " << toString(info.priority) << " priority query"
+            << (queued_task.fast_lane ? " to the fast lane" : "") << " with "
+            << queue.size() << " queries of the same priority in the queue.";
+  queue.push_back(std::move(queued_task));
+  lock.unlock();
+  cv_.notify_all();
+}
+
+void QueryDispatchQueue::submit(std::shared_ptr<Task> task,
+                                const bool is_update_delete) {
+  submit(std::move(task), is_update_delete, TaskInfo());
+}
+
+void QueryDispatchQueue::setMemoryBudget(const size_t budget_bytes) {
+  {
+    std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+    memory_budget_bytes_ = budget_bytes;
+  }
+  cv_.notify_all();
+}
+
+QueryDispatchQueue::Stats QueryDispatchQueue::getStats() const {
+  std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
+  auto stats = stats_;
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    stats.classes[i].queued_count = queues_[i].size();
+  }
+  stats.running_count = running_count_;
+  stats.reserved_bytes = reserved_bytes_;
+  stats.memory_budget_bytes = memory_budget_bytes_;
+  return stats;
+}
+
+QueryDispatchQueue::Priority QueryDispatchQueue::getUserPriority(
+    const std::string& user_name) {
+  if (is_listed(user_name, g_query_priority_high_users)) {
+    return Priority::HIGH;
+  }
+  if (is_listed(user_name, g_query_priority_low_users)) {
+    return Priority::LOW;
+  }
+  return Priority::NORMAL;
+}
+
+std::string QueryDispatchQueue::toString(const Priority priority) {
+  switch (priority) {
+    case Priority::HIGH:
+      return "high";
+    case Priority::NORMAL:
+      return "normal";
+    case Priority::LOW:
+      return "low";
+  }
+  UNREACHABLE();
+  return "";
+}
+
+void QueryDispatchQueue::worker(const size_t worker_idx, const bool fast_lane) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    std::pair<int, size_t> next{-1, 0};
+    cv_.wait(lock, [this, fast_lane, &next] {
+      if (threads_should_exit_) {
+        return true;
+      }
+      next = pickTask(fast_lane, Clock::now());
+      return next.first >= 0;
+    });
+
+    if (threads_should_exit_) {
+      return;
+    }
+
+    auto& queue = queues_[next.first];
+    auto queued_task = std::move(queue[next.second]);
+    queue.erase(queue.begin() + next.second);
+    const auto reservation = getReservation(queued_task);
+    reserved_bytes_ += reservation;
+    ++running_count_;
+    auto& class_stats = stats_.classes[static_cast<size_t>(queued_task.info.priority)];
+    class_stats.wait_time_ms.add(elapsed_ms(queued_task.submit_time, Clock::now()));
+    if (fast_lane) {
+      ++stats_.fast_lane_count;
+    }
+
+    LOG(INFO) << "Worker " << worker_idx << (fast_lane ? " (fast lane)" : "")
+              << " running " << toString(queued_task.info.priority)
+              << " priority query and returning control. There are now "
+              << queue.size() << " queries of the same priority in the queue.";
+    // allow other threads to pick up tasks
+    lock.unlock();
+    (*queued_task.task)(worker_idx);
+    queued_task.task.reset();
+
+    lock.lock();
+    reserved_bytes_ -= reservation;
+    --running_count_;
+    ++class_stats.executed_count;
+    class_stats.latency_ms.add(elapsed_ms(queued_task.submit_time, Clock::now()));
+    if (reservation > 0) {
+      // queries waiting for admission may fit now
+      cv_.notify_all();
+    }
+  }
+}
+
+std::pair<int, size_t> QueryDispatchQueue::pickTask(const bool fast_lane,
+                                                    const Clock::time_point now) {
+  int best_queue{-1};
+  size_t best_pos{0};
+  int64_t best_priority{0};
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    const auto& queue = queues_[i];
+    // The fast lane worker only runs short queries, the others start the queries in
+    // the order of their class.
+    size_t pos{0};
+    while (fast_lane && pos < queue.size() && !queue[pos].fast_lane) {
+      ++pos;
+    }
+    if (pos >= queue.size()) {
+      continue;
+    }
+    const auto& candidate = queue[pos];
+    int64_t priority = static_cast<int64_t>(i);
+    if (g_dispatch_priority_aging_ms > 0) {
+      const auto promotion = elapsed_ms(candidate.submit_time, now) /
+                             static_cast<int64_t>(g_dispatch_priority_aging_ms);
+      priority = std::max(priority - promotion, int64_t(0));
+    }
+    if (best_queue < 0 || priority < best_priority ||
+        (priority == best_priority &&
+         candidate.submit_time < queues_[best_queue][best_pos].submit_time)) {
+      best_queue = static_cast<int>(i);
+      best_pos = pos;
+      best_priority = priority;
+    }
+  }
+  if (best_queue < 0) {
+    return {-1, 0};
+  }
+  auto& best = queues_[best_queue][best_pos];
+  if (!isAdmissible(best)) {
+    // Don't let smaller queries overtake it, it would never run on a busy server.
+    if (!best.admission_waited) {
+      best.admission_waited = true;
+      ++stats_.admission_wait_count;
+    }
+    return {-1, 0};
+  }
+  return {best_queue, best_pos};
+}
+
+bool QueryDispatchQueue::isAdmissible(const QueuedTask& queued_task) const {
+  return reserved_bytes_ == 0 ||
+         reserved_bytes_ + getReservation(queued_task) <= memory_budget_bytes_;
+}
+
+size_t QueryDispatchQueue::getReservation(const QueuedTask& queued_task) const {
+  if (!g_enable_dispatch_admission_control || memory_budget_bytes_ == 0 ||
+      queued_task.fast_lane || !queued_task.info.has_estimate) {
+    return 0;
+  }
+  return std::min(queued_task.info.estimated_bytes, memory_budget_bytes_);
+}
@@ -16,99 +16,142 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
+
+extern std::string g_query_priority_high_users;
+extern std::string g_query_priority_low_users;
+extern size_t g_dispatch_short_query_rows;
+extern size_t g_dispatch_priority_aging_ms;
+extern bool g_enable_dispatch_admission_control;
 
 /**
  * QueryDispatchQueue maintains a list of pending queries and dispatches those queries as
- * Executors become available
+ * Executors become available.
+ *
+ * Queries are queued per priority class and the workers always take the oldest query of
+ * the most important class, a query being promoted by one class for every
+ * g_dispatch_priority_aging_ms it has waited so that low priority queries still make
+ * progress. Queries estimated to scan at most g_dispatch_short_query_rows rows also go
+ * to a fast lane with a worker (and Executor) of its own, so that short dashboard
+ * queries don't wait for a long running analytic query to finish.
+ *
+ * With admission control enabled, a query is only started once its estimated memory fits
+ * into what is left of the memory budget (the CPU buffer pool) after the reservations of
+ * the running queries. A query is always admitted when nothing else runs, however large
+ * its estimate.
  */
 class QueryDispatchQueue {
  public:
   using Task = std::packaged_task<void(size_t)>;
+  using Clock = std::chrono::steady_clock;
+
+  enum class Priority { HIGH = 0, NORMAL, LOW };
+  static constexpr size_t kPriorityCount{3};
+
+  struct TaskInfo {
+    Priority priority{Priority::NORMAL};
+    // Input size of the query from the table metadata, if known.
+    bool has_estimate{false};
+    size_t estimated_rows{0};
+    size_t estimated_bytes{0};
+  };
+
+  // Counts of durations in milliseconds, bucket i counting those up to
+  // kBucketUpperBoundsMs[i] and the last bucket everything longer.
+  struct LatencyHistogram {
+    static constexpr std::array<int64_t, 7> kBucketUpperBoundsMs{
+        {1, 10, 100, 1000, 10000, 60000, 600000}};
+
+    std::array<size_t, kBucketUpperBoundsMs.size() + 1> counts{};
+
+    void add(const int64_t duration_ms);
+    size_t count() const;
+  };
+
+  struct ClassStats {
+    size_t queued_count{0};
+    size_t executed_count{0};
+    // Time from submission until a worker started the query.
+    LatencyHistogram wait_time_ms;
+    // Time from submission until the query finished.
+    LatencyHistogram latency_ms;
+  };
+
+  struct Stats {
+    std::array<ClassStats, kPriorityCount> classes;
+    size_t running_count{0};
+    size_t fast_lane_count{0};
+    // Queries which had to wait for running queries to release their reservations.
+    size_t admission_wait_count{0};
+    size_t reserved_bytes{0};
+    size_t memory_budget_bytes{0};
+
+    size_t queuedCount() const;
+  };
 
-  QueryDispatchQueue(const size_t parallel_executors_max) {
-    workers_.resize(parallel_executors_max);
-    for (size_t i = 0; i < workers_.size(); i++) {
-      // worker IDs are 1-indexed, leaving Executor 0 for non-dispatch queue worker tasks
-      workers_[i] = std::thread(&QueryDispatchQueue::worker, this, i + 1);
-    }
-  }
+  QueryDispatchQueue(const size_t parallel_executors_max);
+
+  ~QueryDispatchQueue();
 
   /**
-   * Submit a new task to the queue. Blocks until the task begins execution. The caller is
+   * Submit a new task to the queue. Returns once the task is queued. The caller is
    * expected to maintain a copy of the shared_ptr which will be used to access results
    * once the task runs.
    */
-  void submit(std::shared_ptr<Task> task, const bool is_update_delete) {
-    if (workers_.size() == 1 && is_update_delete) {
-      std::lock_guard<decltype(update_delete_mutex_)> update_delete_lock(
-          update_delete_mutex_);
-      CHECK(task);
-      // We only have 1 worker. Run this task on the calling thread on a special, second
-      // worker. The task is under the update delete lock, so we don't have to worry about
-      // contention on the special worker. This protects against deadlocks should the
-      // query running (or any pending queries) hold a read lock on something that
-      // requires a write lock during update/delete.
-      (*task)(2);
-      return;
-    }
-    std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
-
-    LOG(INFO) << "Dispatching query with " << queue_.size() << " queries in the queue.";
-    queue_.push(task);
-    lock.unlock();
-    cv_.notify_all();
-  }
-
-  ~QueryDispatchQueue() {
-    {
-      std::lock_guard<decltype(queue_mutex_)> lock(queue_mutex_);
-      threads_should_exit_ = true;
-    }
-    cv_.notify_all();
-    for (auto& worker : workers_) {
-      worker.join();
-    }
-  }
+  void submit(std::shared_ptr<Task> task,
+              const bool is_update_delete,
+              const TaskInfo& info);
+
+  void submit(std::shared_ptr<Task> task, const bool is_update_delete);
+
+  // Sets the memory admission control is checked against, usually the size of the CPU
+  // buffer pool. Admission control is off while the budget is 0.
+  void setMemoryBudget(const size_t budget_bytes);
+
+  Stats getStats() const;
+
+  static Priority getUserPriority(const std::string& user_name);
+
+  static std::string toString(const Priority priority);
 
  private:
-  void worker(const size_t worker_idx) {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    while (true) {
-      cv_.wait(lock, [this] { return !queue_.empty() || threads_should_exit_; });
-
-      if (threads_should_exit_) {
-        return;
-      }
-
-      if (!queue_.empty()) {
-        auto task = queue_.front();
-        queue_.pop();
-
-        LOG(INFO) << "Worker " << worker_idx
-                  << " running query and returning control. There are now "
-                  << queue_.size() << " queries in the queue.";
-        // allow other threads to pick up tasks
-        lock.unlock();
-        CHECK(task);
-        (*task)(worker_idx);
-
-        // wait for signal
-        lock.lock();
-      }
-    }
-  }
-
-  std::mutex queue_mutex_;
+  struct QueuedTask {
+    std::shared_ptr<Task> task;
+    TaskInfo info;
+    Clock::time_point submit_time;
+    bool fast_lane{false};
+    bool admission_waited{false};
+  };
+
+  void worker(const size_t worker_idx, const bool fast_lane);
+
+  // Queue and position of the task the worker should run next, or a queue of -1 if
+  // there is none it may start now.
+  std::pair<int, size_t> pickTask(const bool fast_lane, const Clock::time_point now);
+  bool isAdmissible(const QueuedTask& queued_task) const;
+  size_t getReservation(const QueuedTask& queued_task) const;
+
+  mutable std::mutex queue_mutex_;
   std::condition_variable cv_;
 
   std::mutex update_delete_mutex_;
 
   bool threads_should_exit_{false};
-  std::queue<std::shared_ptr<Task>> queue_;
+  std::array<std::deque<QueuedTask>, kPriorityCount> queues_;
   std::vector<std::thread> workers_;
+  size_t normal_worker_count_{0};
+
+  size_t memory_budget_bytes_{0};
+  size_t reserved_bytes_{0};
+  size_t running_count_{0};
+  Stats stats_;
 };
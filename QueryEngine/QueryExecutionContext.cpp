@@ -614,9 +614,10 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     flatened_frag_offsets.insert(
         flatened_frag_offsets.end(), offsets.begin(), offsets.end());
   }
-  int64_t rowid_lookup_num_rows{*error_code ? *error_code + 1 : 0};
-  auto num_rows_ptr =
-      rowid_lookup_num_rows ? &rowid_lookup_num_rows : &flatened_num_rows[0];
+  // Rowid lookups and morsels scan a row range of the outer fragment: its first row is
+  // passed in the error code, its end is already the outer row count.
+  const bool scans_row_range{*error_code != 0};
+  auto num_rows_ptr = &flatened_num_rows[0];
   int32_t total_matched_init{0};
 
   std::vector<int64_t> cmpt_val_buff;
@@ -717,7 +718,7 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     return {};
   }
 
-  if (rowid_lookup_num_rows && *error_code < 0) {
+  if (scans_row_range && *error_code < 0) {
     *error_code = 0;
   }
 
@@ -19,6 +19,7 @@
 
 struct QueryHint {
   bool cpu_mode{false};
+  bool batch_filters{false};
 };
 
 #endif  // OMNISCI_QUERYHINT_H
@@ -655,9 +655,7 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
 }
 
 int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
-  auto count_distinct_set = new std::set<int64_t>();
-  row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
-  return reinterpret_cast<int64_t>(count_distinct_set);
+  return reinterpret_cast<int64_t>(row_set_mem_owner_->makeCountDistinctSet());
 }
 
 #ifdef HAVE_CUDA
@@ -1204,35 +1204,53 @@ void handleQueryHint(const std::vector<std::shared_ptr<RelAlgNode>>& nodes,
       if (agg_node->hasHintEnabled("cpu_mode")) {
         query_hints.cpu_mode = true;
       }
+      if (agg_node->hasHintEnabled("batch_filters")) {
+        query_hints.batch_filters = true;
+      }
     }
     const auto project_node = std::dynamic_pointer_cast<RelProject>(node);
     if (project_node) {
       if (project_node->hasHintEnabled("cpu_mode")) {
         query_hints.cpu_mode = true;
       }
+      if (project_node->hasHintEnabled("batch_filters")) {
+        query_hints.batch_filters = true;
+      }
     }
     const auto scan_node = std::dynamic_pointer_cast<RelScan>(node);
     if (scan_node) {
       if (scan_node->hasHintEnabled("cpu_mode")) {
         query_hints.cpu_mode = true;
       }
+      if (scan_node->hasHintEnabled("batch_filters")) {
+        query_hints.batch_filters = true;
+      }
     }
     const auto join_node = std::dynamic_pointer_cast<RelJoin>(node);
     if (join_node) {
       if (join_node->hasHintEnabled("cpu_mode")) {
         query_hints.cpu_mode = true;
       }
+      if (join_node->hasHintEnabled("batch_filters")) {
+        query_hints.batch_filters = true;
+      }
     }
     const auto compound_node = std::dynamic_pointer_cast<RelCompound>(node);
     if (compound_node) {
       if (compound_node->hasHintEnabled("cpu_mode")) {
         query_hints.cpu_mode = true;
       }
+      if (compound_node->hasHintEnabled("batch_filters")) {
+        query_hints.batch_filters = true;
+      }
     }
   }
   if (query_hints.cpu_mode) {
     VLOG(1) << "A user forces to run the query on the CPU execution mode";
   }
+  if (query_hints.batch_filters) {
+    VLOG(1) << "A user asks to evaluate the filters of the query over blocks of rows";
+  }
   dag_builder->registerQueryHints(query_hints);
 }
 
@@ -158,15 +158,19 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(executeRelAlgQuery);
 
+  auto co_hinted = co;
+  if (query_dag_->getQueryHints().batch_filters) {
+    co_hinted.batch_filters = true;
+  }
   try {
-    return executeRelAlgQueryNoRetry(co, eo, just_explain_plan, render_info);
+    return executeRelAlgQueryNoRetry(co_hinted, eo, just_explain_plan, render_info);
   } catch (const QueryMustRunOnCpu&) {
     if (!g_allow_cpu_retry) {
       throw;
     }
   }
   LOG(INFO) << "Query unable to run in GPU mode, retrying on CPU";
-  auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  auto co_cpu = CompilationOptions::makeCpuOnly(co_hinted);
 
   if (render_info) {
     render_info->setForceNonInSituData();
@@ -1406,6 +1410,16 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
 
   auto execute_update_for_node =
       [this, &co, &eo_in](const auto node, auto& work_unit, const bool is_aggregate) {
+        const auto modified_td = node->getModifiedTableDescriptor();
+        CHECK(modified_td);
+        for (const auto& column_name : node->getTargetColumns()) {
+          const auto cd = cat_.getMetadataForColumn(modified_td->tableId, column_name);
+          if (cd && cd->columnType.has_packed_encoding()) {
+            // the chunks can't be updated in place, a row no longer has a fixed offset
+            throw std::runtime_error("UPDATE of run length or frame of reference encoded "
+                                     "column " + column_name + " is not supported.");
+          }
+        }
         UpdateTransactionParameters update_params(node->getModifiedTableDescriptor(),
                                                   node->getTargetColumns(),
                                                   node->getOutputMetainfo(),
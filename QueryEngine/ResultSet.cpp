@@ -573,10 +573,10 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   auto timer = DEBUG_TIMER(__func__);
   const size_t step = cpu_threads();
   std::vector<std::vector<uint32_t>> strided_permutations(step);
-  std::vector<std::future<void>> init_futures;
+  std::vector<threadpool::Future<void>> init_futures;
   for (size_t start = 0; start < step; ++start) {
     init_futures.emplace_back(
-        std::async(std::launch::async, [this, start, step, &strided_permutations] {
+        threadpool::async([this, start, step, &strided_permutations] {
           strided_permutations[start] = initPermutationBuffer(start, step);
         }));
   }
@@ -587,12 +587,11 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
     init_future.get();
   }
   auto compare = createComparator(order_entries, true);
-  std::vector<std::future<void>> top_futures;
+  std::vector<threadpool::Future<void>> top_futures;
   for (auto& strided_permutation : strided_permutations) {
-    top_futures.emplace_back(
-        std::async(std::launch::async, [&strided_permutation, &compare, top_n] {
-          topPermutation(strided_permutation, top_n, compare);
-        }));
+    top_futures.emplace_back(threadpool::async([&strided_permutation, &compare, top_n] {
+      topPermutation(strided_permutation, top_n, compare);
+    }));
   }
   for (auto& top_future : top_futures) {
     top_future.wait();
@@ -264,6 +264,10 @@ class ResultSet {
 
   size_t getBufferSizeBytes(const ExecutorDeviceType device_type) const;
 
+  // Size of the host buffers of all the storages, appended ones included, and of the
+  // serialized varlen values.
+  size_t getHostBufferSizeBytes() const;
+
   bool definitelyHasNoRows() const;
 
   const QueryMemoryDescriptor& getQueryMemDesc() const;
@@ -756,6 +756,24 @@ size_t ResultSet::getBufferSizeBytes(const ExecutorDeviceType device_type) const
   return storage_->query_mem_desc_.getBufferSizeBytes(device_type);
 }
 
+size_t ResultSet::getHostBufferSizeBytes() const {
+  size_t size{0};
+  if (storage_) {
+    size += storage_->query_mem_desc_.getBufferSizeBytes(ExecutorDeviceType::CPU);
+  }
+  for (const auto& storage : appended_storage_) {
+    if (storage) {
+      size += storage->query_mem_desc_.getBufferSizeBytes(ExecutorDeviceType::CPU);
+    }
+  }
+  for (const auto& varlen_buffer : serialized_varlen_buffer_) {
+    for (const auto& value : varlen_buffer) {
+      size += value.size();
+    }
+  }
+  return size;
+}
+
 namespace {
 
 template <class T>
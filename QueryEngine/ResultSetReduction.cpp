@@ -41,12 +41,46 @@
 
 extern bool g_enable_dynamic_watchdog;
 
+bool g_enable_parallel_reduction{false};
+
 namespace {
 
 bool use_multithreaded_reduction(const size_t entry_count) {
   return entry_count > 100000;
 }
 
+// Reduces the storages pairwise, level by level, with the pairs of a level reduced
+// concurrently. The final result ends up in the first storage.
+void reduce_tree(const std::vector<const ResultSetStorage*>& storages,
+                 const ReductionCode& reduction_code) {
+  for (size_t stride = 1; stride < storages.size(); stride *= 2) {
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t i = 0; i + stride < storages.size(); i += 2 * stride) {
+      pairs.emplace_back(i, i + stride);
+    }
+    const size_t thread_count =
+        std::min(pairs.size(), static_cast<size_t>(cpu_threads()));
+    std::vector<std::future<void>> reduction_threads;
+    for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+      reduction_threads.emplace_back(std::async(
+          std::launch::async,
+          [&storages, &pairs, &reduction_code, thread_idx, thread_count] {
+            for (size_t pair_idx = thread_idx; pair_idx < pairs.size();
+                 pair_idx += thread_count) {
+              const auto [this_idx, that_idx] = pairs[pair_idx];
+              storages[this_idx]->reduce(*storages[that_idx], {}, reduction_code);
+            }
+          }));
+    }
+    for (auto& reduction_thread : reduction_threads) {
+      reduction_thread.wait();
+    }
+    for (auto& reduction_thread : reduction_threads) {
+      reduction_thread.get();
+    }
+  }
+}
+
 size_t get_row_qw_count(const QueryMemoryDescriptor& query_mem_desc) {
   const auto row_bytes = get_row_bytes(query_mem_desc);
   CHECK_EQ(size_t(0), row_bytes % 8);
@@ -837,6 +871,108 @@ void ResultSetStorage::reduceOneEntryBaseline(int8_t* this_buff,
       this_entry_slots, that_buff_i64, that_entry_idx, that_entry_count, that);
 }
 
+// Reduces all the inputs at once instead of folding them in one by one. Non-empty
+// entries of every input are first bucketed by the hash of their key, then each thread
+// reduces all the entries of one bucket into this storage. Identical keys always land
+// in the same bucket, so no two threads update the same output entry and the only
+// contention left is the lock-free slot claiming in the output hash table.
+void ResultSetStorage::reduceBaselinePartitioned(
+    const std::vector<const ResultSetStorage*>& that_storages,
+    const ReductionCode& reduction_code) const {
+  CHECK(query_mem_desc_.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash);
+  CHECK(!query_mem_desc_.hasKeylessHash());
+  const size_t partition_count = cpu_threads();
+  const auto key_count = query_mem_desc_.getGroupbyColCount();
+  const auto key_width = query_mem_desc_.getEffectiveKeyWidth();
+
+  // partitioned_entries[input_idx][partition_idx] holds the ascending indices of the
+  // non-empty entries of the input whose key belongs to the partition.
+  std::vector<std::vector<std::vector<uint32_t>>> partitioned_entries(
+      that_storages.size(), std::vector<std::vector<uint32_t>>(partition_count));
+  std::vector<std::future<void>> partition_threads;
+  for (size_t input_idx = 0; input_idx < that_storages.size(); ++input_idx) {
+    partition_threads.emplace_back(std::async(
+        std::launch::async,
+        [&that = *that_storages[input_idx],
+         &entries = partitioned_entries[input_idx],
+         partition_count,
+         key_count,
+         key_width] {
+          const auto that_entry_count = that.query_mem_desc_.getEntryCount();
+          const auto that_buff = that.buff_;
+          const auto that_buff_i64 = reinterpret_cast<const int64_t*>(that_buff);
+          for (size_t entry_idx = 0; entry_idx < that_entry_count; ++entry_idx) {
+            if (that.isEmptyEntry(entry_idx, that_buff)) {
+              continue;
+            }
+            uint32_t h{0};
+            if (that.query_mem_desc_.didOutputColumnar()) {
+              const auto key = make_key(
+                  &that_buff_i64[key_offset_colwise(entry_idx, 0, that_entry_count)],
+                  that_entry_count,
+                  key_count);
+              h = key_hash(&key[0], key_count, sizeof(int64_t));
+            } else {
+              const auto key_ptr = reinterpret_cast<const int64_t*>(
+                  row_ptr_rowwise(that_buff, that.query_mem_desc_, entry_idx));
+              h = key_hash(key_ptr, key_count, key_width);
+            }
+            entries[h % partition_count].push_back(entry_idx);
+          }
+        }));
+  }
+  for (auto& partition_thread : partition_threads) {
+    partition_thread.wait();
+  }
+  for (auto& partition_thread : partition_threads) {
+    partition_thread.get();
+  }
+
+  std::vector<std::future<void>> reduction_threads;
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    reduction_threads.emplace_back(std::async(
+        std::launch::async,
+        [this, &that_storages, &partitioned_entries, &reduction_code, partition_idx] {
+          for (size_t input_idx = 0; input_idx < that_storages.size(); ++input_idx) {
+            const auto& that = *that_storages[input_idx];
+            const auto that_entry_count = that.query_mem_desc_.getEntryCount();
+            const auto& entries = partitioned_entries[input_idx][partition_idx];
+            if (!reduction_code.ir_reduce_loop) {
+              for (const auto entry_idx : entries) {
+                reduceOneEntryBaseline(
+                    buff_, that.buff_, entry_idx, that_entry_count, that);
+              }
+              continue;
+            }
+            // Hand runs of consecutive entries to the generated reduction loop.
+            for (size_t i = 0; i < entries.size();) {
+              size_t j = i + 1;
+              while (j < entries.size() && entries[j] == entries[j - 1] + 1) {
+                ++j;
+              }
+              run_reduction_code(reduction_code,
+                                 buff_,
+                                 that.buff_,
+                                 entries[i],
+                                 entries[j - 1] + 1,
+                                 that_entry_count,
+                                 &query_mem_desc_,
+                                 &that.query_mem_desc_,
+                                 nullptr);
+              i = j;
+            }
+          }
+        }));
+  }
+  for (auto& reduction_thread : reduction_threads) {
+    reduction_thread.wait();
+  }
+  for (auto& reduction_thread : reduction_threads) {
+    reduction_thread.get();
+  }
+}
+
 void ResultSetStorage::reduceOneEntrySlotsBaseline(int64_t* this_entry_slots,
                                                    const int64_t* that_buff,
                                                    const size_t that_entry_idx,
@@ -1090,6 +1226,26 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
                                       result_rs->getTargetInfos(),
                                       result_rs->getTargetInitVals());
   auto reduction_code = reduction_jit.codegen();
+  if (g_enable_parallel_reduction && serialized_varlen_buffer.empty() &&
+      result_sets.size() > 2) {
+    std::vector<const ResultSetStorage*> that_storages;
+    for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
+         ++result_it) {
+      that_storages.push_back((*result_it)->storage_.get());
+    }
+    if (result->query_mem_desc_.getQueryDescriptionType() ==
+        QueryDescriptionType::GroupByBaselineHash) {
+      result->reduceBaselinePartitioned(that_storages, reduction_code);
+      return result_rs;
+    }
+    // Large perfect hash outputs are already split across threads by entry range in
+    // every pairwise reduction, small ones are reduced pairwise in a tree instead.
+    if (!use_multithreaded_reduction(result->query_mem_desc_.getEntryCount())) {
+      that_storages.insert(that_storages.begin(), result);
+      reduce_tree(that_storages, reduction_code);
+      return result_rs;
+    }
+  }
   size_t ctr = 1;
   for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
        ++result_it) {
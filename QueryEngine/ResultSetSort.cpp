@@ -28,6 +28,7 @@
 #include "ResultSetSortImpl.h"
 
 #include "../Shared/thread_count.h"
+#include "../Shared/threadpool.h"
 
 #include <future>
 
@@ -87,11 +88,10 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
   CHECK_GE(step, size_t(1));
   const auto key_bytewidth = query_mem_desc_.getEffectiveKeyWidth();
   if (step > 1) {
-    std::vector<std::future<void>> top_futures;
+    std::vector<threadpool::Future<void>> top_futures;
     std::vector<std::vector<uint32_t>> strided_permutations(step);
     for (size_t start = 0; start < step; ++start) {
-      top_futures.emplace_back(std::async(
-          std::launch::async,
+      top_futures.emplace_back(threadpool::async(
           [&strided_permutations,
            data_mgr,
            device_type,
@@ -118,6 +118,13 @@ int64_t result_set::lazy_decode(const ColumnLazyFetchInfo& col_lazy_fetch,
   CHECK(type_info.is_integer() || type_info.is_decimal() || type_info.is_time() ||
         type_info.is_timeinterval() || type_info.is_boolean() || type_info.is_string() ||
         type_info.is_array());
+  if (type_info.has_packed_encoding()) {
+    // the decoders return the null value of the logical type
+    return type_info.get_compression() == kENCODING_RL
+               ? run_length_decode_noinline(byte_stream, pos)
+               : frame_of_reference_decode_noinline(
+                     byte_stream, inline_int_null_val(type_info), pos);
+  }
   size_t type_bitwidth = get_bit_width(type_info);
   if (type_info.get_compression() == kENCODING_FIXED) {
     type_bitwidth = type_info.get_comp_param();
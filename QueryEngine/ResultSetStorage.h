@@ -156,6 +156,10 @@ class ResultSetStorage {
                               const size_t that_entry_count,
                               const ResultSetStorage& that) const;
 
+  void reduceBaselinePartitioned(
+      const std::vector<const ResultSetStorage*>& that_storages,
+      const ReductionCode& reduction_code) const;
+
   void reduceOneEntrySlotsBaseline(int64_t* this_entry_slots,
                                    const int64_t* that_buff,
                                    const size_t that_entry_idx,
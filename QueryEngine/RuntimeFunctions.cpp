@@ -951,6 +951,106 @@ extern "C" ALWAYS_INLINE int32_t get_error_code(int32_t* error_codes) {
   return error_codes[pos_start_impl(nullptr)];
 }
 
+// batch filter helpers, x64 only
+
+// The comparisons are evaluated for a whole block of rows into a mask and are free of
+// branches, so that they vectorize. Nulls never pass, like in the row function.
+#define DEF_BATCH_FILTER_CMP(type, opname, opsym)                                     \
+  extern "C" NEVER_INLINE void batch_filter_##opname##_##type(int8_t* mask,           \
+                                                              const int8_t* col,      \
+                                                              const int64_t start,    \
+                                                              const int32_t num_rows, \
+                                                              const type literal,     \
+                                                              const type null_val,    \
+                                                              const bool nullable) {  \
+    const type* vals = reinterpret_cast<const type*>(col) + start;                    \
+    if (nullable) {                                                                   \
+      for (int32_t i = 0; i < num_rows; ++i) {                                        \
+        mask[i] &= (vals[i] opsym literal) & (vals[i] != null_val);                   \
+      }                                                                               \
+    } else {                                                                          \
+      for (int32_t i = 0; i < num_rows; ++i) {                                        \
+        mask[i] &= vals[i] opsym literal;                                             \
+      }                                                                               \
+    }                                                                                 \
+  }
+
+#define DEF_BATCH_FILTER_CMPS(type)  \
+  DEF_BATCH_FILTER_CMP(type, eq, ==) \
+  DEF_BATCH_FILTER_CMP(type, ne, !=) \
+  DEF_BATCH_FILTER_CMP(type, lt, <)  \
+  DEF_BATCH_FILTER_CMP(type, le, <=) \
+  DEF_BATCH_FILTER_CMP(type, gt, >)  \
+  DEF_BATCH_FILTER_CMP(type, ge, >=)
+
+DEF_BATCH_FILTER_CMPS(int8_t)
+DEF_BATCH_FILTER_CMPS(int16_t)
+DEF_BATCH_FILTER_CMPS(int32_t)
+DEF_BATCH_FILTER_CMPS(int64_t)
+DEF_BATCH_FILTER_CMPS(float)
+DEF_BATCH_FILTER_CMPS(double)
+
+#undef DEF_BATCH_FILTER_CMPS
+#undef DEF_BATCH_FILTER_CMP
+
+extern "C" NEVER_INLINE void batch_filter_init_mask(int8_t* mask,
+                                                    const int32_t num_rows) {
+  memset(mask, 1, num_rows);
+}
+
+// Turns the mask into the offsets of the selected rows, returns their count.
+extern "C" NEVER_INLINE int32_t batch_filter_select(int32_t* sel,
+                                                    const int8_t* mask,
+                                                    const int32_t num_rows) {
+  int32_t sel_count{0};
+  for (int32_t i = 0; i < num_rows; ++i) {
+    sel[sel_count] = i;
+    sel_count += mask[i];
+  }
+  return sel_count;
+}
+
+// Replaces the increment of the row position in the scan loop when the filters are
+// batched: returns the next row which passes the batch filter, or row_count once there
+// is none. The filter runs again each time the selection of the current block is used
+// up. The state holds the start of the next block, the start of the current one, the
+// next index into the selection and the size of the selection.
+extern "C" ALWAYS_INLINE int64_t batch_filter_next_row(int64_t* state,
+                                                       int32_t* sel,
+                                                       const int64_t row_count,
+                                                       const int8_t** col_buffers,
+                                                       const int8_t* literals,
+                                                       batch_filter_t batch_filter) {
+  while (state[2] == state[3]) {
+    const int64_t block_start = state[0];
+    if (block_start >= row_count) {
+      return row_count;
+    }
+    const int32_t num_rows = static_cast<int32_t>(
+        std::min(static_cast<int64_t>(BATCH_FILTER_BLOCK_SIZE), row_count - block_start));
+    state[0] = block_start + num_rows;
+    state[1] = block_start;
+    state[2] = 0;
+    state[3] = batch_filter(sel, col_buffers, literals, block_start, num_rows);
+  }
+  return state[1] + sel[state[2]++];
+}
+
+extern "C" ALWAYS_INLINE int64_t batch_filter_first_row(int64_t* state,
+                                                        int32_t* sel,
+                                                        const int64_t pos_start,
+                                                        const int64_t row_count,
+                                                        const int8_t** col_buffers,
+                                                        const int8_t* literals,
+                                                        batch_filter_t batch_filter) {
+  state[0] = pos_start;
+  state[1] = pos_start;
+  state[2] = 0;
+  state[3] = 0;
+  return batch_filter_next_row(
+      state, sel, row_count, col_buffers, literals, batch_filter);
+}
+
 // group by helpers
 
 extern "C" NEVER_INLINE const int64_t* init_shared_mem_nop(
@@ -253,10 +253,29 @@ extern "C" int64_t fixed_width_small_date_decode_noinline(const int8_t* byte_str
                                                           const int64_t ret_null_val,
                                                           const int64_t pos);
 
+extern "C" int64_t run_length_decode_noinline(const int8_t* byte_stream,
+                                              const int64_t pos);
+
+extern "C" int64_t frame_of_reference_decode_noinline(const int8_t* byte_stream,
+                                                      const int64_t null_val,
+                                                      const int64_t pos);
+
 extern "C" int8_t* extract_str_ptr_noinline(const uint64_t str_and_len);
 
 extern "C" int32_t extract_str_len_noinline(const uint64_t str_and_len);
 
+// Rows per block of a batch filter, see batch_filter_next_row.
+constexpr int32_t BATCH_FILTER_BLOCK_SIZE = 1024;
+
+// Generated batch filter, writes the offsets from start of the rows among the next
+// num_rows which pass it to sel and returns their count. The literals it compares with
+// are read from the hoisted literal buffer of the query, if any.
+typedef int32_t (*batch_filter_t)(int32_t* sel,
+                                  const int8_t** col_buffers,
+                                  const int8_t* literals,
+                                  const int64_t start,
+                                  const int32_t num_rows);
+
 template <typename T = int64_t>
 inline T get_empty_key() {
   static_assert(std::is_same<T, int64_t>::value,
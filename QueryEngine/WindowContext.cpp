@@ -25,6 +25,11 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/TypePunning.h"
 #include "Shared/checked_alloc.h"
+#include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
+
+bool g_enable_parallel_window_partition_compute{true};
+size_t g_parallel_window_partition_compute_threshold{1 << 16};
 
 WindowFunctionContext::WindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
@@ -266,20 +271,85 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Partitions are computed concurrently and neighboring partitions can share a byte of
+// the bitmap, hence the atomic update.
+void set_partition_end(const int8_t* partition_end, const size_t pos) {
+  auto bitmap_byte = const_cast<int8_t*>(partition_end) + (pos >> 3);
+  __atomic_fetch_or(bitmap_byte, static_cast<int8_t>(1 << (pos & 7)), __ATOMIC_RELAXED);
+}
+
 void index_to_partition_end(
     const int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
-  int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
   for (size_t i = 0; i < index_size; ++i) {
     if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+      set_partition_end(partition_end, off + i - 1);
     }
   }
   CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  set_partition_end(partition_end, off + index_size - 1);
+}
+
+// Sorts the given indices with a merge sort. Chunks are sorted concurrently, then merged
+// pairwise, with the merges of one level running concurrently.
+void parallel_sort_partition(
+    int64_t* index,
+    const size_t index_size,
+    const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator,
+    const size_t thread_count) {
+  const size_t chunk_size = (index_size + thread_count - 1) / thread_count;
+  std::vector<size_t> chunk_bounds;
+  for (size_t start = 0; start < index_size; start += chunk_size) {
+    chunk_bounds.push_back(start);
+  }
+  chunk_bounds.push_back(index_size);
+  {
+    threadpool::FuturesThreadPool<void> thread_pool;
+    for (size_t i = 0; i + 1 < chunk_bounds.size(); ++i) {
+      const auto begin = chunk_bounds[i];
+      const auto end = chunk_bounds[i + 1];
+      thread_pool.spawn([index, &comparator, begin, end] {
+        std::sort(index + begin, index + end, comparator);
+      });
+    }
+    thread_pool.join();
+  }
+  std::vector<int64_t> merge_buffer(index_size);
+  int64_t* src = index;
+  int64_t* dst = merge_buffer.data();
+  while (chunk_bounds.size() > 2) {
+    std::vector<size_t> merged_chunk_bounds;
+    threadpool::FuturesThreadPool<void> thread_pool;
+    for (size_t i = 0; i + 1 < chunk_bounds.size(); i += 2) {
+      const auto begin = chunk_bounds[i];
+      merged_chunk_bounds.push_back(begin);
+      if (i + 2 < chunk_bounds.size()) {
+        const auto middle = chunk_bounds[i + 1];
+        const auto end = chunk_bounds[i + 2];
+        thread_pool.spawn([src, dst, &comparator, begin, middle, end] {
+          std::merge(src + begin,
+                     src + middle,
+                     src + middle,
+                     src + end,
+                     dst + begin,
+                     comparator);
+        });
+      } else {
+        // The odd chunk out moves on to the next level as is.
+        std::copy(src + begin, src + chunk_bounds[i + 1], dst + begin);
+      }
+    }
+    merged_chunk_bounds.push_back(index_size);
+    thread_pool.join();
+    chunk_bounds.swap(merged_chunk_bounds);
+    std::swap(src, dst);
+  }
+  if (src != index) {
+    std::copy(src, src + index_size, index);
+  }
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -411,64 +481,51 @@ void WindowFunctionContext::compute() {
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
-  int64_t off = 0;
-  for (size_t i = 0; i < partitionCount(); ++i) {
-    auto partition_size = counts()[i];
-    if (partition_size == 0) {
-      continue;
-    }
-    auto output_for_partition_buff = scratchpad.get() + offsets()[i];
-    std::iota(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              int64_t(0));
-    std::vector<Comparator> comparators;
-    const auto& order_keys = window_func_->getOrderKeys();
-    const auto& collation = window_func_->getCollation();
-    CHECK_EQ(order_keys.size(), collation.size());
-    for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
-         ++order_column_idx) {
-      auto order_column_buffer = order_columns_[order_column_idx];
-      const auto order_col =
-          dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
-      CHECK(order_col);
-      const auto& order_col_collation = collation[order_column_idx];
-      const auto asc_comparator = makeComparator(order_col,
-                                                 order_column_buffer,
-                                                 payload() + offsets()[i],
-                                                 order_col_collation.nulls_first);
-      auto comparator = asc_comparator;
-      if (order_col_collation.is_desc) {
-        comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
-          return asc_comparator(rhs, lhs);
-        };
+  const size_t partition_count = partitionCount();
+  const size_t thread_count =
+      g_enable_parallel_window_partition_compute &&
+              elem_count_ >= g_parallel_window_partition_compute_threshold
+          ? std::max(cpu_threads(), 1)
+          : 1;
+  if (thread_count > 1) {
+    // Large partitions are sorted by all threads, one partition after the other. The
+    // others are computed concurrently, split into ranges of similar element count.
+    std::vector<size_t> small_partitions;
+    size_t small_partitions_elem_count{0};
+    for (size_t i = 0; i < partition_count; ++i) {
+      const size_t partition_size = counts()[i];
+      if (partition_size >= g_parallel_window_partition_compute_threshold) {
+        computePartitionBuffer(i, scratchpad.get(), thread_count);
+      } else if (partition_size) {
+        small_partitions.push_back(i);
+        small_partitions_elem_count += partition_size;
       }
-      comparators.push_back(comparator);
     }
-    const auto col_tuple_comparator = [&comparators](const int64_t lhs,
-                                                     const int64_t rhs) {
-      for (const auto& comparator : comparators) {
-        if (comparator(lhs, rhs)) {
-          return true;
-        }
+    const size_t elem_count_per_thread =
+        (small_partitions_elem_count + thread_count - 1) / thread_count;
+    threadpool::FuturesThreadPool<void> thread_pool;
+    for (size_t begin = 0, end = 0; begin < small_partitions.size(); begin = end) {
+      size_t range_elem_count{0};
+      while (end < small_partitions.size() && range_elem_count < elem_count_per_thread) {
+        range_elem_count += counts()[small_partitions[end]];
+        ++end;
       }
-      return false;
-    };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
-    computePartition(output_for_partition_buff,
-                     partition_size,
-                     off,
-                     window_func_,
-                     col_tuple_comparator);
-    if (window_function_is_value(window_func_->getKind()) ||
-        window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
+      thread_pool.spawn([this, &small_partitions, &scratchpad, begin, end] {
+        for (size_t i = begin; i < end; ++i) {
+          computePartitionBuffer(small_partitions[i], scratchpad.get(), 1);
+        }
+      });
+    }
+    thread_pool.join();
+  } else {
+    for (size_t i = 0; i < partition_count; ++i) {
+      computePartitionBuffer(i, scratchpad.get(), 1);
     }
   }
   if (window_function_is_value(window_func_->getKind()) ||
       window_function_is_aggregate(window_func_->getKind())) {
-    CHECK_EQ(static_cast<size_t>(off), elem_count_);
+    CHECK_EQ(std::accumulate(counts(), counts() + partition_count, size_t(0)),
+             elem_count_);
   }
   auto output_i64 = reinterpret_cast<int64_t*>(output_);
   if (window_function_is_aggregate(window_func_->getKind())) {
@@ -480,6 +537,69 @@ void WindowFunctionContext::compute() {
   }
 }
 
+void WindowFunctionContext::computePartitionBuffer(const size_t i,
+                                                   int64_t* scratchpad,
+                                                   const size_t thread_count) {
+  const size_t partition_size = counts()[i];
+  if (partition_size == 0) {
+    return;
+  }
+  auto output_for_partition_buff = scratchpad + offsets()[i];
+  std::iota(output_for_partition_buff,
+            output_for_partition_buff + partition_size,
+            int64_t(0));
+  std::vector<Comparator> comparators;
+  const auto& order_keys = window_func_->getOrderKeys();
+  const auto& collation = window_func_->getCollation();
+  CHECK_EQ(order_keys.size(), collation.size());
+  for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
+       ++order_column_idx) {
+    auto order_column_buffer = order_columns_[order_column_idx];
+    const auto order_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
+    CHECK(order_col);
+    const auto& order_col_collation = collation[order_column_idx];
+    const auto asc_comparator = makeComparator(order_col,
+                                               order_column_buffer,
+                                               payload() + offsets()[i],
+                                               order_col_collation.nulls_first);
+    auto comparator = asc_comparator;
+    if (order_col_collation.is_desc) {
+      comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
+        return asc_comparator(rhs, lhs);
+      };
+    }
+    comparators.push_back(comparator);
+  }
+  // Lexicographic order over the order keys, the merge of the parallel sort relies on
+  // a strict weak ordering.
+  const auto col_tuple_comparator = [&comparators](const int64_t lhs,
+                                                   const int64_t rhs) {
+    for (const auto& comparator : comparators) {
+      if (comparator(lhs, rhs)) {
+        return true;
+      }
+      if (comparator(rhs, lhs)) {
+        return false;
+      }
+    }
+    return false;
+  };
+  if (thread_count > 1) {
+    parallel_sort_partition(
+        output_for_partition_buff, partition_size, col_tuple_comparator, thread_count);
+  } else {
+    std::sort(output_for_partition_buff,
+              output_for_partition_buff + partition_size,
+              col_tuple_comparator);
+  }
+  computePartition(output_for_partition_buff,
+                   partition_size,
+                   offsets()[i],
+                   window_func_,
+                   col_tuple_comparator);
+}
+
 const Analyzer::WindowFunction* WindowFunctionContext::getWindowFunction() const {
   return window_func_;
 }
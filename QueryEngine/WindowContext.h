@@ -131,6 +131,12 @@ class WindowFunctionContext {
                                    const int32_t* partition_indices,
                                    const bool nulls_first);
 
+  // Sorts the partition at the given index and computes its window function values in
+  // the scratchpad, with the given number of threads for the sort.
+  void computePartitionBuffer(const size_t i,
+                              int64_t* scratchpad,
+                              const size_t thread_count);
+
   void computePartition(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
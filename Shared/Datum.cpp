@@ -23,10 +23,12 @@
  **/
 
 #include <cassert>
+#include <charconv>
 #include <cstdio>
 #include <cstdlib>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "DateConverters.h"
 #include "DateTimeParser.h"
@@ -118,6 +120,27 @@ int64_t parse_numeric(const std::string_view s, SQLTypeInfo& ti) {
   return result * sign;
 }
 
+namespace {
+
+// Parses the digits in place, without copying the field to a string. Anything unusual,
+// like leading whitespace, a '+' or an out of range value, goes through std::stoi and
+// std::stoll, which also report the error.
+template <typename T>
+T parse_integer(const std::string_view s) {
+  T value;
+  const auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (result.ec == std::errc()) {
+    return value;
+  }
+  if constexpr (std::is_same_v<T, int>) {
+    return std::stoi(std::string(s));
+  } else {
+    return std::stoll(std::string(s));
+  }
+}
+
+}  // namespace
+
 /*
  * @brief convert string to a datum
  */
@@ -143,16 +166,16 @@ Datum StringToDatum(std::string_view s, SQLTypeInfo& ti) {
         d.bigintval = parse_numeric(s, ti);
         break;
       case kBIGINT:
-        d.bigintval = std::stoll(std::string(s));
+        d.bigintval = parse_integer<long long>(s);
         break;
       case kINT:
-        d.intval = std::stoi(std::string(s));
+        d.intval = parse_integer<int>(s);
         break;
       case kSMALLINT:
-        d.smallintval = std::stoi(std::string(s));
+        d.smallintval = parse_integer<int>(s);
         break;
       case kTINYINT:
-        d.tinyintval = std::stoi(std::string(s));
+        d.tinyintval = parse_integer<int>(s);
         break;
       case kFLOAT:
         d.floatval = std::stof(std::string(s));
@@ -116,24 +116,42 @@ bool removeFile(const std::string basePath, const std::string filename) {
 }
 
 size_t read(FILE* f, const size_t offset, const size_t size, int8_t* buf) {
-  // read "size" bytes from the offset location in the file into the buffer
-  CHECK_EQ(fseek(f, static_cast<long>(offset), SEEK_SET), 0);
-  size_t bytesRead = fread(buf, sizeof(int8_t), size, f);
+  // read "size" bytes from the offset location in the file into the buffer. Positional
+  // reads leave the stream offset alone, so callers may read concurrently from the same
+  // file without serializing on it.
+  const int fd = fileno(f);
+  size_t bytesRead = 0;
+  while (bytesRead < size) {
+    const auto ret =
+        omnisci::pread(fd, buf + bytesRead, size - bytesRead, offset + bytesRead);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      LOG(FATAL) << "Error trying to read from file (during pread) the error was: "
+                 << (ret < 0 ? std::strerror(errno) : "unexpected end of file");
+    }
+    bytesRead += static_cast<size_t>(ret);
+  }
   CHECK_EQ(bytesRead, sizeof(int8_t) * size);
   return bytesRead;
 }
 
 size_t write(FILE* f, const size_t offset, const size_t size, int8_t* buf) {
   // write size bytes from the buffer to the offset location in the file
-  if (fseek(f, static_cast<long>(offset), SEEK_SET) != 0) {
-    LOG(FATAL)
-        << "Error trying to write to file (during positioning seek) the error was: "
-        << std::strerror(errno);
-  }
-  size_t bytesWritten = fwrite(buf, sizeof(int8_t), size, f);
-  if (bytesWritten != sizeof(int8_t) * size) {
-    LOG(FATAL) << "Error trying to write to file (during fwrite) the error was: "
-               << std::strerror(errno);
+  const int fd = fileno(f);
+  size_t bytesWritten = 0;
+  while (bytesWritten < size) {
+    const auto ret = omnisci::pwrite(
+        fd, buf + bytesWritten, size - bytesWritten, offset + bytesWritten);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      LOG(FATAL) << "Error trying to write to file (during pwrite) the error was: "
+                 << std::strerror(errno);
+    }
+    bytesWritten += static_cast<size_t>(ret);
   }
   return bytesWritten;
 }
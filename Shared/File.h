@@ -71,6 +71,9 @@ bool removeFile(const std::string basePath, const std::string filename);
 /**
  * @brief Reads the specified number of bytes from the offset position in file f into buf.
  *
+ * Uses positional I/O on the underlying descriptor, so concurrent reads of the same
+ * file are safe and do not move the stream offset.
+ *
  * @param f Pointer to the FILE.
  * @param offset The location within the file from which to read.
  * @param n The number of bytes to be read.
@@ -83,6 +86,9 @@ size_t read(FILE* f, const size_t offset, const size_t size, int8_t* buf);
 /**
  * @brief Writes the specified number of bytes to the offset position in file f from buf.
  *
+ * Bypasses the stream buffer; callers mixing this with buffered fwrite on the same
+ * FILE* must fflush before issuing positional I/O on overlapping ranges.
+ *
  * @param f Pointer to the FILE.
  * @param offset The location within the file where data is being written.
  * @param size The number of bytes to write to the file.
@@ -124,6 +124,10 @@ inline int64_t inline_fixed_encoding_null_val(const SQL_TYPE_INFO& ti) {
 #endif
     }
   }
+  if (ti.has_packed_encoding()) {
+    // run-length and frame-of-reference encoded columns store the logical null value
+    return inline_int_null_val(get_logical_type_info(ti));
+  }
   CHECK_EQ(kENCODING_FIXED, ti.get_compression());
   CHECK(ti.is_integer() || ti.is_time() || ti.is_decimal());
   CHECK_EQ(0, ti.get_comp_param() % 8);
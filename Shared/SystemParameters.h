@@ -51,6 +51,8 @@ struct SystemParameters {
       size_t(1)
       << 32;  // max size of CPU buffer pool memory allocations [bytes], default=4GB
   double gpu_input_mem_limit = 0.9;  // Punt query to CPU if input mem exceeds % GPU mem
+  std::string cpu_buffer_eviction_policy = "lru";  // "lru" or "2q"
+  std::string gpu_buffer_eviction_policy = "lru";  // "lru" or "2q"
   std::string config_file = "";
   std::string ssl_cert_file = "";    // file path to server's certified PKI certificate
   std::string ssl_key_file = "";     // file path to server's' private PKI key
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/WorkStealingPool.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "Shared/thread_count.h"
+
+namespace threadpool {
+
+namespace {
+
+// The pool and deque index of the worker running on this thread, if any.
+thread_local const WorkStealingPool* tls_pool{nullptr};
+thread_local size_t tls_worker_idx{0};
+
+}  // namespace
+
+std::string WorkStealingPool::Stats::toString() const {
+  std::ostringstream oss;
+  oss << submitted_count << " tasks submitted, " << executed_count << " run by "
+      << worker_count << " workers (" << steal_count << " stolen), " << inline_count
+      << " run by waiters, queue depth " << queue_depth << " (max " << max_queue_depth
+      << ")";
+  return oss.str();
+}
+
+WorkStealingPool& WorkStealingPool::instance() {
+  static WorkStealingPool pool(static_cast<size_t>(cpu_threads()));
+  return pool;
+}
+
+WorkStealingPool::WorkStealingPool(const size_t worker_count) {
+  CHECK_GT(worker_count, size_t(0));
+  for (size_t i = 0; i < worker_count; ++i) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(wakeup_mutex_);
+    shutdown_ = true;
+  }
+  wakeup_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::shared_ptr<WorkStealingPool::Task> WorkStealingPool::submit(
+    std::function<void()>&& func) {
+  auto task = std::make_shared<Task>(std::move(func));
+  const size_t queue_idx =
+      tls_pool == this ? tls_worker_idx : next_queue_++ % queues_.size();
+  {
+    auto& queue = *queues_[queue_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> lock(wakeup_mutex_);
+    ++queued_task_count_;
+    max_queued_task_count_ = std::max(max_queued_task_count_, queued_task_count_);
+  }
+  ++submitted_count_;
+  wakeup_cv_.notify_one();
+  return task;
+}
+
+void WorkStealingPool::wait(Task& task) {
+  if (tryRun(task)) {
+    ++inline_count_;
+    return;
+  }
+  std::unique_lock<std::mutex> lock(task.mutex);
+  task.done_cv.wait(lock, [&task] { return task.done; });
+}
+
+WorkStealingPool::Stats WorkStealingPool::getStats() const {
+  Stats stats;
+  stats.worker_count = workers_.size();
+  stats.submitted_count = submitted_count_;
+  stats.executed_count = executed_count_;
+  stats.steal_count = steal_count_;
+  stats.inline_count = inline_count_;
+  std::lock_guard<std::mutex> lock(wakeup_mutex_);
+  stats.queue_depth = queued_task_count_;
+  stats.max_queue_depth = max_queued_task_count_;
+  return stats;
+}
+
+void WorkStealingPool::workerLoop(const size_t worker_idx) {
+  tls_pool = this;
+  tls_worker_idx = worker_idx;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(wakeup_mutex_);
+      wakeup_cv_.wait(lock, [this] { return shutdown_ || queued_task_count_ > 0; });
+      if (shutdown_) {
+        return;
+      }
+    }
+    bool stolen = false;
+    const auto task = popTask(worker_idx, stolen);
+    // The task may already have been run by a thread waiting for it.
+    if (task && tryRun(*task)) {
+      ++executed_count_;
+      if (stolen) {
+        ++steal_count_;
+      }
+    }
+  }
+}
+
+std::shared_ptr<WorkStealingPool::Task> WorkStealingPool::popTask(
+    const size_t worker_idx,
+    bool& stolen) {
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(worker_idx + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    std::shared_ptr<Task> task;
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      stolen = true;
+    }
+    std::lock_guard<std::mutex> wakeup_lock(wakeup_mutex_);
+    CHECK_GT(queued_task_count_, size_t(0));
+    --queued_task_count_;
+    return task;
+  }
+  return nullptr;
+}
+
+bool WorkStealingPool::tryRun(Task& task) {
+  bool expected = false;
+  if (!task.claimed.compare_exchange_strong(expected, true)) {
+    return false;
+  }
+  task.func();
+  // Release the captures before the waiters are woken up.
+  task.func = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(task.mutex);
+    task.done = true;
+  }
+  task.done_cv.notify_all();
+  return true;
+}
+
+}  // namespace threadpool
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WorkStealingPool.h
+ * @brief   Process-wide, fixed size work-stealing pool for fork-join parallelism.
+ *
+ * The pool has cpu_threads() workers, each with its own deque. A task submitted from
+ * a worker goes to the back of that worker's deque and is popped from there again
+ * (newest first, while its data is still in cache); tasks submitted from any other
+ * thread are spread round-robin. Idle workers steal the oldest task of the first
+ * non-empty deque.
+ *
+ * Waiting for a task which no worker has started yet runs it on the waiting thread.
+ * Hence a task that waits only for tasks it spawned itself can't deadlock the pool,
+ * however deep the nesting and however busy the workers. Tasks must not wait for
+ * anything else queued on the pool, e.g. to be signalled by a sibling.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace threadpool {
+
+class WorkStealingPool {
+ public:
+  struct Task {
+    explicit Task(std::function<void()>&& func) : func(std::move(func)) {}
+
+    std::function<void()> func;
+    std::atomic<bool> claimed{false};
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done{false};
+  };
+
+  struct Stats {
+    size_t worker_count{0};
+    size_t submitted_count{0};
+    // Tasks run by the workers, of which stolen from another worker's deque.
+    size_t executed_count{0};
+    size_t steal_count{0};
+    // Tasks run by a thread waiting for them before any worker got to them.
+    size_t inline_count{0};
+    size_t queue_depth{0};
+    size_t max_queue_depth{0};
+
+    std::string toString() const;
+  };
+
+  static WorkStealingPool& instance();
+
+  ~WorkStealingPool();
+
+  // Queues the function, which must not throw.
+  std::shared_ptr<Task> submit(std::function<void()>&& func);
+
+  // Waits for the task to finish, running it on the calling thread if it hasn't been
+  // started yet.
+  void wait(Task& task);
+
+  Stats getStats() const;
+
+  size_t workerCount() const { return workers_.size(); }
+
+ private:
+  explicit WorkStealingPool(const size_t worker_count);
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Task>> tasks;
+  };
+
+  void workerLoop(const size_t worker_idx);
+  std::shared_ptr<Task> popTask(const size_t worker_idx, bool& stolen);
+  // Runs the task unless another thread already claimed it.
+  static bool tryRun(Task& task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex wakeup_mutex_;
+  std::condition_variable wakeup_cv_;
+  size_t queued_task_count_{0};
+  size_t max_queued_task_count_{0};
+  bool shutdown_{false};
+
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<size_t> submitted_count_{0};
+  std::atomic<size_t> executed_count_{0};
+  std::atomic<size_t> steal_count_{0};
+  std::atomic<size_t> inline_count_{0};
+};
+
+}  // namespace threadpool
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/numa.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+bool g_enable_numa_placement{false};
+
+namespace numa {
+
+namespace {
+
+constexpr int kMaxNodeCount{1024};
+
+// Parses a sysfs list such as "0-3,8-11".
+std::vector<int> parse_list(const std::string& list) {
+  std::vector<int> values;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    auto end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(pos, end - pos);
+    const auto dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int value = first; value <= last; ++value) {
+        values.push_back(value);
+      }
+    } catch (const std::exception&) {
+      return {};
+    }
+    pos = end + 1;
+  }
+  return values;
+}
+
+std::vector<int> read_list(const std::string& path) {
+  std::ifstream in(path);
+  std::string list;
+  if (!in || !std::getline(in, list)) {
+    return {};
+  }
+  return parse_list(list);
+}
+
+struct Topology {
+  std::vector<int> nodes;
+  std::map<int, std::vector<int>> node_cpus;
+
+  Topology() {
+    const std::string node_dir{"/sys/devices/system/node/"};
+    for (const auto node : read_list(node_dir + "online")) {
+      if (node >= kMaxNodeCount) {
+        continue;
+      }
+      auto cpus = read_list(node_dir + "node" + std::to_string(node) + "/cpulist");
+      if (!cpus.empty()) {
+        nodes.push_back(node);
+        node_cpus[node] = std::move(cpus);
+      }
+    }
+    if (nodes.empty()) {
+      // No NUMA information: a single node with all the CPUs.
+      nodes.push_back(0);
+      auto& cpus = node_cpus[0];
+      for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+};
+
+const Topology& get_topology() {
+  static const Topology topology;
+  return topology;
+}
+
+}  // namespace
+
+const std::vector<int>& nodes() {
+  return get_topology().nodes;
+}
+
+const std::vector<int>& node_cpus(const int node) {
+  static const std::vector<int> no_cpus;
+  const auto& node_cpus = get_topology().node_cpus;
+  const auto it = node_cpus.find(node);
+  return it != node_cpus.end() ? it->second : no_cpus;
+}
+
+int fragment_node(const int fragment_id) {
+  const auto& all_nodes = nodes();
+  if (!g_enable_numa_placement || all_nodes.size() < 2 || fragment_id < 0) {
+    return -1;
+  }
+  return all_nodes[fragment_id % all_nodes.size()];
+}
+
+bool bind_memory(void* addr, const size_t num_bytes, const int node) {
+#ifdef __linux__
+  if (node < 0 || node >= kMaxNodeCount) {
+    return false;
+  }
+  // mbind works on whole pages, so only bind the pages entirely within the range.
+  const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = reinterpret_cast<uintptr_t>(addr);
+  const auto aligned_begin = (begin + page_size - 1) & ~(page_size - 1);
+  const auto aligned_end = (begin + num_bytes) & ~(page_size - 1);
+  if (aligned_end <= aligned_begin) {
+    return true;
+  }
+  constexpr size_t kBitsPerWord{8 * sizeof(unsigned long)};
+  unsigned long node_mask[kMaxNodeCount / kBitsPerWord] = {};
+  node_mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+  // The kernel expects one more than the number of bits in the mask.
+  return syscall(SYS_mbind,
+                 reinterpret_cast<void*>(aligned_begin),
+                 aligned_end - aligned_begin,
+                 MPOL_PREFERRED,
+                 node_mask,
+                 kMaxNodeCount + 1,
+                 0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool bind_current_thread(const int node) {
+#ifdef __linux__
+  const auto& cpus = node_cpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  return false;
+#endif
+}
+
+int memory_node(const void* addr) {
+#ifdef __linux__
+  int node = -1;
+  if (syscall(SYS_get_mempolicy,
+              &node,
+              nullptr,
+              0,
+              const_cast<void*>(addr),
+              MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+    return -1;
+  }
+  return node;
+#else
+  return -1;
+#endif
+}
+
+}  // namespace numa
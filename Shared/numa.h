@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    numa.h
+ * @brief   NUMA topology and memory / thread placement helpers.
+ *
+ * The topology is read from sysfs and the placement uses the mbind and
+ * sched_setaffinity system calls directly, so no libnuma is required. On machines
+ * with a single node, or where the topology can't be read, everything degrades to a
+ * single node 0 and the binding calls are no-ops.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+extern bool g_enable_numa_placement;
+
+namespace numa {
+
+// Ids of the online NUMA nodes which have CPUs, in increasing order. Never empty.
+const std::vector<int>& nodes();
+
+inline size_t node_count() {
+  return nodes().size();
+}
+
+// CPUs of the given node, empty for an unknown node.
+const std::vector<int>& node_cpus(const int node);
+
+// Node on which the chunks of a fragment are cached and its kernels are run. Fragments
+// are spread over the nodes round-robin by fragment id. Returns -1 if NUMA placement
+// is disabled or there is only one node.
+int fragment_node(const int fragment_id);
+
+// Sets the memory policy of the pages in the given range to prefer the node. Only
+// affects pages which haven't been touched yet. Returns false on failure.
+bool bind_memory(void* addr, const size_t num_bytes, const int node);
+
+// Restricts the calling thread to the CPUs of the node. Returns false on failure.
+bool bind_current_thread(const int node);
+
+// Node holding the page at the given address, faulting it in if needed. Returns -1 if
+// unknown.
+int memory_node(const void* addr);
+
+}  // namespace numa
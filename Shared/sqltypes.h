@@ -519,6 +519,12 @@ class SQLTypeInfo {
     return is_string() && compression == kENCODING_DICT;
   }
 
+  // Run-length and frame-of-reference encoded chunks don't hold one fixed width value
+  // per row, they have to be decoded with the row position.
+  HOST DEVICE inline bool has_packed_encoding() const {
+    return compression == kENCODING_RL || compression == kENCODING_DIFF;
+  }
+
   HOST DEVICE inline bool operator!=(const SQLTypeInfo& rhs) const {
     return type != rhs.get_type() || subtype != rhs.get_subtype() ||
            dimension != rhs.get_dimension() || scale != rhs.get_scale() ||
@@ -749,13 +755,12 @@ class SQLTypeInfo {
       case kSMALLINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int16_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -763,13 +768,12 @@ class SQLTypeInfo {
       case kINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int32_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -779,13 +783,12 @@ class SQLTypeInfo {
       case kDECIMAL:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int64_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -825,14 +828,14 @@ class SQLTypeInfo {
       case kDATE:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int64_t);
           case kENCODING_FIXED:
             if (type == kTIMESTAMP && dimension > 0) {
               assert(false);  // disable compression for timestamp precisions
             }
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -893,7 +896,7 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_DATE_IN_DAYS ||
+  if (encoding == kENCODING_DATE_IN_DAYS || type_info.has_packed_encoding() ||
       (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
@@ -22,20 +22,85 @@
 
 #include <future>
 #include <iostream>
+#include <tuple>
 #include <type_traits>
 
+#include "Shared/WorkStealingPool.h"
+
 namespace threadpool {
 
+// Result of a task run on the process-wide WorkStealingPool. Unlike a plain
+// std::future, waiting for it runs the task on the waiting thread if no worker has
+// started it yet.
+template <typename T>
+class Future {
+ public:
+  Future(std::shared_ptr<WorkStealingPool::Task> task, std::future<T>&& future)
+      : task_(std::move(task)), future_(std::move(future)) {}
+
+  Future(Future&&) = default;
+
+  Future& operator=(Future&& other) {
+    if (future_.valid()) {
+      wait();
+    }
+    task_ = std::move(other.task_);
+    future_ = std::move(other.future_);
+    return *this;
+  }
+
+  // Like the future returned by std::async, blocks until the task is done, the task may
+  // reference locals of the scope being left, e.g. on an exception.
+  ~Future() {
+    if (future_.valid()) {
+      wait();
+    }
+  }
+
+  void wait() { WorkStealingPool::instance().wait(*task_); }
+
+  T get() {
+    wait();
+    return future_.get();
+  }
+
+  // Only polls, it never runs the task.
+  template <class Rep, class Period>
+  std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+    return future_.wait_for(timeout);
+  }
+
+ private:
+  std::shared_ptr<WorkStealingPool::Task> task_;
+  std::future<T> future_;
+};
+
+// Drop-in replacement for std::async(std::launch::async, ...) which runs the function
+// on the WorkStealingPool instead of a new thread.
+template <class Function, class... Args>
+auto async(Function&& f, Args&&... args) {
+  using T = std::invoke_result_t<std::decay_t<Function>, std::decay_t<Args>...>;
+  auto packaged_task = std::make_shared<std::packaged_task<T()>>(
+      [f = std::forward<Function>(f),
+       args = std::make_tuple(std::forward<Args>(args)...)]() mutable -> T {
+        return std::apply(std::move(f), std::move(args));
+      });
+  auto future = packaged_task->get_future();
+  auto task = WorkStealingPool::instance().submit(
+      [packaged_task = std::move(packaged_task)] { (*packaged_task)(); });
+  return Future<T>(std::move(task), std::move(future));
+}
+
 template <typename T>
 class FuturesThreadPoolBase {
  public:
   template <class Function, class... Args>
   void spawn(Function&& f, Args&&... args) {
-    threads_.push_back(std::async(std::launch::async, f, args...));
+    threads_.push_back(async(f, args...));
   }
 
  protected:
-  std::vector<std::future<T>> threads_;
+  std::vector<Future<T>> threads_;
 };
 
 template <typename T, typename ENABLE = void>
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRINGDICTIONARY_SHARDEDLRUCACHE_HPP
+#define STRINGDICTIONARY_SHARDEDLRUCACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Thread-safe LRU cache bounded by the total size of its entries. Keys are spread
+// over independently locked shards so that concurrent lookups of different keys
+// rarely contend. Each shard gets an equal part of the byte budget; an entry larger
+// than that is not cached at all.
+template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>>
+class ShardedLruCache {
+ public:
+  struct Stats {
+    size_t hit_count{0};
+    size_t miss_count{0};
+    size_t eviction_count{0};
+    size_t entry_count{0};
+    size_t size_bytes{0};
+  };
+
+  ShardedLruCache(const size_t max_size_bytes)
+      : max_shard_size_bytes_(max_size_bytes / kShardCount) {}
+
+  std::shared_ptr<const value_t> get(const key_t& key) {
+    auto& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.items_map.find(key);
+    if (it == shard.items_map.end()) {
+      ++miss_count_;
+      return nullptr;
+    }
+    shard.items_list.splice(shard.items_list.begin(), shard.items_list, it->second);
+    ++hit_count_;
+    return it->second->value;
+  }
+
+  // The size should account for the key as well as for any memory owned by the value.
+  void put(const key_t& key, std::shared_ptr<const value_t> value, const size_t size) {
+    const size_t entry_size = size + kEntryOverheadBytes;
+    if (entry_size > max_shard_size_bytes_) {
+      return;
+    }
+    auto& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.items_map.find(key);
+    if (it != shard.items_map.end()) {
+      shard.size_bytes -= it->second->size;
+      shard.items_list.erase(it->second);
+      shard.items_map.erase(it);
+    }
+    while (!shard.items_list.empty() &&
+           shard.size_bytes + entry_size > max_shard_size_bytes_) {
+      const auto& last = shard.items_list.back();
+      shard.size_bytes -= last.size;
+      shard.items_map.erase(last.key);
+      shard.items_list.pop_back();
+      ++eviction_count_;
+    }
+    shard.items_list.push_front(Entry{key, std::move(value), entry_size});
+    shard.items_map[key] = shard.items_list.begin();
+    shard.size_bytes += entry_size;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.items_list.clear();
+      shard.items_map.clear();
+      shard.size_bytes = 0;
+    }
+  }
+
+  Stats getStats() const {
+    Stats stats;
+    stats.hit_count = hit_count_;
+    stats.miss_count = miss_count_;
+    stats.eviction_count = eviction_count_;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      stats.entry_count += shard.items_map.size();
+      stats.size_bytes += shard.size_bytes;
+    }
+    return stats;
+  }
+
+ private:
+  static constexpr size_t kShardCount{16};
+  // Rough per-entry cost of the list node and the map node.
+  static constexpr size_t kEntryOverheadBytes{128};
+
+  struct Entry {
+    key_t key;
+    std::shared_ptr<const value_t> value;
+    size_t size;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::list<Entry> items_list;
+    std::unordered_map<key_t, typename std::list<Entry>::iterator, hash_t> items_map;
+    size_t size_bytes{0};
+  };
+
+  Shard& getShard(const key_t& key) { return shards_[hash_t()(key) % kShardCount]; }
+
+  const size_t max_shard_size_bytes_;
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+  std::atomic<size_t> eviction_count_{0};
+};
+
+#endif  // STRINGDICTIONARY_SHARDEDLRUCACHE_HPP
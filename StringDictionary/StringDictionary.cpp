@@ -88,6 +88,7 @@ uint32_t rk_hash(const std::string_view& str) {
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+size_t g_stringdict_pattern_cache_bytes{size_t(128) << 20};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -616,51 +617,24 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool is_simple,
                                                const char escape,
                                                const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
-  const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
+  std::string cache_key{'L', icase ? 'i' : 'c', is_simple ? 's' : 'p', escape};
+  cache_key += pattern;
+  if (const auto cached_result = pattern_cache_.get(cache_key)) {
+    return *cached_result;
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          icase,
-                          is_simple,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
+  auto result = getMatchingStringIds(
+      generation, [&pattern, icase, is_simple, escape](const std::string& str) {
+        return is_like(str, pattern, icase, is_simple, escape);
+      });
   // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-
-  CHECK(it_ok.second);
-
+  pattern_cache_.put(cache_key,
+                     std::make_shared<const std::vector<int32_t>>(result),
+                     cache_key.size() + result.size() * sizeof(int32_t));
   return result;
 }
 
@@ -668,11 +642,11 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
                                                  std::string comp_operator,
                                                  size_t generation) {
   std::vector<int32_t> result;
-  auto eq_id_itr = equal_cache_.find(pattern);
+  const auto cached_eq_id = equal_cache_.get(pattern);
   int32_t eq_id = MAX_STRLEN + 1;
   int32_t cur_size = str_count_;
-  if (eq_id_itr != equal_cache_.end()) {
-    auto eq_id = eq_id_itr->second;
+  if (cached_eq_id) {
+    auto eq_id = *cached_eq_id;
     if (comp_operator == "=") {
       result.push_back(eq_id);
     } else {
@@ -684,32 +658,12 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
       }
     }
   } else {
-    std::vector<std::thread> workers;
-    int worker_count = cpu_threads();
-    CHECK_GT(worker_count, 0);
-    std::vector<std::vector<int32_t>> worker_results(worker_count);
     CHECK_LE(generation, str_count_);
-    for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-      workers.emplace_back(
-          [&worker_results, &pattern, generation, worker_idx, worker_count, this]() {
-            for (size_t string_id = worker_idx; string_id < generation;
-                 string_id += worker_count) {
-              const auto str = getStringUnlocked(string_id);
-              if (str == pattern) {
-                worker_results[worker_idx].push_back(string_id);
-              }
-            }
-          });
-    }
-    for (auto& worker : workers) {
-      worker.join();
-    }
-    for (const auto& worker_result : worker_results) {
-      result.insert(result.end(), worker_result.begin(), worker_result.end());
-    }
+    result = getMatchingStringIds(
+        generation, [&pattern](const std::string& str) { return str == pattern; });
     if (result.size() > 0) {
-      const auto it_ok = equal_cache_.insert(std::make_pair(pattern, result[0]));
-      CHECK(it_ok.second);
+      equal_cache_.put(
+          pattern, std::make_shared<const int32_t>(result[0]), pattern.size());
       eq_id = result[0];
     }
     if (comp_operator == "<>") {
@@ -888,47 +842,51 @@ bool is_regexp_like(const std::string& str,
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
-  const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
+  std::string cache_key{'R', escape};
+  cache_key += pattern;
+  if (const auto cached_result = pattern_cache_.get(cache_key)) {
+    return *cached_result;
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
+  auto result =
+      getMatchingStringIds(generation, [&pattern, escape](const std::string& str) {
+        return is_regexp_like(str, pattern, escape);
+      });
+  pattern_cache_.put(cache_key,
+                     std::make_shared<const std::vector<int32_t>>(result),
+                     cache_key.size() + result.size() * sizeof(int32_t));
+  return result;
+}
+
+// Scans the first `generation` strings in chunks on the TBB worker pool. Chunks are
+// contiguous, so the ids come out sorted.
+std::vector<int32_t> StringDictionary::getMatchingStringIds(
+    const size_t generation,
+    const std::function<bool(const std::string&)>& matches) const {
+  constexpr size_t kChunkSize{16384};
+  const size_t chunk_count = (generation + kChunkSize - 1) / kChunkSize;
+  std::vector<std::vector<int32_t>> chunk_results(chunk_count);
+  auto scan_chunk = [this, generation, &matches, &chunk_results](const size_t chunk_idx) {
+    const size_t chunk_end = std::min((chunk_idx + 1) * kChunkSize, generation);
+    for (size_t string_id = chunk_idx * kChunkSize; string_id < chunk_end; ++string_id) {
+      if (matches(getStringUnlocked(string_id))) {
+        chunk_results[chunk_idx].push_back(string_id);
       }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
+    }
+  };
+  if (chunk_count > 1) {
+    tbb::parallel_for(size_t(0), chunk_count, scan_chunk);
+  } else if (chunk_count == 1) {
+    scan_chunk(0);
   }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
+  std::vector<int32_t> result;
+  for (const auto& chunk_result : chunk_results) {
+    result.insert(result.end(), chunk_result.begin(), chunk_result.end());
   }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
-
   return result;
 }
 
@@ -1352,15 +1310,8 @@ void* StringDictionary::addMemoryCapacity(void* addr,
 }
 
 void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_cache_.empty()) {
-    decltype(like_cache_)().swap(like_cache_);
-  }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
-  }
-  if (!equal_cache_.empty()) {
-    decltype(equal_cache_)().swap(equal_cache_);
-  }
+  pattern_cache_.clear();
+  equal_cache_.clear();
   compare_cache_.invalidateInvertedIndex();
 }
 
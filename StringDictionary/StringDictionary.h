@@ -21,7 +21,9 @@
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
 #include "LeafHostInfo.h"
+#include "ShardedLruCache.hpp"
 
+#include <functional>
 #include <future>
 #include <map>
 #include <string>
@@ -29,6 +31,7 @@
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern size_t g_stringdict_pattern_cache_bytes;
 
 class StringDictionaryClient;
 
@@ -110,6 +113,9 @@ class StringDictionary {
       const std::vector<std::vector<int32_t>>& source_array_ids,
       const StringDictionary* source_dict);
 
+  using PatternCacheStats = ShardedLruCache<std::string, std::vector<int32_t>>::Stats;
+  PatternCacheStats getPatternCacheStats() const { return pattern_cache_.getStats(); }
+
   static constexpr int32_t INVALID_STR_ID = -1;
   static constexpr size_t MAX_STRLEN = (1 << 15) - 1;
   static constexpr size_t MAX_STRCOUNT = (1U << 31) - 1;
@@ -189,6 +195,9 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  std::vector<int32_t> getMatchingStringIds(
+      const size_t generation,
+      const std::function<bool(const std::string&)>& matches) const;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -214,10 +223,11 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable mapd_shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
-      like_cache_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
-  mutable std::map<std::string, int32_t> equal_cache_;
+  // LIKE and REGEXP results, keyed by the pattern and its matching options.
+  mutable ShardedLruCache<std::string, std::vector<int32_t>> pattern_cache_{
+      g_stringdict_pattern_cache_bytes};
+  mutable ShardedLruCache<std::string, int32_t> equal_cache_{
+      g_stringdict_pattern_cache_bytes / 16};
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
   std::unique_ptr<StringDictionaryClient> client_;
@@ -409,6 +409,50 @@ TEST_F(ArrowIpcBasic, IpcCpu) {
   deallocate_df(data_frame, ExecutorDeviceType::CPU);
 }
 
+TEST_F(ArrowIpcBasic, IpcCpuBooleanAndTimestamp) {
+  run_ddl_statement("DROP TABLE IF EXISTS arrow_ipc_bool_ts_test;");
+  run_ddl_statement("CREATE TABLE arrow_ipc_bool_ts_test(b BOOLEAN, ts TIMESTAMP(0));");
+  run_ddl_statement(
+      "INSERT INTO arrow_ipc_bool_ts_test VALUES ('true', '2020-01-01 00:00:00');");
+  run_ddl_statement("INSERT INTO arrow_ipc_bool_ts_test VALUES (NULL, NULL);");
+  run_ddl_statement(
+      "INSERT INTO arrow_ipc_bool_ts_test VALUES ('false', '1970-01-01 00:00:01');");
+
+  auto data_frame = execute_arrow_ipc("SELECT b, ts FROM arrow_ipc_bool_ts_test;",
+                                      ExecutorDeviceType::CPU);
+  auto df =
+      ArrowOutput(data_frame, ExecutorDeviceType::CPU, TArrowTransport::SHARED_MEMORY);
+  ASSERT_EQ(df.schema->num_fields(), 2);
+
+  // boolean column
+  auto bool_array = df.record_batch->column(0);
+  ASSERT_EQ(bool_array->type()->id(), arrow::Type::type::BOOL);
+  std::shared_ptr<arrow::Array> bool_truth_array;
+  {
+    arrow::BooleanBuilder builder(arrow::default_memory_pool());
+    ARROW_THROW_NOT_OK(builder.AppendValues(std::vector<bool>{true, false, false},
+                                            std::vector<bool>{1, 0, 1}));
+    ARROW_THROW_NOT_OK(builder.Finish(&bool_truth_array));
+  }
+  ASSERT_TRUE(bool_array->Equals(bool_truth_array));
+
+  // timestamp column
+  auto ts_array = df.record_batch->column(1);
+  ASSERT_EQ(ts_array->type()->id(), arrow::Type::type::TIMESTAMP);
+  std::shared_ptr<arrow::Array> ts_truth_array;
+  {
+    arrow::TimestampBuilder builder(arrow::timestamp(arrow::TimeUnit::SECOND),
+                                    arrow::default_memory_pool());
+    ARROW_THROW_NOT_OK(builder.AppendValues(std::vector<int64_t>{1577836800, 0, 1},
+                                            std::vector<bool>{1, 0, 1}));
+    ARROW_THROW_NOT_OK(builder.Finish(&ts_truth_array));
+  }
+  ASSERT_TRUE(ts_array->Equals(ts_truth_array));
+
+  deallocate_df(data_frame, ExecutorDeviceType::CPU);
+  run_ddl_statement("DROP TABLE IF EXISTS arrow_ipc_bool_ts_test;");
+}
+
 TEST_F(ArrowIpcBasic, IpcCpuScalarValues) {
   auto data_frame =
       execute_arrow_ipc("SELECT * FROM test_data_scalars;", ExecutorDeviceType::CPU);
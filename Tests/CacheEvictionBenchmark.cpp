@@ -0,0 +1,185 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file CacheEvictionBenchmark.cpp
+ * @brief Hit rates of the cache eviction algorithms on replayed chunk access traces
+ *
+ * The traces are generated with a fixed seed, so every run replays the same accesses.
+ * A recorded trace, one comma separated chunk key per line, can be replayed as well by
+ * pointing the CACHE_EVICTION_TRACE environment variable at it.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <set>
+
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/CacheEvictionAlgorithm.h"
+#include "Shared/StringTransform.h"
+
+namespace {
+
+struct Trace {
+  std::vector<ChunkKey> accesses;
+  size_t capacity;
+};
+
+ChunkKey make_key(const int column_id, const int fragment_id) {
+  return {1, 1, column_id, fragment_id};
+}
+
+// Dashboard queries over a hot set of fragments, interrupted by full scans of a large
+// table which is never read again.
+Trace dashboard_with_scans_trace() {
+  constexpr int kHotFragmentCount{400};
+  constexpr int kScanFragmentCount{4000};
+  Trace trace{{}, 1000};
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> hot_dist(0, kHotFragmentCount - 1);
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 5000; ++i) {
+      trace.accesses.push_back(make_key(1, hot_dist(gen)));
+    }
+    for (int fragment_id = 0; fragment_id < kScanFragmentCount; ++fragment_id) {
+      trace.accesses.push_back(make_key(2, round * kScanFragmentCount + fragment_id));
+    }
+  }
+  return trace;
+}
+
+// Zipf-like skew over fragments, without scans.
+Trace skewed_trace() {
+  constexpr int kFragmentCount{10000};
+  Trace trace{{}, 1000};
+  std::vector<double> weights;
+  for (int i = 1; i <= kFragmentCount; ++i) {
+    weights.push_back(1.0 / i);
+  }
+  std::mt19937 gen(2);
+  std::discrete_distribution<int> dist(weights.begin(), weights.end());
+  for (int i = 0; i < 200000; ++i) {
+    trace.accesses.push_back(make_key(1, dist(gen)));
+  }
+  return trace;
+}
+
+// Repeated scans of a table slightly larger than the cache, which defeats LRU.
+Trace looping_scan_trace() {
+  Trace trace{{}, 1000};
+  for (int round = 0; round < 100; ++round) {
+    for (int fragment_id = 0; fragment_id < 1200; ++fragment_id) {
+      trace.accesses.push_back(make_key(1, fragment_id));
+    }
+  }
+  return trace;
+}
+
+Trace recorded_trace() {
+  Trace trace{{}, 0};
+  const char* path = std::getenv("CACHE_EVICTION_TRACE");
+  if (!path) {
+    return trace;
+  }
+  std::ifstream in(path);
+  std::string line;
+  std::set<ChunkKey> distinct_keys;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    ChunkKey key;
+    for (const auto& sub_key : split(line, ",")) {
+      key.push_back(std::stoi(sub_key));
+    }
+    distinct_keys.insert(key);
+    trace.accesses.push_back(std::move(key));
+  }
+  // Without a recorded capacity, give the cache a tenth of the distinct chunks.
+  const char* capacity = std::getenv("CACHE_EVICTION_TRACE_CAPACITY");
+  trace.capacity =
+      capacity ? std::stoul(capacity) : std::max(size_t(1), distinct_keys.size() / 10);
+  return trace;
+}
+
+const Trace& get_trace(const int64_t trace_id) {
+  static const std::vector<Trace> traces{dashboard_with_scans_trace(),
+                                         skewed_trace(),
+                                         looping_scan_trace(),
+                                         recorded_trace()};
+  return traces.at(trace_id);
+}
+
+const std::vector<std::string> kTraceNames{"dashboard_with_scans",
+                                           "skewed",
+                                           "looping_scan",
+                                           "recorded"};
+
+// Replays the trace against a cache holding up to trace.capacity chunks and returns
+// the number of hits.
+size_t replay(const Trace& trace, const EvictionPolicy policy) {
+  auto alg = create_eviction_algorithm(policy);
+  std::set<ChunkKey> cached_keys;
+  size_t hit_count{0};
+  for (const auto& key : trace.accesses) {
+    if (cached_keys.count(key)) {
+      ++hit_count;
+    } else {
+      if (cached_keys.size() >= trace.capacity) {
+        cached_keys.erase(alg->evictNextChunk());
+      }
+      cached_keys.insert(key);
+    }
+    alg->touchChunk(key);
+  }
+  return hit_count;
+}
+
+}  // namespace
+
+//! Replay a trace with the given policy. The arguments are the trace and the policy.
+static void BM_ReplayTrace(benchmark::State& state) {
+  const auto& trace = get_trace(state.range(0));
+  const auto policy = static_cast<EvictionPolicy>(state.range(1));
+  if (trace.accesses.empty()) {
+    state.SkipWithError("CACHE_EVICTION_TRACE is not set");
+    return;
+  }
+  size_t hit_count{0};
+  for (auto _ : state) {
+    hit_count = replay(trace, policy);
+  }
+  state.SetLabel(kTraceNames[state.range(0)] +
+                 (policy == EvictionPolicy::LRU ? "/lru" : "/2q"));
+  state.SetItemsProcessed(state.iterations() * trace.accesses.size());
+  state.counters["hit_rate"] =
+      static_cast<double>(hit_count) / static_cast<double>(trace.accesses.size());
+}
+
+static void replay_trace_args(benchmark::internal::Benchmark* b) {
+  for (int64_t trace_id = 0; trace_id < static_cast<int64_t>(kTraceNames.size());
+       ++trace_id) {
+    for (const auto policy : {EvictionPolicy::LRU, EvictionPolicy::TWO_QUEUE}) {
+      b->Args({trace_id, static_cast<int64_t>(policy)});
+    }
+  }
+}
+
+BENCHMARK(BM_ReplayTrace)->Apply(replay_trace_args)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
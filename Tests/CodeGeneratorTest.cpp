@@ -16,7 +16,10 @@
 
 #include <gtest/gtest.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <boost/filesystem.hpp>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/SourceMgr.h>
@@ -24,11 +27,15 @@
 
 #include "Analyzer/Analyzer.h"
 #include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/DiskCodeCache.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/IRCodegenUtils.h"
 #include "QueryEngine/LLVMGlobalContext.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
+extern bool g_enable_persistent_code_cache;
+
 TEST(CodeGeneratorTest, IntegerConstant) {
   auto& ctx = getGlobalLLVMContext();
   std::unique_ptr<llvm::Module> module(read_template_module(ctx));
@@ -137,6 +144,111 @@ TEST(CodeGeneratorTest, IntegerExpr) {
   ASSERT_EQ(out, 100);
 }
 
+namespace {
+
+llvm::Function* make_constant_function(const int32_t val) {
+  auto& ctx = getGlobalLLVMContext();
+  auto module = new llvm::Module("constant", ctx);
+  auto func = llvm::Function::Create(
+      llvm::FunctionType::get(llvm::Type::getInt32Ty(ctx), false),
+      llvm::Function::ExternalLinkage,
+      "constant_func",
+      module);
+  llvm::IRBuilder<> ir_builder(llvm::BasicBlock::Create(ctx, "entry", func));
+  ir_builder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), val));
+  return func;
+}
+
+}  // namespace
+
+TEST(CodeGeneratorTest, PersistentCodeCache) {
+  const auto cache_root =
+      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  ScopeGuard remove_cache_root = [&cache_root] {
+    boost::filesystem::remove_all(cache_root);
+  };
+  const auto enable_persistent_code_cache = g_enable_persistent_code_cache;
+  g_enable_persistent_code_cache = true;
+  DiskCodeCache::init(cache_root.string());
+  ScopeGuard reset_cache = [enable_persistent_code_cache] {
+    g_enable_persistent_code_cache = enable_persistent_code_cache;
+    DiskCodeCache::init("");
+  };
+  auto disk_code_cache = DiskCodeCache::get();
+  ASSERT_TRUE(disk_code_cache);
+
+  CompilationOptions co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+  using FuncPtr = int32_t (*)();
+  const auto compile = [&](const int32_t val, const bool expect_hit) {
+    auto func = make_constant_function(val);
+    const CodeCacheKey key{serialize_llvm_object(func)};
+    auto entry = disk_code_cache->prepareModule(func->getParent(), key);
+    ASSERT_EQ(entry->hasObject(), expect_hit);
+    auto execution_engine =
+        CodeGenerator::generateNativeCPUCode(func, {func}, co, entry.get());
+    auto func_ptr =
+        reinterpret_cast<FuncPtr>(execution_engine->getPointerToFunction(func));
+    ASSERT_TRUE(func_ptr);
+    ASSERT_EQ(func_ptr(), val);
+  };
+  // The first compilation writes the object, the second one loads it instead of
+  // generating code again and the third one, for different IR, misses.
+  compile(42, false);
+  compile(42, true);
+  compile(17, false);
+  ASSERT_EQ(disk_code_cache->getHitCount(), size_t(1));
+  ASSERT_EQ(disk_code_cache->getMissCount(), size_t(2));
+
+  // An entry whose object is gone misses, the module is optimized and stored again.
+  std::vector<boost::filesystem::path> object_paths;
+  for (const auto& entry : boost::filesystem::recursive_directory_iterator(cache_root)) {
+    if (entry.path().extension() == ".o") {
+      object_paths.push_back(entry.path());
+    }
+  }
+  ASSERT_EQ(object_paths.size(), size_t(2));
+  for (const auto& object_path : object_paths) {
+    boost::filesystem::remove(object_path);
+  }
+  compile(42, false);
+  compile(42, true);
+  ASSERT_EQ(disk_code_cache->getHitCount(), size_t(2));
+  ASSERT_EQ(disk_code_cache->getMissCount(), size_t(3));
+  ASSERT_EQ(disk_code_cache->getWriteErrorCount(), size_t(0));
+}
+
+TEST(CodeGeneratorTest, TieredCompilation) {
+  CompilationOptions co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+  using FuncPtr = int32_t (*)();
+  auto func = make_constant_function(42);
+  // the optimizing tier gets the module before the baseline pipeline changes it
+  std::string bitcode;
+  llvm::raw_string_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(*func->getParent(), os);
+  os.flush();
+  const auto entry_name = func->getName().str();
+
+  CpuCompilationContext cpu_compilation_context(
+      CodeGenerator::generateNativeCPUCode(func, {func}, co));
+  cpu_compilation_context.setFunctionPointer(func);
+  const auto baseline_func_ptr = cpu_compilation_context.func();
+  ASSERT_EQ(reinterpret_cast<FuncPtr>(baseline_func_ptr)(), 42);
+  ASSERT_FALSE(cpu_compilation_context.isOptimized());
+
+  ASSERT_FALSE(cpu_compilation_context.recordCacheHit(2));
+  ASSERT_TRUE(cpu_compilation_context.recordCacheHit(2));
+  cpu_compilation_context.setTierUpRequested();
+  ASSERT_FALSE(cpu_compilation_context.recordCacheHit(2));
+
+  CodeGenerator::tierUpCPUCode(
+      bitcode, entry_name, {entry_name}, co, cpu_compilation_context);
+  ASSERT_TRUE(cpu_compilation_context.isOptimized());
+  ASSERT_NE(cpu_compilation_context.func(), baseline_func_ptr);
+  ASSERT_EQ(reinterpret_cast<FuncPtr>(cpu_compilation_context.func())(), 42);
+  // still alive for the kernels which loaded it before the swap
+  ASSERT_EQ(reinterpret_cast<FuncPtr>(baseline_func_ptr)(), 42);
+}
+
 #ifdef HAVE_CUDA
 void free_param_pointers(const std::vector<void*>& param_ptrs,
                          CudaMgr_Namespace::CudaMgr* cuda_mgr) {
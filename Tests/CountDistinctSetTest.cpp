@@ -0,0 +1,115 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file CountDistinctSetTest.cpp
+ * @brief Test suite for the exact COUNT(DISTINCT) set
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <set>
+
+#include "QueryEngine/CountDistinct.h"
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+#include "QueryEngine/Execute.h"
+#include "TestHelpers.h"
+
+class CountDistinctSetTest : public ::testing::Test {
+ protected:
+  RowSetMemoryOwner row_set_mem_owner_{Executor::getArenaBlockSize()};
+
+  // Inserts random values into both sets, covering the hash table growth and, for
+  // more than CountDistinctSet::kMaxTableCapacity / 2 values, the spill to runs.
+  void insertRandom(CountDistinctSet& set,
+                    std::set<int64_t>& expected,
+                    const size_t count,
+                    const int64_t range) {
+    std::mt19937_64 rng(count + range);
+    for (size_t i = 0; i < count; ++i) {
+      const int64_t val = static_cast<int64_t>(rng() % range) - range / 2;
+      set.insert(val);
+      expected.insert(val);
+    }
+  }
+};
+
+TEST_F(CountDistinctSetTest, SmallSet) {
+  auto set = row_set_mem_owner_.makeCountDistinctSet();
+  EXPECT_EQ(set->size(), size_t(0));
+  for (const int64_t val : {3, 1, 3, -7, 1, 0}) {
+    set->insert(val);
+  }
+  EXPECT_EQ(set->size(), size_t(4));
+  EXPECT_EQ(set->compact(), (std::vector<int64_t>{-7, 0, 1, 3}));
+  set->insert(std::numeric_limits<int64_t>::min());
+  set->insert(std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(set->size(), size_t(5));
+}
+
+TEST_F(CountDistinctSetTest, SpillsToRuns) {
+  auto set = row_set_mem_owner_.makeCountDistinctSet();
+  std::set<int64_t> expected;
+  insertRandom(*set, expected, 1000000, int64_t(1) << 40);
+  EXPECT_EQ(set->size(), expected.size());
+  // Values already in the runs must not be counted again.
+  insertRandom(*set, expected, 1000000, int64_t(1) << 40);
+  EXPECT_EQ(set->size(), expected.size());
+  EXPECT_EQ(set->compact(), std::vector<int64_t>(expected.begin(), expected.end()));
+}
+
+TEST_F(CountDistinctSetTest, Union) {
+  CountDistinctDescriptor count_distinct_desc{CountDistinctImplType::StdSet,
+                                              0,
+                                              0,
+                                              false,
+                                              ExecutorDeviceType::CPU,
+                                              1};
+  for (const size_t count : {size_t(100), size_t(500000)}) {
+    auto lhs = row_set_mem_owner_.makeCountDistinctSet();
+    auto rhs = row_set_mem_owner_.makeCountDistinctSet();
+    std::set<int64_t> expected;
+    insertRandom(*lhs, expected, count, 2 * count);
+    insertRandom(*rhs, expected, count, 3 * count);
+    count_distinct_set_union(reinterpret_cast<int64_t>(lhs),
+                             reinterpret_cast<int64_t>(rhs),
+                             count_distinct_desc,
+                             count_distinct_desc);
+    const auto expected_size = static_cast<int64_t>(expected.size());
+    EXPECT_EQ(
+        count_distinct_set_size(reinterpret_cast<int64_t>(lhs), count_distinct_desc),
+        expected_size);
+    EXPECT_EQ(
+        count_distinct_set_size(reinterpret_cast<int64_t>(rhs), count_distinct_desc),
+        expected_size);
+  }
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
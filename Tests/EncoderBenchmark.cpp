@@ -0,0 +1,188 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file EncoderBenchmark.cpp
+ * @brief Chunk stats of fixed width encoders, vectorized kernels vs. a scalar loop
+ *
+ * The appendData benchmarks write to a buffer which drops the data, so that they
+ * measure the encoding and the stats only.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/Encoder.h"
+#include "DataMgr/EncoderKernels.h"
+#include "DataMgr/NoneEncoder.h"
+#include "Logger/Logger.h"
+
+namespace {
+
+using MemoryLevel = Data_Namespace::MemoryLevel;
+
+constexpr size_t kBatchSize{64 * 1024};
+
+class DiscardingBuffer : public Data_Namespace::AbstractBuffer {
+ public:
+  DiscardingBuffer(const SQLTypeInfo sql_type) : AbstractBuffer(0, sql_type) {}
+
+  void read(int8_t* const dst,
+            const size_t num_bytes,
+            const size_t offset,
+            const MemoryLevel dst_buffer_type,
+            const int dst_device_id) override {
+    UNREACHABLE();
+  }
+
+  void write(int8_t* src,
+             const size_t num_bytes,
+             const size_t offset,
+             const MemoryLevel src_buffer_type,
+             const int src_device_id) override {
+    UNREACHABLE();
+  }
+
+  void reserve(size_t num_bytes) override { UNREACHABLE(); }
+
+  void append(int8_t* src,
+              const size_t num_bytes,
+              const MemoryLevel src_buffer_type,
+              const int device_id) override {
+    benchmark::DoNotOptimize(src);
+  }
+
+  int8_t* getMemoryPtr() override {
+    UNREACHABLE();
+    return nullptr;
+  }
+
+  size_t pageCount() const override { return 0; }
+
+  size_t pageSize() const override { return 0; }
+
+  size_t reservedSize() const override { return 0; }
+
+  MemoryLevel getType() const override { return Data_Namespace::CPU_LEVEL; }
+};
+
+// Values in [-1000, 1000], with one null in a hundred
+template <typename T>
+std::vector<T> make_values(const size_t num_values, const T null_val) {
+  std::vector<T> values(num_values);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  for (auto& val : values) {
+    val = gen() % 100 == 0 ? null_val : static_cast<T>(dist(gen));
+  }
+  return values;
+}
+
+template <typename T>
+void update_stats_scalar(const T* values,
+                         const size_t num_values,
+                         const T null_val,
+                         T& min,
+                         T& max,
+                         bool& has_nulls) {
+  for (size_t i = 0; i < num_values; ++i) {
+    if (values[i] == null_val) {
+      has_nulls = true;
+    } else {
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+    }
+  }
+}
+
+template <typename T>
+void update_stats_benchmark(benchmark::State& state, const bool vectorized) {
+  const auto null_val = none_encoded_null_value<T>();
+  const auto values = make_values<T>(state.range(0), null_val);
+  for (auto _ : state) {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    bool has_nulls{false};
+    if (vectorized) {
+      encoder_kernels::update_stats(
+          values.data(), values.size(), null_val, min, max, has_nulls);
+    } else {
+      update_stats_scalar(values.data(), values.size(), null_val, min, max, has_nulls);
+    }
+    benchmark::DoNotOptimize(min);
+    benchmark::DoNotOptimize(max);
+    benchmark::DoNotOptimize(has_nulls);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// Appends the values in batches, the way the importer loads a chunk
+template <typename T>
+void append_data_benchmark(benchmark::State& state,
+                           const SQLTypeInfo& ti,
+                           const T null_val) {
+  const auto values = make_values<T>(state.range(0), null_val);
+  for (auto _ : state) {
+    DiscardingBuffer buffer(ti);
+    for (size_t i = 0; i < values.size(); i += kBatchSize) {
+      auto src = reinterpret_cast<int8_t*>(const_cast<T*>(values.data() + i));
+      buffer.getEncoder()->appendData(
+          src, std::min(kBatchSize, values.size() - i), ti, false, -1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_UpdateStatsInt32(benchmark::State& state, const bool vectorized) {
+  update_stats_benchmark<int32_t>(state, vectorized);
+}
+
+void BM_UpdateStatsInt64(benchmark::State& state, const bool vectorized) {
+  update_stats_benchmark<int64_t>(state, vectorized);
+}
+
+void BM_UpdateStatsDouble(benchmark::State& state, const bool vectorized) {
+  update_stats_benchmark<double>(state, vectorized);
+}
+
+void BM_AppendIntNone(benchmark::State& state) {
+  append_data_benchmark<int32_t>(
+      state, SQLTypeInfo(kINT, false), inline_int_null_value<int32_t>());
+}
+
+void BM_AppendBigintFixed32(benchmark::State& state) {
+  SQLTypeInfo ti(kBIGINT, false, kENCODING_FIXED);
+  ti.set_comp_param(32);
+  append_data_benchmark<int64_t>(state, ti, inline_int_null_value<int32_t>());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_UpdateStatsInt32, scalar, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_UpdateStatsInt32, vectorized, true)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_UpdateStatsInt64, scalar, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_UpdateStatsInt64, vectorized, true)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_UpdateStatsDouble, scalar, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_UpdateStatsDouble, vectorized, true)->Arg(1 << 20);
+BENCHMARK(BM_AppendIntNone)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AppendBigintFixed32)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
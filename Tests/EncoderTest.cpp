@@ -21,10 +21,14 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <numeric>
+#include <random>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/Encoder.h"
+#include "DataMgr/EncoderKernels.h"
 #include "DataMgr/MemoryLevel.h"
+#include "DataMgr/NoneEncoder.h"
 #include "Shared/DatumFetchers.h"
 #include "TestHelpers.h"
 
@@ -342,6 +346,102 @@ TYPED_TEST(FixedLengthEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+// Long enough for the vectorized blocks of every type, plus an unaligned tail
+constexpr size_t kKernelTestSize{3 * 64 + 13};
+
+template <typename T>
+std::vector<T> make_kernel_test_data(const T null_val) {
+  std::vector<T> data(kKernelTestSize);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 17 == 5 ? null_val : static_cast<T>(dist(gen));
+  }
+  return data;
+}
+
+template <typename T>
+class EncoderKernelsTest : public testing::Test {};
+
+using EncoderKernelsTypes =
+    testing::Types<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, float, double>;
+TYPED_TEST_SUITE(EncoderKernelsTest, EncoderKernelsTypes);
+
+TYPED_TEST(EncoderKernelsTest, UpdateStatsMatchesScalarLoop) {
+  using T = TypeParam;
+  const auto null_val = none_encoded_null_value<T>();
+  const auto data = make_kernel_test_data<T>(null_val);
+  // every prefix, so that each tail length and a block without nulls are covered
+  for (size_t num_values = 0; num_values <= data.size(); ++num_values) {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    bool has_nulls{false};
+    encoder_kernels::update_stats(data.data(), num_values, null_val, min, max, has_nulls);
+    T expected_min = std::numeric_limits<T>::max();
+    T expected_max = std::numeric_limits<T>::lowest();
+    bool expected_has_nulls{false};
+    for (size_t i = 0; i < num_values; ++i) {
+      if (data[i] == null_val) {
+        expected_has_nulls = true;
+      } else {
+        expected_min = std::min(expected_min, data[i]);
+        expected_max = std::max(expected_max, data[i]);
+      }
+    }
+    ASSERT_EQ(min, expected_min) << num_values;
+    ASSERT_EQ(max, expected_max) << num_values;
+    ASSERT_EQ(has_nulls, expected_has_nulls) << num_values;
+  }
+}
+
+TEST(EncoderKernels, Narrow) {
+  auto data = make_kernel_test_data<int64_t>(inline_int_null_value<int8_t>());
+  std::vector<int8_t> narrowed(data.size());
+  ASSERT_TRUE(encoder_kernels::narrow(data.data(), data.size(), narrowed.data()));
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(narrowed[i], data[i]);
+  }
+  // in the unaligned tail
+  data.back() = 128;
+  ASSERT_FALSE(encoder_kernels::narrow(data.data(), data.size(), narrowed.data()));
+  data.back() = 0;
+  // in a vectorized block
+  data[1] = std::numeric_limits<int32_t>::min();
+  ASSERT_FALSE(encoder_kernels::narrow(data.data(), data.size(), narrowed.data()));
+}
+
+TEST_F(EncoderUpdateStatsTest, FixedLengthEncoderOutOfRangeValues) {
+  // values that don't fit into the encoded type are left out of the stats
+  auto data = make_kernel_test_data<int64_t>(inline_int_null_value<int16_t>());
+  int64_t expected_min = std::numeric_limits<int64_t>::max();
+  int64_t expected_max = std::numeric_limits<int64_t>::min();
+  for (const auto val : data) {
+    if (val != inline_int_null_value<int16_t>()) {
+      expected_min = std::min(expected_min, val);
+      expected_max = std::max(expected_max, val);
+    }
+  }
+  data[3] = std::numeric_limits<int32_t>::max();
+  data[data.size() - 2] = std::numeric_limits<int32_t>::min();
+  createEncoder(FixedLengthEncoderTraits<int64_t, int16_t>::getSqlType());
+  updateWithData(data);
+  assertExpectedStats<int64_t>(expected_min, expected_max, true);
+}
+
+TEST_F(EncoderUpdateStatsTest, FixedLengthEncoderOutOfRangeValuesInLaterBlock) {
+  // the values are encoded in blocks, only the block with the out of range value takes
+  // the per value path
+  std::vector<int32_t> data(200000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int32_t>(i % 1000) - 500;
+  }
+  data[150000] = std::numeric_limits<int16_t>::max() + 1;
+  data[150001] = inline_int_null_value<int16_t>();
+  createEncoder(FixedLengthEncoderTraits<int32_t, int16_t>::getSqlType());
+  updateWithData(data);
+  assertExpectedStats<int32_t>(-500, 499, true);
+}
+
 template <typename T, typename V>
 struct DateDaysEncoderTraits {
   inline static SQLTypeInfo getSqlType() {
@@ -763,6 +863,112 @@ TYPED_TEST(FixedLengthArrayNoneEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+class EncoderValueSketchTest : public EncoderUpdateStatsTest {
+ protected:
+  // updateStats does not track the element count, set it to what appendData would
+  template <typename T>
+  void appendToSketch(const std::vector<T>& data) {
+    auto encoder = buffer_->getEncoder();
+    updateWithData(data);
+    encoder->setNumElems(encoder->getNumElems() + data.size());
+  }
+
+  std::shared_ptr<const ChunkValueSketch> getSketch() {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    buffer_->getEncoder()->getMetadata(chunk_metadata);
+    return chunk_metadata->valueSketch;
+  }
+};
+
+TEST(ChunkValueSketch, NoFalseNegatives) {
+  ChunkValueSketch sketch;
+  for (int64_t val = 0; val < 2000; ++val) {
+    sketch.add(val * 7919);
+  }
+  size_t false_positives{0};
+  for (int64_t val = 0; val < 2000; ++val) {
+    ASSERT_TRUE(sketch.mayContain(val * 7919));
+    false_positives += sketch.mayContain(val * 7919 + 1);
+  }
+  ASSERT_LT(false_positives, size_t(100));
+  ASSERT_NEAR(sketch.approxDistinctCount(), 2000, 200);
+  ASSERT_FALSE(sketch.isSaturated());
+}
+
+TEST(ChunkValueSketch, Merge) {
+  ChunkValueSketch lhs;
+  ChunkValueSketch rhs;
+  lhs.add(1);
+  rhs.add(-1);
+  lhs.merge(rhs);
+  ASSERT_TRUE(lhs.mayContain(1));
+  ASSERT_TRUE(lhs.mayContain(-1));
+  ASSERT_EQ(lhs.approxDistinctCount(), size_t(2));
+}
+
+TEST_F(EncoderValueSketchTest, BuiltFromAppendedValues) {
+  createEncoder(kBIGINT);
+  buffer_->getEncoder()->enableValueSketch();
+  appendToSketch(std::vector<int64_t>{10, 20, inline_int_null_value<int64_t>(), 40});
+  const auto sketch = getSketch();
+  ASSERT_TRUE(sketch);
+  ASSERT_TRUE(sketch->mayContain(10));
+  ASSERT_TRUE(sketch->mayContain(40));
+  ASSERT_EQ(sketch->approxDistinctCount(), size_t(3));
+}
+
+TEST_F(EncoderValueSketchTest, DictEncodedString) {
+  SQLTypeInfo ti(kTEXT, false, kENCODING_DICT);
+  ti.set_size(2);
+  createEncoder(ti);
+  buffer_->getEncoder()->enableValueSketch();
+  appendToSketch(std::vector<uint16_t>{3, 5});
+  const auto sketch = getSketch();
+  ASSERT_TRUE(sketch);
+  ASSERT_TRUE(sketch->mayContain(3));
+  ASSERT_TRUE(sketch->mayContain(5));
+}
+
+TEST_F(EncoderValueSketchTest, UnsupportedType) {
+  createEncoder(kDOUBLE);
+  buffer_->getEncoder()->enableValueSketch();
+  appendToSketch(std::vector<double>{1.5});
+  ASSERT_FALSE(getSketch());
+}
+
+TEST_F(EncoderValueSketchTest, NotBuiltUnlessEnabled) {
+  createEncoder(kINT);
+  appendToSketch(std::vector<int32_t>{1, 2});
+  ASSERT_FALSE(getSketch());
+}
+
+TEST_F(EncoderValueSketchTest, DroppedOnInPlaceUpdate) {
+  createEncoder(kINT);
+  buffer_->getEncoder()->enableValueSketch();
+  appendToSketch(std::vector<int32_t>{1, 2});
+  ASSERT_TRUE(getSketch());
+  // in-place updates only report the new min/max, the sketch can no longer be trusted
+  buffer_->getEncoder()->updateStats(int64_t(100), false);
+  ASSERT_FALSE(getSketch());
+}
+
+TEST_F(EncoderValueSketchTest, DroppedOnElementCountMismatch) {
+  createEncoder(kINT);
+  buffer_->getEncoder()->enableValueSketch();
+  appendToSketch(std::vector<int32_t>{1, 2});
+  buffer_->getEncoder()->setNumElems(3);
+  ASSERT_FALSE(getSketch());
+}
+
+TEST_F(EncoderValueSketchTest, DroppedWhenSaturated) {
+  createEncoder(kBIGINT);
+  buffer_->getEncoder()->enableValueSketch();
+  std::vector<int64_t> data(4 * ChunkValueSketch::kMaxUsefulDistinctCount);
+  std::iota(data.begin(), data.end(), 0);
+  appendToSketch(data);
+  ASSERT_FALSE(getSketch());
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
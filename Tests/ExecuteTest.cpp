@@ -52,12 +52,16 @@ extern bool g_allow_cpu_retry;
 extern bool g_enable_watchdog;
 extern bool g_skip_intermediate_count;
 extern bool g_use_tbb_pool;
+extern bool g_enable_kernel_scheduler;
+extern size_t g_kernel_scheduler_min_morsel_rows;
+extern size_t g_chunk_prefetch_fragment_count;
 
 extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_overlaps_hashjoin;
 extern double g_gpu_mem_limit_percent;
 
 extern bool g_enable_window_functions;
+extern size_t g_parallel_window_partition_compute_threshold;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
@@ -1305,6 +1309,28 @@ TEST(Select, FilterAndSimpleAggregation) {
   }
 }
 
+TEST(Select, KernelSchedulerMorsels) {
+  const auto enable_kernel_scheduler = g_enable_kernel_scheduler;
+  const auto min_morsel_rows = g_kernel_scheduler_min_morsel_rows;
+  ScopeGuard reset_kernel_scheduler = [enable_kernel_scheduler, min_morsel_rows] {
+    g_enable_kernel_scheduler = enable_kernel_scheduler;
+    g_kernel_scheduler_min_morsel_rows = min_morsel_rows;
+  };
+  // every fragment of test is split into single row morsels
+  g_enable_kernel_scheduler = true;
+  g_kernel_scheduler_min_morsel_rows = 1;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*), SUM(x), MIN(y), MAX(z), AVG(f) FROM test;", dt);
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", dt);
+  c("SELECT x, COUNT(*), SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+  c("SELECT str, COUNT(DISTINCT y) FROM test GROUP BY str ORDER BY str;", dt);
+  c("SELECT COUNT(*), SUM(b.y) FROM test a, test_inner b WHERE a.x = b.x;", dt);
+  // projections and rowid lookups run a kernel per fragment
+  c("SELECT x, y FROM test ORDER BY x, y;", dt);
+  ASSERT_EQ(int64_t(19),
+            v<int64_t>(run_simple_agg("SELECT rowid FROM test WHERE rowid = 19;", dt)));
+}
+
 TEST(Select, AggregateOnEmptyDecimalColumn) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -18864,6 +18890,85 @@ TEST(Select, DatesDaysEncodingTest) {
   }
 }
 
+TEST(Create, PackedEncodingDDL) {
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS packed_enc;"));
+  EXPECT_NO_THROW(run_ddl_statement(
+      "CREATE TABLE packed_enc(a INT ENCODING RL, b BIGINT ENCODING DIFF, c TIMESTAMP "
+      "ENCODING RL, d DATE ENCODING DIFF);"));
+  EXPECT_THROW(run_ddl_statement("CREATE TABLE packed_enc1(a DOUBLE ENCODING RL);"),
+               std::runtime_error);
+  EXPECT_THROW(run_ddl_statement("CREATE TABLE packed_enc1(a TEXT ENCODING DIFF);"),
+               std::runtime_error);
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE packed_enc;"));
+}
+
+TEST(Select, PackedEncodings) {
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS packed_enc;"));
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS packed_enc_dim;"));
+  EXPECT_NO_THROW(run_ddl_statement(
+      "CREATE TABLE packed_enc(id INT, a SMALLINT ENCODING RL, b INT ENCODING DIFF, "
+      "c BIGINT ENCODING DIFF, d TIMESTAMP ENCODING RL) WITH (fragment_size = 4, "
+      "vacuum = 'immediate');"));
+  EXPECT_NO_THROW(run_ddl_statement(
+      "CREATE TABLE packed_enc_dim(b INT ENCODING DIFF, name TEXT ENCODING DICT);"));
+  for (int i = 0; i < 10; ++i) {
+    const auto a = i < 5 ? "1" : i == 7 ? "NULL" : "2";
+    const auto b = i == 3 ? "NULL" : std::to_string(1000 + i * i);
+    const auto c = std::to_string(-5000000000LL + i);
+    run_multiple_agg("INSERT INTO packed_enc VALUES(" + std::to_string(i) + ", " + a +
+                         ", " + b + ", " + c + ", '2020-01-0" + (i < 6 ? "1" : "2") +
+                         " 00:00:00');",
+                     ExecutorDeviceType::CPU);
+  }
+  run_multiple_agg("INSERT INTO packed_enc_dim VALUES(1016, 'four');",
+                   ExecutorDeviceType::CPU);
+  run_multiple_agg("INSERT INTO packed_enc_dim VALUES(1049, 'seven');",
+                   ExecutorDeviceType::CPU);
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    ASSERT_EQ(int64_t(5),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM packed_enc WHERE a = 1;", dt)));
+    ASSERT_EQ(int64_t(1),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM packed_enc WHERE a IS NULL;", dt)));
+    ASSERT_EQ(int64_t(1),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM packed_enc WHERE b IS NULL;", dt)));
+    ASSERT_EQ(int64_t(1000 + 81),
+              v<int64_t>(run_simple_agg("SELECT MAX(b) FROM packed_enc;", dt)));
+    ASSERT_EQ(int64_t(10 * -5000000000LL + 45),
+              v<int64_t>(run_simple_agg("SELECT SUM(c) FROM packed_enc;", dt)));
+    ASSERT_EQ(int64_t(4),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM packed_enc WHERE d > '2020-01-01 12:00:00';",
+                  dt)));
+    ASSERT_EQ(int64_t(1000 + 36),
+              v<int64_t>(run_simple_agg("SELECT b FROM packed_enc WHERE id = 6;", dt)));
+    ASSERT_EQ(int64_t(4 + 7),
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(packed_enc.id) FROM packed_enc JOIN packed_enc_dim ON "
+                  "packed_enc.b = packed_enc_dim.b;",
+                  dt)));
+  }
+
+  EXPECT_THROW(run_multiple_agg("UPDATE packed_enc SET a = 3 WHERE id = 1;",
+                                ExecutorDeviceType::CPU),
+               std::runtime_error);
+  // vacuumed right away, which encodes the remaining rows of the fragment again
+  run_multiple_agg("DELETE FROM packed_enc WHERE id < 2;", ExecutorDeviceType::CPU);
+  ASSERT_EQ(int64_t(8),
+            v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM packed_enc;",
+                                      ExecutorDeviceType::CPU)));
+  ASSERT_EQ(int64_t(1000 + 36),
+            v<int64_t>(run_simple_agg("SELECT b FROM packed_enc WHERE id = 6;",
+                                      ExecutorDeviceType::CPU)));
+
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE packed_enc;"));
+  EXPECT_NO_THROW(run_ddl_statement("DROP TABLE packed_enc_dim;"));
+}
+
 TEST(Select, WindowFunctionRank) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   std::string part1 =
@@ -19267,6 +19372,38 @@ TEST(Select, WindowFunctionSum) {
   c(query + " NULLS FIRST;", query + ";", dt);
 }
 
+TEST(Select, WindowFunctionParallelCompute) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  // Every partition goes through the parallel sort and the concurrent evaluation.
+  const auto parallel_threshold = g_parallel_window_partition_compute_threshold;
+  ScopeGuard reset_parallel_threshold = [parallel_threshold] {
+    g_parallel_window_partition_compute_threshold = parallel_threshold;
+  };
+  g_parallel_window_partition_compute_threshold = 1;
+  {
+    std::string part1 =
+        "SELECT x, y, t, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC, t DESC) r1, "
+        "RANK() OVER (PARTITION BY y ORDER BY x ASC) r2, DENSE_RANK() OVER (PARTITION BY "
+        "y ORDER BY x DESC) r3 FROM test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, t ASC, r1 ASC, r2 ASC, r3 ASC;";
+    c(part1 + " NULLS FIRST" + part2, part1 + part2, dt);
+  }
+  {
+    std::string part1 =
+        "SELECT x, y, LAG(x + 5) OVER (PARTITION BY y ORDER BY x ASC, t ASC) l FROM "
+        "test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, l ASC";
+    c(part1 + " NULLS FIRST" + part2 + " NULLS FIRST;", part1 + part2 + ";", dt);
+  }
+  {
+    std::string part1 =
+        "SELECT x, y, SUM(t) OVER (PARTITION BY y ORDER BY x ASC) s FROM "
+        "test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, s ASC";
+    c(part1 + " NULLS FIRST" + part2 + " NULLS FIRST;", part1 + part2 + ";", dt);
+  }
+}
+
 TEST(Select, WindowFunctionComplexExpressions) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   {
@@ -21730,6 +21867,19 @@ int main(int argc, char** argv) {
                          ->default_value(g_use_tbb_pool)
                          ->implicit_value(true),
                      "Use TBB thread pool implementation for query dispatch.");
+  desc.add_options()("use-kernel-scheduler",
+                     po::value<bool>(&g_enable_kernel_scheduler)
+                         ->default_value(g_enable_kernel_scheduler)
+                         ->implicit_value(true),
+                     "Use the work-stealing kernel scheduler for CPU query dispatch.");
+  desc.add_options()("kernel-scheduler-min-morsel-rows",
+                     po::value<size_t>(&g_kernel_scheduler_min_morsel_rows)
+                         ->default_value(g_kernel_scheduler_min_morsel_rows),
+                     "Minimum number of rows of a kernel scheduler morsel.");
+  desc.add_options()("chunk-prefetch-fragment-count",
+                     po::value<size_t>(&g_chunk_prefetch_fragment_count)
+                         ->default_value(g_chunk_prefetch_fragment_count),
+                     "Prefetch chunks this many outer table fragments ahead.");
 
   desc.add_options()(
       "test-help",
@@ -15,6 +15,7 @@
  */
 
 #include "DBHandlerTestHelpers.h"
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/TwoQueueEvictionAlgorithm.h"
 #include "DataMgr/ForeignStorage/ForeignStorageCache.h"
 #include "DataMgr/ForeignStorage/ForeignStorageMgr.h"
 #include "DataMgr/PersistentStorageMgr/PersistentStorageMgr.h"
@@ -534,6 +535,104 @@ TEST_F(ForeignStorageCacheLRUTest, Reorder) {
   ASSERT_THROW(lru_alg.evictNextChunk(), NoEntryFoundException);
 }
 
+class ForeignStorageCache2QTest : public testing::Test {};
+TEST_F(ForeignStorageCache2QTest, NewChunksAreFifo) {
+  TwoQueueEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  // No other chunk came in in between, so this touch is correlated with the first one.
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.touchChunk(chunk_key3);
+  ASSERT_FALSE(alg.isInMainQueue(chunk_key1));
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key3);
+  ASSERT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+}
+
+TEST_F(ForeignStorageCache2QTest, LaterTouchPromotes) {
+  TwoQueueEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.touchChunk(chunk_key3);
+  alg.touchChunk(chunk_key1);
+  ASSERT_TRUE(alg.isInMainQueue(chunk_key1));
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key3);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+}
+
+TEST_F(ForeignStorageCache2QTest, GhostHitPromotes) {
+  TwoQueueEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  alg.touchChunk(chunk_key1);
+  ASSERT_TRUE(alg.isInMainQueue(chunk_key1));
+  ASSERT_FALSE(alg.isInMainQueue(chunk_key2));
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+}
+
+TEST_F(ForeignStorageCache2QTest, ScanDoesNotEvictMainQueue) {
+  TwoQueueEvictionAlgorithm alg{};
+  // Promote chunk_key1 and chunk_key2 through the ghost queue.
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  alg.touchChunk(chunk_key3);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  alg.touchChunk(chunk_key1);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key2);
+  alg.touchChunk(chunk_key2);
+  // Scan, evicting a chunk for every new one.
+  for (int frag_id = 1; frag_id <= 100; ++frag_id) {
+    alg.touchChunk({1, 1, 1, frag_id});
+    const auto evicted = alg.evictNextChunk();
+    ASSERT_NE(evicted, chunk_key1);
+    ASSERT_NE(evicted, chunk_key2);
+  }
+  ASSERT_TRUE(alg.isInMainQueue(chunk_key1));
+  ASSERT_TRUE(alg.isInMainQueue(chunk_key2));
+}
+
+TEST_F(ForeignStorageCache2QTest, RemoveChunkForgetsGhost) {
+  TwoQueueEvictionAlgorithm alg{};
+  alg.touchChunk(chunk_key1);
+  alg.touchChunk(chunk_key2);
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  alg.removeChunk(chunk_key1);
+  alg.removeChunk(chunk_key2);
+  alg.touchChunk(chunk_key1);
+  ASSERT_FALSE(alg.isInMainQueue(chunk_key1));
+  ASSERT_EQ(alg.evictNextChunk(), chunk_key1);
+  ASSERT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+}
+
+TEST_F(ForeignStorageCache2QTest, EvictionOrderMatchesEvictions) {
+  TwoQueueEvictionAlgorithm alg{};
+  for (int frag_id = 0; frag_id < 8; ++frag_id) {
+    alg.touchChunk({1, 1, 1, frag_id});
+  }
+  for (int i = 0; i < 3; ++i) {
+    alg.touchChunk(alg.evictNextChunk());
+  }
+  for (int frag_id = 8; frag_id < 12; ++frag_id) {
+    alg.touchChunk({1, 1, 1, frag_id});
+  }
+  const auto eviction_order = alg.getEvictionOrder();
+  ASSERT_EQ(eviction_order.size(), 12U);
+  for (const auto& chunk_key : eviction_order) {
+    ASSERT_EQ(alg.evictNextChunk(), chunk_key);
+  }
+  ASSERT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+}
+
+TEST(CacheEvictionPolicy, Parse) {
+  ASSERT_EQ(parse_eviction_policy("lru"), EvictionPolicy::LRU);
+  ASSERT_EQ(parse_eviction_policy("2Q"), EvictionPolicy::TWO_QUEUE);
+  ASSERT_THROW(parse_eviction_policy("arc"), std::runtime_error);
+}
+
 class ForeignStorageCacheFileTest : public testing::Test {
  protected:
   std::string cache_path_;
@@ -19,7 +19,11 @@
  * @brief Test suite for DML SQL queries on foreign tables
  */
 
+#include <arrow/api.h>
+#include <arrow/io/file.h>
 #include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
@@ -29,6 +33,7 @@
 #include "DataMgr/ForeignStorage/ForeignTableRefresh.h"
 #include "Geospatial/Types.h"
 #include "ImportExport/DelimitedParserUtils.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -720,6 +725,69 @@ TEST_F(SelectQueryTest, ParquetStringDictionaryEncodedMetadataTestAfterChunkLoad
                        result);
 }
 
+namespace {
+void write_parquet_string_file(const std::string& file_path,
+                               const std::vector<std::string>& values,
+                               const int64_t row_group_size,
+                               const bool dictionary_encoded) {
+  arrow::StringBuilder builder;
+  PARQUET_THROW_NOT_OK(builder.AppendValues(values));
+  std::shared_ptr<arrow::Array> array;
+  PARQUET_THROW_NOT_OK(builder.Finish(&array));
+  auto table =
+      arrow::Table::Make(arrow::schema({arrow::field("txt", arrow::utf8())}), {array});
+  parquet::WriterProperties::Builder properties_builder;
+  if (!dictionary_encoded) {
+    properties_builder.disable_dictionary();
+  }
+  auto out_file = arrow::io::FileOutputStream::Open(file_path).ValueOrDie();
+  PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table,
+                                                  arrow::default_memory_pool(),
+                                                  out_file,
+                                                  row_group_size,
+                                                  properties_builder.build()));
+  PARQUET_THROW_NOT_OK(out_file->Close());
+}
+}  // namespace
+
+class ParquetStringEncodingTest : public SelectQueryTest,
+                                  public testing::WithParamInterface<bool> {};
+
+INSTANTIATE_TEST_SUITE_P(DictionaryAndPlainEncodedPages,
+                         ParquetStringEncodingTest,
+                         testing::Bool(),
+                         [](const auto& info) {
+                           return std::string(info.param ? "DictionaryEncoded"
+                                                         : "PlainEncoded");
+                         });
+
+TEST_P(ParquetStringEncodingTest, RepeatedStrings) {
+  const auto dir = bf::temp_directory_path() / bf::unique_path();
+  bf::create_directory(dir);
+  ScopeGuard remove_dir = [&dir] { bf::remove_all(dir); };
+  // Two row groups, the first one spanning two read batches of 4096 values, with
+  // values repeated within and across batches and row groups.
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 10000; ++i) {
+    values.emplace_back("str" + std::to_string(i % 7));
+  }
+  write_parquet_string_file((dir / "strings.parquet").string(), values, 6000, GetParam());
+  sql("CREATE FOREIGN TABLE test_foreign_table (txt TEXT ENCODING DICT (32)) "
+      "SERVER omnisci_local_parquet WITH (file_path = '" +
+      (dir / "strings.parquet").string() + "');");
+
+  TQueryResult result;
+  sql(result, "SELECT txt, COUNT(*) FROM test_foreign_table GROUP BY txt ORDER BY txt;");
+  assertResultSetEqual({{"str0", i(1429)},
+                        {"str1", i(1429)},
+                        {"str2", i(1429)},
+                        {"str3", i(1429)},
+                        {"str4", i(1428)},
+                        {"str5", i(1428)},
+                        {"str6", i(1428)}},
+                       result);
+}
+
 TEST_F(SelectQueryTest, ParquetNumericAndBooleanTypesWithAllNullPlacementPermutations) {
   const auto& query = getCreateForeignTableQuery(
       "( id INT, bool BOOLEAN, i8 TINYINT, u8 SMALLINT, i16 SMALLINT, "
@@ -3145,6 +3213,39 @@ TEST_P(RowGroupAndFragmentSizeSelectQueryTest, Filter) {
   assertResultSetEqual({{i(5), i(7), i(10), -1.}, {i(6), i(8), i(1), -100.}}, result);
 }
 
+TEST_F(SelectQueryTest, ParquetMultipleFilesAndRowGroups) {
+  // Files with row groups of 1 and 2 rows, scanned and loaded concurrently.
+  const auto& query =
+      getCreateForeignTableQuery("(a BIGINT, b BIGINT, c BIGINT, d DOUBLE)",
+                                 {{"fragment_size", "2"}},
+                                 "example_row_group_size",
+                                 "parquet",
+                                 0,
+                                 default_table_name,
+                                 "dir");
+  sql(query);
+
+  {
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*) FROM test_foreign_table WHERE d < 0;");
+    assertResultSetEqual({{i(8)}}, result);
+  }
+
+  {
+    TQueryResult result;
+    sql(result,
+        "SELECT a, COUNT(*), SUM(b), SUM(c), MAX(d) FROM test_foreign_table GROUP BY a "
+        "ORDER BY a;");
+    assertResultSetEqual({{i(1), i(4), i(12), i(24), 7.1},
+                          {i(2), i(4), i(16), i(28), 0.000591},
+                          {i(3), i(4), i(20), i(32), 1.1},
+                          {i(4), i(4), i(24), i(36), 0.022123},
+                          {i(5), i(4), i(28), i(40), -1.},
+                          {i(6), i(4), i(32), i(4), -100.}},
+                         result);
+  }
+}
+
 using namespace foreign_storage;
 class ForeignStorageCacheQueryTest : public ForeignTableTest {
  protected:
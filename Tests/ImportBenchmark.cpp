@@ -0,0 +1,165 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ImportBenchmark.cpp
+ * @brief Delimited file import throughput on a generated wide CSV file
+ */
+
+#include "TestHelpers.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <mutex>
+
+#include "../Logger/Logger.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+// Column types cycle through this list, the text columns are quoted and escaped every
+// other row so that unescaping is part of the measurement.
+constexpr size_t kColumnCount{200};
+const std::array<std::string, 5> kColumnTypes{"INT",
+                                              "BIGINT",
+                                              "DOUBLE",
+                                              "DECIMAL(12,2)",
+                                              "TEXT ENCODING DICT(32)"};
+
+std::once_flag setup_flag;
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+int64_t run_count(const std::string& table_name) {
+  auto rows = QR::get()->runSQL("SELECT COUNT(*) FROM " + table_name + ";",
+                                ExecutorDeviceType::CPU);
+  auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return TestHelpers::v<int64_t>(crt_row[0]);
+}
+
+std::string write_wide_csv(const int64_t row_count) {
+  const auto path = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("import_bench_%%%%-%%%%.csv");
+  std::ofstream out(path.string());
+  for (int64_t row = 0; row < row_count; ++row) {
+    for (size_t col = 0; col < kColumnCount; ++col) {
+      if (col > 0) {
+        out << ',';
+      }
+      switch (col % kColumnTypes.size()) {
+        case 0:
+          out << (row * 31 + col) % 100000;
+          break;
+        case 1:
+          out << row * 1000003 + col;
+          break;
+        case 2:
+          out << (row % 1000) * 0.125 + col;
+          break;
+        case 3:
+          out << (row % 10000) << '.' << (col % 100);
+          break;
+        default:
+          if (row % 2) {
+            out << "\"str \"\"" << row % 1000 << "\"\", " << col << '"';
+          } else {
+            out << "str_" << (row + col) % 1000;
+          }
+      }
+    }
+    out << '\n';
+  }
+  return path.string();
+}
+
+}  // namespace
+
+class WideCsvImportFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    std::call_once(setup_flag, global_setup);
+    file_path_ = write_wide_csv(state.range(0));
+    file_size_ = boost::filesystem::file_size(file_path_);
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    run_ddl_statement("DROP TABLE IF EXISTS import_bench;");
+    boost::filesystem::remove(file_path_);
+  }
+
+ protected:
+  void recreateTable() {
+    run_ddl_statement("DROP TABLE IF EXISTS import_bench;");
+    std::string create_table_stmt{"CREATE TABLE import_bench ("};
+    for (size_t col = 0; col < kColumnCount; ++col) {
+      create_table_stmt += (col > 0 ? ", c" : "c") + std::to_string(col) + " " +
+                           kColumnTypes[col % kColumnTypes.size()];
+    }
+    run_ddl_statement(create_table_stmt + ");");
+  }
+
+  std::string file_path_;
+  size_t file_size_{0};
+};
+
+//! Import the same file into a fresh table, with the number of rows and of import
+//! threads as arguments. Per core rates divide by the number of import threads.
+BENCHMARK_DEFINE_F(WideCsvImportFixture, CopyFrom)(benchmark::State& state) {
+  const auto row_count = state.range(0);
+  const auto thread_count = state.range(1);
+  for (auto _ : state) {
+    state.PauseTiming();
+    recreateTable();
+    state.ResumeTiming();
+    run_ddl_statement("COPY import_bench FROM '" + file_path_ +
+                      "' WITH (header='false', quoted='true', threads=" +
+                      std::to_string(thread_count) + ");");
+  }
+  CHECK_EQ(row_count, run_count("import_bench"));
+  const auto iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * file_size_);
+  state.counters["rows/s"] =
+      benchmark::Counter(iterations * row_count, benchmark::Counter::kIsRate);
+  state.counters["rows/s/core"] = benchmark::Counter(
+      iterations * row_count / thread_count, benchmark::Counter::kIsRate);
+  state.counters["MB/s/core"] = benchmark::Counter(
+      iterations * file_size_ / (1e6 * thread_count), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(WideCsvImportFixture, CopyFrom)
+    ->Args({100000, 1})
+    ->Args({100000, 4})
+    ->Args({100000, 16})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file JoinHashTableBenchmark.cpp
+ * @brief CPU build of perfect join hash tables, global vs. radix-partitioned
+ *
+ * The inner column holds random keys, so that the global build writes all over the
+ * table. Beyond the size of the last level cache the partitioned build should win.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/JoinHashTable/HashJoinRuntime.h"
+#include "Shared/thread_count.h"
+
+namespace {
+
+constexpr int32_t kInvalidSlotVal{-1};
+constexpr size_t kPartitionEntryCount{64 * 1024};
+
+class InnerColumn {
+ public:
+  // row_count keys in [0, key_count), each key at least once.
+  InnerColumn(const size_t row_count, const size_t key_count) : values_(row_count) {
+    for (size_t i = 0; i < row_count; ++i) {
+      values_[i] = static_cast<int32_t>(i % key_count);
+    }
+    std::shuffle(values_.begin(), values_.end(), std::mt19937{42});
+    chunk_ = {reinterpret_cast<const int8_t*>(values_.data()), values_.size()};
+    key_count_ = key_count;
+  }
+
+  JoinColumn getJoinColumn() const {
+    return {reinterpret_cast<const int8_t*>(&chunk_),
+            sizeof(chunk_),
+            1,
+            values_.size(),
+            sizeof(int32_t)};
+  }
+
+  JoinColumnTypeInfo getTypeInfo() const {
+    return {sizeof(int32_t),
+            0,
+            static_cast<int64_t>(key_count_) - 1,
+            std::numeric_limits<int32_t>::min(),
+            false,
+            static_cast<int64_t>(key_count_),
+            Signed};
+  }
+
+ private:
+  std::vector<int32_t> values_;
+  JoinChunk chunk_;
+  size_t key_count_;
+};
+
+void init_buff(int32_t* buff, const int64_t entry_count, const int thread_count) {
+  std::vector<std::future<void>> threads;
+  for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    threads.push_back(std::async(std::launch::async,
+                                 init_hash_join_buff,
+                                 buff,
+                                 entry_count,
+                                 kInvalidSlotVal,
+                                 thread_idx,
+                                 thread_count));
+  }
+  for (auto& thread : threads) {
+    thread.get();
+  }
+}
+
+}  // namespace
+
+//! One-to-one build over as many unique keys as the argument.
+static void BM_BuildOneToOne(benchmark::State& state, const bool partitioned) {
+  const size_t key_count = state.range(0);
+  const InnerColumn column(key_count, key_count);
+  const auto join_column = column.getJoinColumn();
+  const auto type_info = column.getTypeInfo();
+  const int thread_count = cpu_threads();
+  std::vector<int32_t> buff(key_count);
+  for (auto _ : state) {
+    init_buff(buff.data(), key_count, thread_count);
+    int err{0};
+    if (partitioned) {
+      err = fill_hash_join_buff_bucketized_partitioned(buff.data(),
+                                                       kInvalidSlotVal,
+                                                       join_column,
+                                                       type_info,
+                                                       nullptr,
+                                                       nullptr,
+                                                       key_count,
+                                                       1,
+                                                       kPartitionEntryCount,
+                                                       thread_count);
+    } else {
+      std::vector<std::future<int>> threads;
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+          return fill_hash_join_buff_bucketized(buff.data(),
+                                                kInvalidSlotVal,
+                                                join_column,
+                                                type_info,
+                                                nullptr,
+                                                nullptr,
+                                                thread_idx,
+                                                thread_count,
+                                                1);
+        }));
+      }
+      for (auto& thread : threads) {
+        err = thread.get() ? -1 : err;
+      }
+    }
+    CHECK_EQ(err, 0);
+    benchmark::DoNotOptimize(buff.data());
+  }
+  state.SetItemsProcessed(state.iterations() * key_count);
+}
+
+//! One-to-many build, four rows per key, over as many keys as the argument.
+static void BM_BuildOneToMany(benchmark::State& state, const bool partitioned) {
+  const size_t key_count = state.range(0);
+  const size_t row_count = 4 * key_count;
+  const InnerColumn column(row_count, key_count);
+  const auto join_column = column.getJoinColumn();
+  const auto type_info = column.getTypeInfo();
+  const int thread_count = cpu_threads();
+  std::vector<int32_t> buff(2 * key_count + row_count);
+  for (auto _ : state) {
+    init_buff(buff.data(), key_count, thread_count);
+    if (partitioned) {
+      fill_one_to_many_hash_table_partitioned(buff.data(),
+                                              key_count,
+                                              1,
+                                              kInvalidSlotVal,
+                                              join_column,
+                                              type_info,
+                                              nullptr,
+                                              nullptr,
+                                              kPartitionEntryCount,
+                                              thread_count);
+    } else {
+      fill_one_to_many_hash_table(buff.data(),
+                                  {key_count, 1},
+                                  kInvalidSlotVal,
+                                  join_column,
+                                  type_info,
+                                  nullptr,
+                                  nullptr,
+                                  thread_count);
+    }
+    benchmark::DoNotOptimize(buff.data());
+  }
+  state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+BENCHMARK_CAPTURE(BM_BuildOneToOne, global, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 25)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildOneToOne, partitioned, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 25)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildOneToMany, global, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 23)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildOneToMany, partitioned, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 23)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -47,6 +47,10 @@ using namespace TestHelpers;
 
 using QR = QueryRunner::QueryRunner;
 
+extern size_t g_radix_join_min_hash_table_bytes;
+extern size_t g_radix_join_partition_bytes;
+extern bool g_enable_join_key_range_skipping;
+
 namespace {
 ExecutorDeviceType g_device_type;
 }
@@ -931,6 +935,178 @@ TEST(MultiFragment, KeyedOneToMany) {
   }
 }
 
+namespace {
+
+// Builds the perfect hash table of table2.nums2 with the global and with the
+// radix-partitioned build, which must give the same table.
+void check_radix_partitioned_build(const JoinHashTableInterface::HashType hash_type) {
+  JoinHashTableCacheInvalidator::invalidateCaches();
+  auto hash_table = buildPerfect("table1", "nums1", "table2", "nums2");
+  EXPECT_EQ(hash_table->getHashType(), hash_type);
+  const auto expected = hash_table->toSet(g_device_type, 0);
+
+  const auto min_hash_table_bytes = g_radix_join_min_hash_table_bytes;
+  const auto partition_bytes = g_radix_join_partition_bytes;
+  // Many partitions of four entries each.
+  g_radix_join_min_hash_table_bytes = 0;
+  g_radix_join_partition_bytes = 4 * sizeof(int32_t);
+  JoinHashTableCacheInvalidator::invalidateCaches();
+  hash_table = buildPerfect("table1", "nums1", "table2", "nums2");
+  g_radix_join_min_hash_table_bytes = min_hash_table_bytes;
+  g_radix_join_partition_bytes = partition_bytes;
+  EXPECT_EQ(hash_table->getHashType(), hash_type);
+  EXPECT_EQ(hash_table->toSet(g_device_type, 0), expected);
+}
+
+std::string make_inserts(const std::string& table, const std::vector<int>& values) {
+  std::string inserts;
+  for (const auto value : values) {
+    inserts += "insert into " + table + " values (" + std::to_string(value) + ");\n";
+  }
+  return inserts;
+}
+
+}  // namespace
+
+TEST(RadixPartitioned, PerfectOneToOne) {
+  g_device_type = ExecutorDeviceType::CPU;
+  std::vector<int> values;
+  for (int i = 0; i < 100; ++i) {
+    // Leave gaps, so that some entries stay empty.
+    values.push_back((i * 37) % 150);
+  }
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+
+      create table table1 (nums1 integer);
+      create table table2 (nums2 integer) with (fragment_size = 16);
+
+      insert into table1 values (1);
+      insert into table1 values (149);
+    )" + make_inserts("table2", values));
+
+  check_radix_partitioned_build(JoinHashTableInterface::HashType::OneToOne);
+
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+    )");
+}
+
+TEST(RadixPartitioned, PerfectOneToMany) {
+  g_device_type = ExecutorDeviceType::CPU;
+  std::vector<int> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back((i * 37) % 60);
+  }
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+
+      create table table1 (nums1 integer);
+      create table table2 (nums2 integer) with (fragment_size = 16);
+
+      insert into table1 values (1);
+      insert into table1 values (59);
+    )" + make_inserts("table2", values));
+
+  check_radix_partitioned_build(JoinHashTableInterface::HashType::OneToMany);
+
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+    )");
+}
+
+namespace {
+
+int64_t count_join_matches() {
+  const auto rows = QR::get()->runSQL(
+      "select count(*) from table1, table2 where table1.nums1 = table2.nums2;",
+      g_device_type);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+// Returns the number of outer fragments skipped by the key range of the join while
+// counting the matches.
+size_t count_key_range_skipped_fragments(const int64_t expected_match_count) {
+  const auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  const auto skipped_before = executor->getJoinKeyRangeSkippedFragmentCount();
+  EXPECT_EQ(count_join_matches(), expected_match_count);
+  return executor->getJoinKeyRangeSkippedFragmentCount() - skipped_before;
+}
+
+}  // namespace
+
+TEST(KeyRange, Perfect) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    g_device_type = dt;
+    std::vector<int> values;
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(i);
+    }
+    sql(R"(
+        drop table if exists table1;
+        drop table if exists table2;
+
+        create table table1 (nums1 integer) with (fragment_size = 10);
+        create table table2 (nums2 integer);
+
+        insert into table2 values (42);
+        insert into table2 values (47);
+        insert into table2 values (53);
+      )" + make_inserts("table1", values));
+
+    auto hash_table = buildPerfect("table1", "nums1", "table2", "nums2");
+    const auto key_range = hash_table->getKeyRange();
+    ASSERT_TRUE(key_range);
+    EXPECT_EQ(key_range->min, 42);
+    EXPECT_EQ(key_range->max, 53);
+    ASSERT_TRUE(key_range->outer_col);
+    EXPECT_EQ(key_range->outer_col->get_rte_idx(), 0);
+
+    // Eight of the ten fragments of table1 are skipped.
+    EXPECT_EQ(count_key_range_skipped_fragments(3), size_t(8));
+    g_enable_join_key_range_skipping = false;
+    EXPECT_EQ(count_key_range_skipped_fragments(3), size_t(0));
+    g_enable_join_key_range_skipping = true;
+
+    sql(R"(
+        drop table if exists table1;
+        drop table if exists table2;
+      )");
+  }
+}
+
+TEST(KeyRange, EmptyInnerTable) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    g_device_type = dt;
+    sql(R"(
+        drop table if exists table1;
+        drop table if exists table2;
+
+        create table table1 (nums1 integer) with (fragment_size = 1);
+        create table table2 (nums2 integer);
+
+        insert into table1 values (1);
+        insert into table1 values (2);
+      )");
+
+    // Both fragments of table1 are skipped.
+    EXPECT_EQ(count_key_range_skipped_fragments(0), size_t(2));
+
+    sql(R"(
+        drop table if exists table1;
+        drop table if exists table2;
+      )");
+  }
+}
+
 TEST(Other, Regression) {
   sql(R"(
       drop table if exists table_a;
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/KernelScheduler.h"
+#include "Shared/numa.h"
+#include "Shared/scope.h"
+#include "Shared/thread_count.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sched.h>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+std::vector<std::function<void()>> make_sleep_tasks(const std::vector<size_t>& sleep_ms,
+                                                    std::atomic<size_t>& done_count) {
+  std::vector<std::function<void()>> tasks;
+  for (const auto ms : sleep_ms) {
+    tasks.emplace_back([ms, &done_count] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+      ++done_count;
+    });
+  }
+  return tasks;
+}
+
+}  // namespace
+
+TEST(KernelScheduler, RunsAllTasks) {
+  auto& scheduler = KernelScheduler::instance();
+  std::atomic<size_t> done_count{0};
+  const size_t task_count = 4 * scheduler.workerCount() + 3;
+  std::vector<size_t> sleep_ms(task_count, 1);
+  const auto stats = scheduler.run(make_sleep_tasks(sleep_ms, done_count), sleep_ms);
+  EXPECT_EQ(done_count, task_count);
+  EXPECT_EQ(stats.kernel_count, task_count);
+  EXPECT_EQ(stats.worker_count, scheduler.workerCount());
+  EXPECT_GT(stats.busy_time_us, 0);
+  EXPECT_GT(stats.utilization(), 0.0);
+}
+
+TEST(KernelScheduler, EmptyBatch) {
+  const auto stats = KernelScheduler::instance().run({}, {});
+  EXPECT_EQ(stats.kernel_count, size_t(0));
+  EXPECT_EQ(stats.utilization(), 0.0);
+}
+
+TEST(KernelScheduler, SkewedBatchIsBalanced) {
+  auto& scheduler = KernelScheduler::instance();
+  if (scheduler.workerCount() < 2) {
+    LOG(ERROR) << "Skipping skew test, scheduler has a single worker.";
+    return;
+  }
+  // One long kernel followed by enough short ones to occupy every worker twice. The
+  // batch should finish in about the time of the long kernel rather than the long
+  // kernel plus the short kernels queued behind it.
+  std::atomic<size_t> done_count{0};
+  std::vector<size_t> sleep_ms{200};
+  sleep_ms.resize(2 * scheduler.workerCount() + 1, 20);
+  const auto stats = scheduler.run(make_sleep_tasks(sleep_ms, done_count), sleep_ms);
+  EXPECT_EQ(done_count, sleep_ms.size());
+  EXPECT_LT(stats.wall_time_us, 400 * 1000);
+}
+
+TEST(KernelScheduler, PropagatesFirstError) {
+  auto& scheduler = KernelScheduler::instance();
+  std::vector<std::function<void()>> tasks;
+  tasks.emplace_back([] { throw std::runtime_error("kernel failed"); });
+  for (size_t i = 0; i < 8; ++i) {
+    tasks.emplace_back([] {});
+  }
+  std::vector<size_t> weights(tasks.size(), 0);
+  weights.front() = 1;
+  EXPECT_THROW(scheduler.run(std::move(tasks), weights), std::runtime_error);
+
+  // The scheduler stays usable after a failed batch.
+  std::atomic<size_t> done_count{0};
+  std::vector<size_t> sleep_ms(4, 1);
+  scheduler.run(make_sleep_tasks(sleep_ms, done_count), sleep_ms);
+  EXPECT_EQ(done_count, sleep_ms.size());
+}
+
+TEST(KernelScheduler, ConcurrentBatchesInterleave) {
+  auto& scheduler = KernelScheduler::instance();
+  std::atomic<size_t> done_count_a{0};
+  std::atomic<size_t> done_count_b{0};
+  std::vector<size_t> sleep_ms(2 * scheduler.workerCount(), 5);
+  auto batch_a = std::async(std::launch::async, [&] {
+    return scheduler.run(make_sleep_tasks(sleep_ms, done_count_a), sleep_ms);
+  });
+  auto batch_b = std::async(std::launch::async, [&] {
+    return scheduler.run(make_sleep_tasks(sleep_ms, done_count_b), sleep_ms);
+  });
+  batch_a.get();
+  batch_b.get();
+  EXPECT_EQ(done_count_a, sleep_ms.size());
+  EXPECT_EQ(done_count_b, sleep_ms.size());
+}
+
+TEST(KernelScheduler, ReportsQueueTimeBehindBusyWorkers) {
+  auto& scheduler = KernelScheduler::instance();
+  std::atomic<size_t> started_count{0};
+  std::vector<std::function<void()>> busy_tasks;
+  for (size_t i = 0; i < scheduler.workerCount(); ++i) {
+    busy_tasks.emplace_back([&started_count] {
+      ++started_count;
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+  }
+  const std::vector<size_t> busy_weights(busy_tasks.size(), 1);
+  auto busy_batch = std::async(std::launch::async, [&] {
+    return scheduler.run(std::move(busy_tasks), busy_weights);
+  });
+  while (started_count < scheduler.workerCount()) {
+    std::this_thread::yield();
+  }
+  // all the workers run the other batch, the task waits for one of them
+  std::atomic<size_t> done_count{0};
+  const std::vector<size_t> sleep_ms{1};
+  const auto stats = scheduler.run(make_sleep_tasks(sleep_ms, done_count), sleep_ms);
+  busy_batch.get();
+  EXPECT_EQ(done_count, size_t(1));
+  EXPECT_GT(stats.queue_time_us, 0);
+}
+
+TEST(KernelScheduler, PlacesTasksOnNumaNodes) {
+  const auto enable_numa_placement = g_enable_numa_placement;
+  ScopeGuard reset_numa_placement = [enable_numa_placement] {
+    g_enable_numa_placement = enable_numa_placement;
+  };
+  g_enable_numa_placement = true;
+  KernelScheduler scheduler(static_cast<size_t>(cpu_threads()));
+  const auto& nodes = numa::nodes();
+  std::atomic<size_t> done_count{0};
+  std::atomic<size_t> off_node_cpu_count{0};
+  std::vector<std::function<void()>> tasks;
+  std::vector<int> numa_nodes;
+  const size_t task_count = 4 * scheduler.workerCount();
+  for (size_t i = 0; i < task_count; ++i) {
+    // Every third task has no preferred node.
+    const int node = i % 3 ? nodes[i % nodes.size()] : -1;
+    numa_nodes.push_back(node);
+    tasks.emplace_back([node, &done_count, &off_node_cpu_count] {
+      const auto& cpus = numa::node_cpus(node);
+      if (node >= 0 &&
+          std::find(cpus.begin(), cpus.end(), sched_getcpu()) == cpus.end()) {
+        ++off_node_cpu_count;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ++done_count;
+    });
+  }
+  const auto stats =
+      scheduler.run(std::move(tasks), std::vector<size_t>(task_count, 1), numa_nodes);
+  EXPECT_EQ(done_count, task_count);
+  // Only tasks stolen by a worker of another node may run off their node.
+  EXPECT_LE(off_node_cpu_count, stats.off_node_count);
+  EXPECT_LE(stats.off_node_count, stats.steal_count);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file NumaScanBenchmark.cpp
+ * @brief Scan bandwidth per socket, for every pair of memory node and CPU node
+ *
+ * A column sized buffer is bound to one NUMA node and summed by all the cores of
+ * another (or the same) node, which is what a fragment kernel does with the chunks in
+ * the CPU buffer pool. The diagonal is the bandwidth with NUMA placement enabled, the
+ * rest what a kernel gets when its fragment sits on the other socket.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <sys/mman.h>
+
+#include <map>
+#include <numeric>
+#include <thread>
+
+#include "Logger/Logger.h"
+#include "Shared/numa.h"
+
+namespace {
+
+constexpr size_t kBufferBytes{size_t(1) << 30};
+
+// An int64 buffer with its pages on the given node, kept for the whole run.
+const int64_t* get_buffer(const int node) {
+  static std::map<int, int64_t*> buffers;
+  auto& buffer = buffers[node];
+  if (!buffer) {
+    void* mem = mmap(nullptr,
+                     kBufferBytes,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS,
+                     -1,
+                     0);
+    CHECK(mem != MAP_FAILED);
+    // Bind before the first touch, which is what allocates the pages.
+    if (numa::node_count() > 1) {
+      CHECK(numa::bind_memory(mem, kBufferBytes, node));
+    }
+    buffer = reinterpret_cast<int64_t*>(mem);
+    std::iota(buffer, buffer + kBufferBytes / sizeof(int64_t), 0);
+  }
+  return buffer;
+}
+
+// Sums the buffer with one thread per core of the node.
+int64_t scan(const int64_t* buffer, const int cpu_node) {
+  const size_t thread_count = std::max(numa::node_cpus(cpu_node).size(), size_t(1));
+  const size_t value_count = kBufferBytes / sizeof(int64_t);
+  std::vector<int64_t> sums(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&, i] {
+      numa::bind_current_thread(cpu_node);
+      const auto begin = buffer + value_count * i / thread_count;
+      const auto end = buffer + value_count * (i + 1) / thread_count;
+      sums[i] = std::accumulate(begin, end, int64_t(0));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return std::accumulate(sums.begin(), sums.end(), int64_t(0));
+}
+
+}  // namespace
+
+//! Scan a buffer on the memory node with all cores of the CPU node. The arguments are
+//! the memory node and the CPU node.
+static void BM_Scan(benchmark::State& state) {
+  const int memory_node = state.range(0);
+  const int cpu_node = state.range(1);
+  const auto buffer = get_buffer(memory_node);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scan(buffer, cpu_node));
+  }
+  state.SetLabel("memory node " + std::to_string(memory_node) + ", cpu node " +
+                 std::to_string(cpu_node) +
+                 (memory_node == cpu_node ? " (local)" : " (remote)"));
+  state.SetBytesProcessed(state.iterations() * kBufferBytes);
+}
+
+static void scan_args(benchmark::internal::Benchmark* b) {
+  for (const auto memory_node : numa::nodes()) {
+    for (const auto cpu_node : numa::nodes()) {
+      b->Args({memory_node, cpu_node});
+    }
+  }
+}
+
+BENCHMARK(BM_Scan)->Apply(scan_args)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file PlanCacheTest.cpp
+ * @brief Test suite for the Calcite plan cache
+ */
+
+#include <gtest/gtest.h>
+
+#include "Calcite/PlanCache.h"
+#include "DBHandlerTestHelpers.h"
+#include "TestHelpers.h"
+#include "gen-cpp/calciteserver_types.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_plan_cache;
+
+TEST(PlanCacheNormalizeSql, CollapsesWhitespace) {
+  EXPECT_EQ(PlanCache::normalizeSql("  SELECT  x,\n\ty FROM t ;  "),
+            "SELECT x, y FROM t");
+  EXPECT_EQ(PlanCache::normalizeSql("SELECT x FROM t;"), "SELECT x FROM t");
+}
+
+TEST(PlanCacheNormalizeSql, PreservesQuotedText) {
+  EXPECT_EQ(PlanCache::normalizeSql("SELECT  'a  b' FROM \"my  table\""),
+            "SELECT 'a  b' FROM \"my  table\"");
+  EXPECT_EQ(PlanCache::normalizeSql("SELECT 'it''s  ok'"), "SELECT 'it''s  ok'");
+}
+
+TEST(PlanCacheNormalizeSql, PreservesCommentLineBreaks) {
+  // Collapsing the line break would comment out the FROM clause.
+  EXPECT_NE(PlanCache::normalizeSql("SELECT x -- comment\nFROM t"),
+            PlanCache::normalizeSql("SELECT x -- comment FROM t"));
+}
+
+TEST(PlanCacheGeneration, StalePlanIsNotCached) {
+  auto& plan_cache = PlanCache::instance();
+  plan_cache.clear();
+  const auto key = PlanCache::makeKey(1, "SELECT 1", false, false);
+  const auto generation = plan_cache.getGeneration();
+  // An invalidation while the plan was computed.
+  plan_cache.clear();
+  plan_cache.put(key, generation, std::make_shared<const TPlanResult>());
+  EXPECT_FALSE(plan_cache.get(key));
+  plan_cache.put(key, plan_cache.getGeneration(), std::make_shared<const TPlanResult>());
+  EXPECT_TRUE(plan_cache.get(key));
+}
+
+class PlanCacheTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    g_enable_plan_cache = true;
+    sql("DROP TABLE IF EXISTS plan_cache_test;");
+    sql("CREATE TABLE plan_cache_test (x INT, y TEXT ENCODING DICT(32));");
+    sql("INSERT INTO plan_cache_test VALUES (1, 'a');");
+    sql("INSERT INTO plan_cache_test VALUES (2, 'b');");
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS plan_cache_test;");
+    g_enable_plan_cache = false;
+    DBHandlerTestFixture::TearDown();
+  }
+
+  std::pair<int64_t, int64_t> getHitsAndMisses() {
+    auto [db_handler, session_id] = getDbHandlerAndSessionId();
+    TServerStatus status;
+    db_handler->get_server_status(status, session_id);
+    return {status.plan_cache_hits, status.plan_cache_misses};
+  }
+};
+
+TEST_F(PlanCacheTest, RepeatedQueryHits) {
+  sqlAndCompareResult("SELECT x FROM plan_cache_test ORDER BY x;", {{i(1)}, {i(2)}});
+  const auto [hits, misses] = getHitsAndMisses();
+  sqlAndCompareResult("SELECT  x\nFROM plan_cache_test  ORDER BY x", {{i(1)}, {i(2)}});
+  const auto [hits_after, misses_after] = getHitsAndMisses();
+  EXPECT_EQ(hits_after, hits + 1);
+  EXPECT_EQ(misses_after, misses);
+}
+
+TEST_F(PlanCacheTest, DdlInvalidates) {
+  const std::string query{"SELECT * FROM plan_cache_test ORDER BY x;"};
+  sqlAndCompareResult(query, {{i(1), "a"}, {i(2), "b"}});
+  sql("ALTER TABLE plan_cache_test ADD COLUMN z INT;");
+  const auto [hits, misses] = getHitsAndMisses();
+  // The cached plan would still project two columns.
+  sqlAndCompareResult(query, {{i(1), "a", Null_i}, {i(2), "b", Null_i}});
+  const auto [hits_after, misses_after] = getHitsAndMisses();
+  EXPECT_EQ(hits_after, hits);
+  EXPECT_EQ(misses_after, misses + 1);
+}
+
+TEST_F(PlanCacheTest, CachedPlanChecksPrivileges) {
+  const std::string query{"SELECT x FROM plan_cache_test ORDER BY x;"};
+  sqlAndCompareResult(query, {{i(1)}, {i(2)}});
+  sql("DROP USER IF EXISTS plan_cache_user;");
+  sql("CREATE USER plan_cache_user (password = 'HyperInteractive', is_super = "
+      "'false', default_db='omnisci');");
+  sql("GRANT ACCESS ON DATABASE omnisci TO plan_cache_user;");
+  TSessionId user_session_id;
+  login("plan_cache_user", "HyperInteractive", "omnisci", user_session_id);
+  const auto hits = getHitsAndMisses().first;
+  try {
+    TQueryResult result;
+    sql(result, query, user_session_id);
+    FAIL() << "An exception should have been thrown for this test case.";
+  } catch (const TOmniSciException& e) {
+    EXPECT_NE(e.error_msg.find("Violation of access privileges"), std::string::npos)
+        << e.error_msg;
+  }
+  EXPECT_EQ(getHitsAndMisses().first, hits + 1);
+  logout(user_session_id);
+  sql("DROP USER plan_cache_user;");
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryDispatchQueue.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Priority = QueryDispatchQueue::Priority;
+
+// A task which keeps its worker busy until released.
+class BlockingTask {
+ public:
+  BlockingTask()
+      : task_(std::make_shared<QueryDispatchQueue::Task>([this](const size_t) {
+        started_ = true;
+        while (!released_) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      })) {}
+
+  std::shared_ptr<QueryDispatchQueue::Task> task() const { return task_; }
+
+  void waitUntilStarted() const {
+    while (!started_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  bool started() const { return started_; }
+
+  void release() { released_ = true; }
+
+ private:
+  std::atomic<bool> started_{false};
+  std::atomic<bool> released_{false};
+  std::shared_ptr<QueryDispatchQueue::Task> task_;
+};
+
+QueryDispatchQueue::TaskInfo make_info(const Priority priority,
+                                       const size_t estimated_rows,
+                                       const size_t estimated_bytes) {
+  QueryDispatchQueue::TaskInfo info;
+  info.priority = priority;
+  info.has_estimate = true;
+  info.estimated_rows = estimated_rows;
+  info.estimated_bytes = estimated_bytes;
+  return info;
+}
+
+struct DispatchFlagsGuard {
+  DispatchFlagsGuard()
+      : short_query_rows(g_dispatch_short_query_rows)
+      , priority_aging_ms(g_dispatch_priority_aging_ms)
+      , admission_control(g_enable_dispatch_admission_control) {}
+
+  ~DispatchFlagsGuard() {
+    g_dispatch_short_query_rows = short_query_rows;
+    g_dispatch_priority_aging_ms = priority_aging_ms;
+    g_enable_dispatch_admission_control = admission_control;
+  }
+
+  size_t short_query_rows;
+  size_t priority_aging_ms;
+  bool admission_control;
+};
+
+}  // namespace
+
+TEST(QueryDispatchQueue, RunsAllTasks) {
+  QueryDispatchQueue queue(4);
+  std::atomic<size_t> run_count{0};
+  std::vector<std::shared_ptr<QueryDispatchQueue::Task>> tasks;
+  for (size_t i = 0; i < 100; ++i) {
+    tasks.push_back(std::make_shared<QueryDispatchQueue::Task>(
+        [&run_count](const size_t worker_idx) {
+          EXPECT_GE(worker_idx, size_t(1));
+          EXPECT_LE(worker_idx, size_t(4));
+          ++run_count;
+        }));
+    queue.submit(tasks.back(), /*is_update_delete=*/false);
+  }
+  for (auto& task : tasks) {
+    task->get_future().get();
+  }
+  EXPECT_EQ(run_count, size_t(100));
+}
+
+TEST(QueryDispatchQueue, RunsHigherPrioritiesFirst) {
+  DispatchFlagsGuard flags_guard;
+  g_dispatch_priority_aging_ms = 0;
+  QueryDispatchQueue queue(1);
+  BlockingTask blocking_task;
+  queue.submit(blocking_task.task(), /*is_update_delete=*/false);
+  blocking_task.waitUntilStarted();
+
+  std::mutex order_mutex;
+  std::vector<Priority> order;
+  std::vector<std::shared_ptr<QueryDispatchQueue::Task>> tasks;
+  for (const auto priority : {Priority::LOW, Priority::NORMAL, Priority::HIGH}) {
+    tasks.push_back(std::make_shared<QueryDispatchQueue::Task>(
+        [&order_mutex, &order, priority](const size_t) {
+          std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(priority);
+        }));
+    queue.submit(tasks.back(), /*is_update_delete=*/false, make_info(priority, 0, 0));
+  }
+  blocking_task.release();
+  for (auto& task : tasks) {
+    task->get_future().get();
+  }
+  EXPECT_EQ(order,
+            std::vector<Priority>({Priority::HIGH, Priority::NORMAL, Priority::LOW}));
+}
+
+TEST(QueryDispatchQueue, AgingPromotesWaitingQueries) {
+  DispatchFlagsGuard flags_guard;
+  g_dispatch_priority_aging_ms = 10;
+  QueryDispatchQueue queue(1);
+  BlockingTask blocking_task;
+  queue.submit(blocking_task.task(), /*is_update_delete=*/false);
+  blocking_task.waitUntilStarted();
+
+  std::mutex order_mutex;
+  std::vector<Priority> order;
+  auto make_task = [&order_mutex, &order](const Priority priority) {
+    return std::make_shared<QueryDispatchQueue::Task>(
+        [&order_mutex, &order, priority](const size_t) {
+          std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(priority);
+        });
+  };
+  auto low_task = make_task(Priority::LOW);
+  queue.submit(low_task, /*is_update_delete=*/false, make_info(Priority::LOW, 0, 0));
+  // Long enough for the low priority query to be promoted to high.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto high_task = make_task(Priority::HIGH);
+  queue.submit(high_task, /*is_update_delete=*/false, make_info(Priority::HIGH, 0, 0));
+  blocking_task.release();
+  low_task->get_future().get();
+  high_task->get_future().get();
+  EXPECT_EQ(order, std::vector<Priority>({Priority::LOW, Priority::HIGH}));
+}
+
+TEST(QueryDispatchQueue, ShortQueriesBypassLongQueries) {
+  DispatchFlagsGuard flags_guard;
+  g_dispatch_short_query_rows = 1000;
+  QueryDispatchQueue queue(1);
+  BlockingTask long_task;
+  queue.submit(long_task.task(),
+               /*is_update_delete=*/false,
+               make_info(Priority::NORMAL, 1000000, 0));
+  long_task.waitUntilStarted();
+
+  size_t short_worker_idx{0};
+  auto short_task = std::make_shared<QueryDispatchQueue::Task>(
+      [&short_worker_idx](const size_t worker_idx) { short_worker_idx = worker_idx; });
+  queue.submit(
+      short_task, /*is_update_delete=*/false, make_info(Priority::NORMAL, 100, 0));
+  short_task->get_future().get();
+  // The fast lane worker has an Executor of its own, past the one of update/delete.
+  EXPECT_EQ(short_worker_idx, size_t(3));
+  EXPECT_EQ(queue.getStats().fast_lane_count, size_t(1));
+  long_task.release();
+}
+
+TEST(QueryDispatchQueue, AdmitsQueriesWithinMemoryBudget) {
+  DispatchFlagsGuard flags_guard;
+  g_enable_dispatch_admission_control = true;
+  QueryDispatchQueue queue(2);
+  queue.setMemoryBudget(100);
+
+  BlockingTask first_task;
+  queue.submit(
+      first_task.task(), /*is_update_delete=*/false, make_info(Priority::NORMAL, 0, 80));
+  first_task.waitUntilStarted();
+  EXPECT_EQ(queue.getStats().reserved_bytes, size_t(80));
+
+  // Doesn't fit next to the first query, although there is an idle worker.
+  BlockingTask second_task;
+  queue.submit(second_task.task(),
+               /*is_update_delete=*/false,
+               make_info(Priority::NORMAL, 0, 50));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(second_task.started());
+  EXPECT_EQ(queue.getStats().admission_wait_count, size_t(1));
+
+  first_task.release();
+  second_task.waitUntilStarted();
+  second_task.release();
+  second_task.task()->get_future().get();
+
+  // Queries larger than the budget still run when nothing else does.
+  auto large_task = std::make_shared<QueryDispatchQueue::Task>([](const size_t) {});
+  queue.submit(
+      large_task, /*is_update_delete=*/false, make_info(Priority::NORMAL, 0, 500));
+  large_task->get_future().get();
+}
+
+TEST(QueryDispatchQueue, Stats) {
+  QueryDispatchQueue queue(2);
+  std::vector<std::shared_ptr<QueryDispatchQueue::Task>> tasks;
+  for (size_t i = 0; i < 10; ++i) {
+    tasks.push_back(std::make_shared<QueryDispatchQueue::Task>([](const size_t) {}));
+    const auto priority = i % 2 ? Priority::HIGH : Priority::LOW;
+    queue.submit(tasks.back(), /*is_update_delete=*/false, make_info(priority, 0, 0));
+  }
+  for (auto& task : tasks) {
+    task->get_future().get();
+  }
+  // The futures are ready before the workers record the latencies.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const auto stats = queue.getStats();
+  EXPECT_EQ(stats.queuedCount(), size_t(0));
+  EXPECT_EQ(stats.running_count, size_t(0));
+  for (const auto priority : {Priority::HIGH, Priority::LOW}) {
+    const auto& class_stats = stats.classes[static_cast<size_t>(priority)];
+    EXPECT_EQ(class_stats.executed_count, size_t(5));
+    EXPECT_EQ(class_stats.wait_time_ms.count(), size_t(5));
+    EXPECT_EQ(class_stats.latency_ms.count(), size_t(5));
+  }
+  EXPECT_EQ(stats.classes[static_cast<size_t>(Priority::NORMAL)].executed_count,
+            size_t(0));
+}
+
+TEST(QueryDispatchQueue, UserPriority) {
+  const auto high_users = g_query_priority_high_users;
+  const auto low_users = g_query_priority_low_users;
+  g_query_priority_high_users = "dashboard, admin";
+  g_query_priority_low_users = "etl";
+  EXPECT_EQ(QueryDispatchQueue::getUserPriority("admin"), Priority::HIGH);
+  EXPECT_EQ(QueryDispatchQueue::getUserPriority("etl"), Priority::LOW);
+  EXPECT_EQ(QueryDispatchQueue::getUserPriority("analyst"), Priority::NORMAL);
+  g_query_priority_high_users = high_users;
+  g_query_priority_low_users = low_users;
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ResultCursorTest.cpp
+ * @brief Test suite for the sql_execute_cursor / fetch_batch / close_cursor APIs
+ */
+
+#include <gtest/gtest.h>
+
+#include "Tests/DBHandlerTestHelpers.h"
+#include "Tests/TestHelpers.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern size_t g_result_cursor_idle_timeout;
+extern size_t g_result_cursor_memory_limit;
+
+class ResultCursorTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    if (isDistributedMode()) {
+      GTEST_SKIP() << "Cursors are not supported in distributed mode";
+    }
+    sql("DROP TABLE IF EXISTS cursor_test");
+    sql("CREATE TABLE cursor_test(i INTEGER, s TEXT, d DOUBLE)");
+    for (int i = 1; i <= 10; ++i) {
+      sql("INSERT INTO cursor_test VALUES(" + std::to_string(i) + ", " +
+          (i % 3 ? "'str" + std::to_string(i) + "'" : "NULL") + ", " +
+          std::to_string(i) + ".5)");
+    }
+  }
+
+  void TearDown() override {
+    g_result_cursor_idle_timeout = idle_timeout_;
+    g_result_cursor_memory_limit = memory_limit_;
+    sql("DROP TABLE IF EXISTS cursor_test");
+    DBHandlerTestFixture::TearDown();
+  }
+
+  TCursor openCursor(const std::string& query) {
+    auto* handler = getDbHandlerAndSessionId().first;
+    auto& session = getDbHandlerAndSessionId().second;
+    TCursor cursor;
+    handler->sql_execute_cursor(cursor, session, query, "");
+    return cursor;
+  }
+
+  TRowBatch fetchBatch(const TCursorId& cursor_id, const int32_t max_rows) {
+    auto* handler = getDbHandlerAndSessionId().first;
+    auto& session = getDbHandlerAndSessionId().second;
+    TRowBatch batch;
+    handler->fetch_batch(batch, session, cursor_id, max_rows);
+    return batch;
+  }
+
+  // Fetches all the batches of the cursor and checks they add up to the columnar result
+  // of sql_execute for the same query.
+  void assertBatchesMatchQuery(const std::string& query,
+                               const int32_t max_rows,
+                               const size_t expected_batch_count) {
+    TQueryResult expected;
+    sql(expected, query);
+    const auto cursor = openCursor(query);
+    ASSERT_EQ(expected.row_set.row_desc, cursor.row_desc);
+
+    std::vector<TColumn> columns(cursor.row_desc.size());
+    size_t batch_count{0};
+    TRowBatch batch;
+    do {
+      batch = fetchBatch(cursor.cursor_id, max_rows);
+      ++batch_count;
+      ASSERT_TRUE(batch.row_set.is_columnar);
+      ASSERT_EQ(columns.size(), batch.row_set.columns.size());
+      for (size_t i = 0; i < columns.size(); ++i) {
+        const auto& batch_column = batch.row_set.columns[i];
+        ASSERT_LE(batch_column.nulls.size(), static_cast<size_t>(max_rows));
+        auto& column = columns[i];
+        column.nulls.insert(
+            column.nulls.end(), batch_column.nulls.begin(), batch_column.nulls.end());
+        auto& data = column.data;
+        const auto& batch_data = batch_column.data;
+        data.int_col.insert(
+            data.int_col.end(), batch_data.int_col.begin(), batch_data.int_col.end());
+        data.real_col.insert(
+            data.real_col.end(), batch_data.real_col.begin(), batch_data.real_col.end());
+        data.str_col.insert(
+            data.str_col.end(), batch_data.str_col.begin(), batch_data.str_col.end());
+      }
+    } while (!batch.end_of_results);
+    EXPECT_EQ(expected_batch_count, batch_count);
+    ASSERT_EQ(expected.row_set.columns.size(), columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+      EXPECT_EQ(expected.row_set.columns[i].nulls, columns[i].nulls);
+      EXPECT_EQ(expected.row_set.columns[i].data, columns[i].data);
+    }
+  }
+
+  void assertCursorClosed(const TCursorId& cursor_id) {
+    executeLambdaAndAssertException([&] { fetchBatch(cursor_id, 1); },
+                                    "Exception: cursor does not exist or has expired");
+  }
+
+ private:
+  const size_t idle_timeout_{g_result_cursor_idle_timeout};
+  const size_t memory_limit_{g_result_cursor_memory_limit};
+};
+
+TEST_F(ResultCursorTest, BatchesMatchQueryResult) {
+  assertBatchesMatchQuery("SELECT i, s, d FROM cursor_test ORDER BY i;", 3, 4);
+}
+
+TEST_F(ResultCursorTest, LastFullBatchEndsResults) {
+  assertBatchesMatchQuery("SELECT i, s, d FROM cursor_test ORDER BY i;", 5, 2);
+}
+
+TEST_F(ResultCursorTest, SingleBatch) {
+  assertBatchesMatchQuery(
+      "SELECT s, COUNT(*) FROM cursor_test GROUP BY s ORDER BY s;", 100, 1);
+}
+
+TEST_F(ResultCursorTest, EmptyResult) {
+  assertBatchesMatchQuery("SELECT i, s FROM cursor_test WHERE i > 10;", 3, 1);
+}
+
+TEST_F(ResultCursorTest, CursorClosedAfterLastBatch) {
+  const auto cursor = openCursor("SELECT i FROM cursor_test;");
+  EXPECT_TRUE(fetchBatch(cursor.cursor_id, 10).end_of_results);
+  assertCursorClosed(cursor.cursor_id);
+}
+
+TEST_F(ResultCursorTest, CloseCursor) {
+  auto* handler = getDbHandlerAndSessionId().first;
+  auto& session = getDbHandlerAndSessionId().second;
+  const auto cursor = openCursor("SELECT i FROM cursor_test;");
+  EXPECT_FALSE(fetchBatch(cursor.cursor_id, 1).end_of_results);
+  handler->close_cursor(session, cursor.cursor_id);
+  assertCursorClosed(cursor.cursor_id);
+  // closing twice is fine
+  handler->close_cursor(session, cursor.cursor_id);
+}
+
+TEST_F(ResultCursorTest, InvalidMaxRows) {
+  const auto cursor = openCursor("SELECT i FROM cursor_test;");
+  executeLambdaAndAssertException([&] { fetchBatch(cursor.cursor_id, 0); },
+                                  "Exception: max_rows must be positive");
+}
+
+TEST_F(ResultCursorTest, NonSelectQuery) {
+  executeLambdaAndAssertException(
+      [&] { openCursor("INSERT INTO cursor_test VALUES(11, 'str11', 11.5);"); },
+      "Exception: only SELECT queries can be executed with a cursor");
+}
+
+TEST_F(ResultCursorTest, VarlenTargets) {
+  sql("DROP TABLE IF EXISTS cursor_varlen_test");
+  sql("CREATE TABLE cursor_varlen_test(t TEXT ENCODING NONE, a INTEGER[])");
+  sql("INSERT INTO cursor_varlen_test VALUES('str', {1, 2});");
+  executeLambdaAndAssertException(
+      [&] { openCursor("SELECT t FROM cursor_varlen_test;"); },
+      "Exception: column t of type TEXT cannot be fetched with a cursor");
+  executeLambdaAndAssertException(
+      [&] { openCursor("SELECT a FROM cursor_varlen_test;"); },
+      "Exception: column a of type INTEGER[] cannot be fetched with a cursor");
+  sql("DROP TABLE cursor_varlen_test");
+}
+
+TEST_F(ResultCursorTest, IdleCursorExpires) {
+  g_result_cursor_idle_timeout = 0;
+  const auto idle_cursor = openCursor("SELECT i FROM cursor_test;");
+  const auto cursor = openCursor("SELECT i FROM cursor_test;");
+  assertCursorClosed(idle_cursor.cursor_id);
+  EXPECT_FALSE(fetchBatch(cursor.cursor_id, 1).end_of_results);
+}
+
+TEST_F(ResultCursorTest, LeastRecentlyUsedCursorEvicted) {
+  g_result_cursor_memory_limit = 0;
+  const auto evicted_cursor = openCursor("SELECT i FROM cursor_test;");
+  const auto cursor = openCursor("SELECT i FROM cursor_test;");
+  assertCursorClosed(evicted_cursor.cursor_id);
+  // the cursor fetched from is kept even though it is over the limit on its own
+  EXPECT_FALSE(fetchBatch(cursor.cursor_id, 1).end_of_results);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -28,6 +28,7 @@
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionary.h"
 #include "Tests/TestHelpers.h"
 
@@ -37,6 +38,7 @@
 #include <random>
 
 extern bool g_is_test_env;
+extern bool g_enable_parallel_reduction;
 
 TEST(Construct, Allocate) {
   std::vector<TargetInfo> target_infos;
@@ -1834,6 +1836,100 @@ TEST(ReduceLargeBuffers, BaselineHashColumnar_Overflow32) {
 }
 #endif
 
+namespace {
+
+// Reduces kernel_count partial results filled with the same keys, serially or with the
+// parallel reduction, and returns the reduced rows sorted by the first column.
+std::vector<OneRow> reduce_kernel_results(const std::vector<TargetInfo>& target_infos,
+                                          const QueryMemoryDescriptor& query_mem_desc,
+                                          const size_t kernel_count,
+                                          const bool parallel,
+                                          int64_t& reduction_time_ms) {
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  row_set_mem_owner->addStringDict(g_sd, 1, g_sd->storageEntryCount());
+  std::vector<std::unique_ptr<ResultSet>> kernel_results;
+  std::vector<ResultSet*> result_sets;
+  EvenNumberGenerator generator;
+  for (size_t i = 0; i < kernel_count; ++i) {
+    kernel_results.emplace_back(std::make_unique<ResultSet>(target_infos,
+                                                            ExecutorDeviceType::CPU,
+                                                            query_mem_desc,
+                                                            row_set_mem_owner,
+                                                            nullptr));
+    const auto storage = kernel_results.back()->allocateStorage();
+    generator.reset();
+    fill_storage_buffer(
+        storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 2);
+    result_sets.push_back(kernel_results.back().get());
+  }
+
+  const auto parallel_reduction_state = g_enable_parallel_reduction;
+  ScopeGuard reset_parallel_reduction = [parallel_reduction_state] {
+    g_enable_parallel_reduction = parallel_reduction_state;
+  };
+  g_enable_parallel_reduction = parallel;
+  ResultSetManager rs_manager;
+  const auto clock_begin = timer_start();
+  const auto result_rs = rs_manager.reduce(result_sets);
+  reduction_time_ms = timer_stop(clock_begin);
+  return get_rows_sorted_by_col(*result_rs, 0);
+}
+
+void check_parallel_reduction(const std::vector<TargetInfo>& target_infos,
+                              const QueryMemoryDescriptor& query_mem_desc,
+                              const std::vector<size_t>& kernel_counts) {
+  for (const auto kernel_count : kernel_counts) {
+    int64_t serial_ms{0};
+    int64_t parallel_ms{0};
+    const auto serial_rows = reduce_kernel_results(
+        target_infos, query_mem_desc, kernel_count, false, serial_ms);
+    const auto parallel_rows = reduce_kernel_results(
+        target_infos, query_mem_desc, kernel_count, true, parallel_ms);
+    ASSERT_EQ(serial_rows.size(), parallel_rows.size());
+    for (size_t i = 0; i < serial_rows.size(); ++i) {
+      ASSERT_EQ(serial_rows[i].size(), parallel_rows[i].size());
+      for (size_t j = 0; j < serial_rows[i].size(); ++j) {
+        const auto serial_val = boost::get<ScalarTargetValue>(&serial_rows[i][j]);
+        const auto parallel_val = boost::get<ScalarTargetValue>(&parallel_rows[i][j]);
+        ASSERT_TRUE(serial_val && parallel_val);
+        ASSERT_TRUE(*serial_val == *parallel_val);
+      }
+    }
+    LOG(INFO) << "Reduced " << kernel_count << " results of "
+              << query_mem_desc.getEntryCount() << " entries: serial " << serial_ms
+              << " ms, parallel " << parallel_ms << " ms";
+  }
+}
+
+}  // namespace
+
+TEST(ParallelReduce, PerfectHashOneCol) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 49999);
+  check_parallel_reduction(target_infos, query_mem_desc, {2, 3, 8, 32, 64});
+}
+
+TEST(ParallelReduce, PerfectHashOneColColumnar) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 49999);
+  query_mem_desc.setOutputColumnar(true);
+  check_parallel_reduction(target_infos, query_mem_desc, {2, 3, 8, 32, 64});
+}
+
+TEST(ParallelReduce, BaselineHash) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8, 49999);
+  check_parallel_reduction(target_infos, query_mem_desc, {2, 3, 8, 32, 64});
+}
+
+TEST(ParallelReduce, BaselineHashColumnar) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8, 49999);
+  query_mem_desc.setOutputColumnar(true);
+  check_parallel_reduction(target_infos, query_mem_desc, {2, 3, 8, 32, 64});
+}
+
 TEST(MoreReduce, MissingValues) {
   std::vector<TargetInfo> target_infos;
   SQLTypeInfo bigint_ti(kBIGINT, false);
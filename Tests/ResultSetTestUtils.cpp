@@ -585,9 +585,10 @@ QueryMemoryDescriptor baseline_hash_two_col_desc_overflow32(
 
 QueryMemoryDescriptor baseline_hash_two_col_desc(
     const std::vector<TargetInfo>& target_infos,
-    const int8_t num_bytes) {
+    const int8_t num_bytes,
+    const size_t max_val) {
   QueryMemoryDescriptor query_mem_desc(
-      QueryDescriptionType::GroupByBaselineHash, 0, 3, false, {8, 8});
+      QueryDescriptionType::GroupByBaselineHash, 0, max_val, false, {8, 8});
   for (const auto& target_info : target_infos) {
     const auto slot_bytes =
         std::max(num_bytes, static_cast<int8_t>(target_info.sql_type.get_size()));
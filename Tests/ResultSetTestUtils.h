@@ -164,7 +164,8 @@ QueryMemoryDescriptor baseline_hash_two_col_desc_overflow32(
 
 QueryMemoryDescriptor baseline_hash_two_col_desc(
     const std::vector<TargetInfo>& target_infos,
-    const int8_t num_bytes);
+    const int8_t num_bytes,
+    const size_t max_val = 3);
 
 size_t get_slot_count(const std::vector<TargetInfo>& target_infos);
 
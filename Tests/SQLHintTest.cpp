@@ -77,6 +77,67 @@ TEST(CPU_MODE, ForceToCPUMode) {
   QR::get()->runDDLStatement(drop_table_ddl);
 }
 
+void check_batch_filters_hint(const std::string& query) {
+  const auto hinted_query =
+      boost::replace_first_copy(query, "SELECT ", "SELECT /*+ batch_filters */ ");
+  CHECK(QR::get()->getParsedQueryHintofQuery(hinted_query).batch_filters);
+  CHECK(!QR::get()->getParsedQueryHintofQuery(query).batch_filters);
+  const auto expected = run_query(query, ExecutorDeviceType::CPU);
+  const auto actual = run_query(hinted_query, ExecutorDeviceType::CPU);
+  ASSERT_EQ(expected->rowCount(), actual->rowCount()) << query;
+  ASSERT_EQ(expected->colCount(), actual->colCount()) << query;
+  while (true) {
+    const auto expected_row = expected->getNextRow(true, true);
+    const auto actual_row = actual->getNextRow(true, true);
+    ASSERT_EQ(expected_row.empty(), actual_row.empty()) << query;
+    if (expected_row.empty()) {
+      break;
+    }
+    for (size_t i = 0; i < expected_row.size(); ++i) {
+      ASSERT_EQ(TestHelpers::v<int64_t>(expected_row[i]),
+                TestHelpers::v<int64_t>(actual_row[i]))
+          << query;
+    }
+  }
+}
+
+TEST(BATCH_FILTERS, SameResultsAsRowFilters) {
+  const auto drop_table_ddl = "DROP TABLE IF EXISTS SQL_HINT_BATCH";
+  QR::get()->runDDLStatement(drop_table_ddl);
+  QR::get()->runDDLStatement(
+      "CREATE TABLE SQL_HINT_BATCH(x INT, y SMALLINT, b BIGINT ENCODING FIXED(16), "
+      "d DOUBLE, f FLOAT, dc DECIMAL(10, 2)) WITH (fragment_size = 1500)");
+  for (const auto& values : {"(1, 1, 3, 0.25, 1.5, 1.25)",
+                             "(2, 2, 4, 0.5, 2.5, 1.5)",
+                             "(3, 2, 5, 0.75, 3.5, 1.75)",
+                             "(4, 3, 3, 1.0, 0.5, 2.0)",
+                             "(5, NULL, 9, NULL, 1.0, NULL)",
+                             "(NULL, 1, NULL, 0.5, NULL, 1.5)",
+                             "(7, 1, 12, 0.125, 2.0, 3.0)",
+                             "(7, 2, -4, 2.0, 4.0, -1.5)",
+                             "(-7, 3, 30000, 0.5, -1.0, 0.0)"}) {
+    run_query("INSERT INTO SQL_HINT_BATCH VALUES " + std::string(values) + ";",
+              ExecutorDeviceType::CPU);
+  }
+  // span several blocks of rows and a partial one in each fragment
+  for (size_t i = 0; i < 9; ++i) {
+    QR::get()->runDDLStatement(
+        "INSERT INTO SQL_HINT_BATCH SELECT * FROM SQL_HINT_BATCH;");
+  }
+  for (const auto& query : {
+           "SELECT COUNT(*) FROM SQL_HINT_BATCH WHERE x < 5 AND d >= 0.5;",
+           "SELECT SUM(x) FROM SQL_HINT_BATCH WHERE b <> 3 AND 2 < x;",
+           "SELECT COUNT(*), SUM(b) FROM SQL_HINT_BATCH WHERE dc > 1.50 AND f <= 2.5;",
+           "SELECT y, COUNT(*) FROM SQL_HINT_BATCH WHERE x >= 2 AND b < 10 GROUP BY y "
+           "ORDER BY y;",
+           "SELECT x, b FROM SQL_HINT_BATCH WHERE x = 7 AND y > 1 ORDER BY x, b;",
+           "SELECT COUNT(*) FROM SQL_HINT_BATCH WHERE x > 1 AND (y = 2 OR d < 0.3);",
+           "SELECT COUNT(*) FROM SQL_HINT_BATCH WHERE b > 100000;"}) {
+    check_batch_filters_hint(query);
+  }
+  QR::get()->runDDLStatement(drop_table_ddl);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -15,6 +15,7 @@
  */
 
 #include <boost/functional/hash.hpp>
+#include <chrono>
 #include <csignal>
 #include <cstdlib>
 #include <cstring>
@@ -31,6 +32,7 @@
 #include "../Parser/ParserNode.h"
 #include "../Parser/parser.h"
 #include "../QueryRunner/QueryRunner.h"
+#include "../Shared/File.h"
 #include "PopulateTableRandom.h"
 #include "ScanTable.h"
 #include "TestHelpers.h"
@@ -363,6 +365,77 @@ TEST(DataLoad, NumbersTable_Parallel_CreateDropCreateTable_InsertRows) {
   ASSERT_NO_THROW(run_ddl_statement("drop table numbers_6;"););
 }
 
+namespace {
+
+// Reads every page of the file from each of the given threads using read_page and
+// returns the elapsed wall time in milliseconds. Each thread walks the pages in a
+// different order so that readers keep hitting different offsets of the same file.
+template <typename READ_PAGE>
+int64_t time_concurrent_page_reads(const size_t num_threads,
+                                   const size_t num_pages,
+                                   const size_t page_size,
+                                   READ_PAGE read_page) {
+  std::vector<std::future<void>> readers;
+  const auto clock_begin = std::chrono::steady_clock::now();
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    readers.push_back(std::async(std::launch::async, [&, thread_idx] {
+      std::vector<int8_t> buf(page_size);
+      for (size_t i = 0; i < num_pages; ++i) {
+        const size_t page_num = (i * 7 + thread_idx) % num_pages;
+        read_page(page_num, buf.data());
+        CHECK_EQ(buf[0], static_cast<int8_t>(page_num));
+      }
+    }));
+  }
+  for (auto& reader : readers) {
+    reader.get();
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - clock_begin)
+      .count();
+}
+
+}  // namespace
+
+// Compares the positional page reads used by FileInfo against the previous
+// seek-and-read on a shared FILE* serialized by a per-file mutex.
+TEST(StorageIO, ConcurrentPageReads) {
+  constexpr size_t page_size{1024 * 1024};
+  constexpr size_t num_pages{64};
+  const size_t num_threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+  const auto dir = boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path("storage_perf_io_%%%%-%%%%");
+  boost::filesystem::create_directory(dir);
+  FILE* f = File_Namespace::create(dir.string(), 0, page_size, num_pages);
+  std::vector<int8_t> page(page_size);
+  for (size_t page_num = 0; page_num < num_pages; ++page_num) {
+    std::fill(page.begin(), page.end(), static_cast<int8_t>(page_num));
+    File_Namespace::writePage(f, page_size, page_num, page.data());
+  }
+  fflush(f);
+
+  std::mutex read_write_mutex;
+  auto serialized_read = [&](const size_t page_num, int8_t* buf) {
+    std::lock_guard<std::mutex> lock(read_write_mutex);
+    CHECK_EQ(fseek(f, static_cast<long>(page_num * page_size), SEEK_SET), 0);
+    CHECK_EQ(fread(buf, sizeof(int8_t), page_size, f), page_size);
+  };
+  auto positional_read = [&](const size_t page_num, int8_t* buf) {
+    File_Namespace::readPage(f, page_size, page_num, buf);
+  };
+  const auto serialized_ms =
+      time_concurrent_page_reads(num_threads, num_pages, page_size, serialized_read);
+  const auto positional_ms =
+      time_concurrent_page_reads(num_threads, num_pages, page_size, positional_read);
+  LOG(INFO) << "Read " << num_threads * num_pages * page_size / (1024 * 1024)
+            << " MB with " << num_threads << " threads: fseek/fread under mutex "
+            << serialized_ms << " ms, pread " << positional_ms << " ms";
+
+  File_Namespace::close(f);
+  boost::filesystem::remove_all(dir);
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
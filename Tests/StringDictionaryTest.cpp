@@ -17,7 +17,9 @@
 #include "TestHelpers.h"
 
 #include "../StringDictionary/StringDictionary.h"
+#include "Shared/scope.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
 
@@ -101,6 +103,62 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, GetLikeAndRegexpLike) {
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  // Enough strings to be scanned in several chunks.
+  for (int i = 0; i < g_op_count; ++i) {
+    string_dict.getOrAdd("str" + std::to_string(i));
+  }
+  std::vector<int32_t> expected_ids;
+  for (int i = 0; i < g_op_count; ++i) {
+    if (std::to_string(i).back() == '7') {
+      expected_ids.push_back(i);
+    }
+  }
+  auto like_ids = string_dict.getLike("%7", false, false, '\\', g_op_count);
+  std::sort(like_ids.begin(), like_ids.end());
+  ASSERT_EQ(like_ids, expected_ids);
+  auto regexp_ids = string_dict.getRegexpLike("str[0-9]*7", '\\', g_op_count);
+  std::sort(regexp_ids.begin(), regexp_ids.end());
+  ASSERT_EQ(regexp_ids, expected_ids);
+
+  auto stats = string_dict.getPatternCacheStats();
+  ASSERT_EQ(stats.miss_count, size_t(2));
+  ASSERT_EQ(stats.entry_count, size_t(2));
+  string_dict.getLike("%7", false, false, '\\', g_op_count);
+  ASSERT_EQ(string_dict.getPatternCacheStats().hit_count, size_t(1));
+
+  // New strings invalidate the cached results.
+  const auto new_id = string_dict.getOrAdd("new7");
+  ASSERT_EQ(string_dict.getPatternCacheStats().entry_count, size_t(0));
+  like_ids = string_dict.getLike("%7", false, false, '\\', g_op_count + 1);
+  ASSERT_EQ(like_ids.size(), expected_ids.size() + 1);
+  ASSERT_EQ(like_ids.back(), new_id);
+}
+
+TEST(StringDictionary, PatternCacheIsBounded) {
+  const auto cache_bytes = g_stringdict_pattern_cache_bytes;
+  ScopeGuard reset_cache_bytes = [cache_bytes] {
+    g_stringdict_pattern_cache_bytes = cache_bytes;
+  };
+  g_stringdict_pattern_cache_bytes = 256 * 1024;
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  const int str_count{1000};
+  for (int i = 0; i < str_count; ++i) {
+    string_dict.getOrAdd(std::to_string(i));
+  }
+  // Every pattern matches all strings, so each result takes about 4KB.
+  for (int i = 0; i < 100; ++i) {
+    const auto ids =
+        string_dict.getLike(std::string(i + 1, '%'), false, false, '\\', str_count);
+    ASSERT_EQ(ids.size(), static_cast<size_t>(str_count));
+  }
+  const auto stats = string_dict.getPatternCacheStats();
+  ASSERT_LE(stats.size_bytes, g_stringdict_pattern_cache_bytes);
+  ASSERT_GT(stats.eviction_count, size_t(0));
+  ASSERT_EQ(stats.miss_count, size_t(100));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/WorkStealingPool.h"
+#include "Shared/threadpool.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Sums [begin, end) by splitting the range in two until it is small, joining the
+// halves on the pool at every level.
+int64_t recursive_sum(const int64_t begin, const int64_t end) {
+  if (end - begin <= 16) {
+    int64_t sum{0};
+    for (int64_t i = begin; i < end; ++i) {
+      sum += i;
+    }
+    return sum;
+  }
+  const int64_t mid = begin + (end - begin) / 2;
+  threadpool::FuturesThreadPool<int64_t> thread_pool;
+  thread_pool.spawn(recursive_sum, begin, mid);
+  thread_pool.spawn(recursive_sum, mid, end);
+  const auto sums = thread_pool.join();
+  return sums[0] + sums[1];
+}
+
+}  // namespace
+
+TEST(WorkStealingPool, ReturnsResultsInOrder) {
+  threadpool::FuturesThreadPool<size_t> thread_pool;
+  for (size_t i = 0; i < 100; ++i) {
+    thread_pool.spawn([](const size_t i) { return i * i; }, i);
+  }
+  const auto results = thread_pool.join();
+  ASSERT_EQ(results.size(), size_t(100));
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], i * i);
+  }
+}
+
+TEST(WorkStealingPool, NestedJoinsDoNotDeadlock) {
+  // Far more nested joins than workers, all of them blocked at the same time unless
+  // waiting threads run the tasks they wait for.
+  const int64_t n = 64 * 1024;
+  EXPECT_EQ(recursive_sum(0, n), n * (n - 1) / 2);
+}
+
+TEST(WorkStealingPool, RethrowsTaskExceptions) {
+  threadpool::FuturesThreadPool<void> thread_pool;
+  std::atomic<size_t> done_count{0};
+  for (size_t i = 0; i < 10; ++i) {
+    thread_pool.spawn(
+        [&done_count](const size_t i) {
+          ++done_count;
+          if (i == 5) {
+            throw std::runtime_error("task failed");
+          }
+        },
+        i);
+  }
+  EXPECT_THROW(thread_pool.join(), std::runtime_error);
+  EXPECT_EQ(done_count, size_t(10));
+}
+
+TEST(WorkStealingPool, AsyncTakesMoveOnlyArguments) {
+  int out{0};
+  auto future = threadpool::async(
+      [](std::unique_ptr<int> value, int& out) { out = *value; },
+      std::make_unique<int>(42),
+      std::ref(out));
+  future.get();
+  EXPECT_EQ(out, 42);
+}
+
+TEST(WorkStealingPool, AsyncCanBePolled) {
+  std::atomic<bool> release{false};
+  auto future = threadpool::async([&release] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 7;
+  });
+  // Polling must not run the task on this thread, which would never return.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+  release = true;
+  EXPECT_EQ(future.get(), 7);
+}
+
+TEST(WorkStealingPool, Stats) {
+  auto& pool = threadpool::WorkStealingPool::instance();
+  const auto before = pool.getStats();
+  threadpool::FuturesThreadPool<void> thread_pool;
+  for (size_t i = 0; i < 50; ++i) {
+    thread_pool.spawn([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+  }
+  thread_pool.join();
+  const auto after = pool.getStats();
+  EXPECT_EQ(after.worker_count, pool.workerCount());
+  EXPECT_EQ(after.submitted_count - before.submitted_count, size_t(50));
+  EXPECT_GE(after.max_queue_depth, size_t(1));
+  EXPECT_LE(after.steal_count, after.executed_count);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
@@ -35,8 +35,21 @@ extern std::string cluster_command_line_arg;
 bool g_enable_thrift_logs{false};
 
 extern bool g_use_table_device_offset;
+extern bool g_enable_chunk_value_sketches;
+extern bool g_enable_parallel_reduction;
 extern float g_fraction_code_cache_to_evict;
+extern bool g_enable_persistent_code_cache;
+extern bool g_enable_tiered_compilation;
+extern size_t g_tiered_compilation_hot_count;
+extern bool g_enable_batch_filters;
+extern size_t g_result_cursor_idle_timeout;
+extern size_t g_result_cursor_memory_limit;
+extern size_t g_result_cursor_max_batch_rows;
+extern bool g_enable_plan_cache;
 extern bool g_cache_string_hash;
+extern size_t g_stringdict_pattern_cache_bytes;
+extern bool g_enable_parallel_window_partition_compute;
+extern size_t g_parallel_window_partition_compute_threshold;
 
 extern int64_t g_large_ndv_threshold;
 extern size_t g_large_ndv_multiplier;
@@ -182,6 +195,11 @@ void CommandLineOptions::fillOptions() {
             ->implicit_value(true),
         "Cache string hash values in the string dictionary server during import.");
   }
+  help_desc.add_options()(
+      "string-dict-pattern-cache-bytes",
+      po::value<size_t>(&g_stringdict_pattern_cache_bytes)
+          ->default_value(g_stringdict_pattern_cache_bytes),
+      "Memory budget, per string dictionary, for cached LIKE and REGEXP results.");
   help_desc.add_options()(
       "enable-thrift-logs",
       po::value<bool>(&g_enable_thrift_logs)
@@ -252,6 +270,22 @@ void CommandLineOptions::fillOptions() {
       "max-session-duration",
       po::value<int>(&max_session_duration)->default_value(max_session_duration),
       "Maximum duration of active session.");
+  help_desc.add_options()(
+      "cursor-idle-timeout",
+      po::value<size_t>(&g_result_cursor_idle_timeout)
+          ->default_value(g_result_cursor_idle_timeout),
+      "Seconds after which a result cursor which is not fetched from is closed.");
+  help_desc.add_options()(
+      "cursor-memory-limit",
+      po::value<size_t>(&g_result_cursor_memory_limit)
+          ->default_value(g_result_cursor_memory_limit),
+      "Bytes of result sets which open result cursors can hold. The least recently used "
+      "cursors are closed past it.");
+  help_desc.add_options()(
+      "cursor-max-batch-rows",
+      po::value<size_t>(&g_result_cursor_max_batch_rows)
+          ->default_value(g_result_cursor_max_batch_rows),
+      "Maximum number of rows returned by a single fetch_batch call.");
   help_desc.add_options()(
       "null-div-by-zero",
       po::value<bool>(&g_null_div_by_zero)
@@ -337,6 +371,12 @@ void CommandLineOptions::fillOptions() {
       "disk-cache-size-limit",
       po::value<std::size_t>(&(disk_cache_config.size_limit)),
       "Specify the maximum size of the the disk cache per table in bytes.");
+  help_desc.add_options()("disk-cache-eviction-policy",
+                          po::value<std::string>(&disk_cache_eviction_policy)
+                              ->default_value(disk_cache_eviction_policy),
+                          "Eviction policy of the disk cache. Valid options are 'lru' "
+                          "and '2q', which keeps chunks used once by a scan from "
+                          "evicting chunks used repeatedly.");
 #endif  // ENABLE_FSI
   help_desc.add_options()(
       "enable-interoperability",
@@ -411,6 +451,63 @@ void CommandLineOptions::fillAdvancedOptions() {
                                po::value<int>(&system_parameters.num_executors)
                                    ->default_value(system_parameters.num_executors),
                                "Number of executors to run in parallel.");
+  developer_desc.add_options()(
+      "enable-radix-join-build",
+      po::value<bool>(&g_enable_radix_join_build)
+          ->default_value(g_enable_radix_join_build)
+          ->implicit_value(true),
+      "Build large perfect join hash tables on CPU partition by partition, to keep the "
+      "writes within the cache.");
+  developer_desc.add_options()(
+      "radix-join-min-hash-table-bytes",
+      po::value<size_t>(&g_radix_join_min_hash_table_bytes)
+          ->default_value(g_radix_join_min_hash_table_bytes),
+      "Use the radix-partitioned build once both the join hash table and the row ids of "
+      "the inner table exceed this size, normally that of the last level cache.");
+  developer_desc.add_options()(
+      "radix-join-partition-bytes",
+      po::value<size_t>(&g_radix_join_partition_bytes)
+          ->default_value(g_radix_join_partition_bytes),
+      "Size of the hash table range of a partition in the radix-partitioned join build, "
+      "normally that of the L2 cache.");
+  developer_desc.add_options()(
+      "enable-join-key-range-skipping",
+      po::value<bool>(&g_enable_join_key_range_skipping)
+          ->default_value(g_enable_join_key_range_skipping)
+          ->implicit_value(true),
+      "Skip the outer fragments of an inner join whose key metadata lies outside of the "
+      "range of the keys in the join hash table.");
+  developer_desc.add_options()(
+      "query-priority-high-users",
+      po::value<std::string>(&g_query_priority_high_users)
+          ->default_value(g_query_priority_high_users),
+      "Comma separated list of users whose queries are dispatched before those of "
+      "everybody else.");
+  developer_desc.add_options()(
+      "query-priority-low-users",
+      po::value<std::string>(&g_query_priority_low_users)
+          ->default_value(g_query_priority_low_users),
+      "Comma separated list of users whose queries are dispatched after those of "
+      "everybody else.");
+  developer_desc.add_options()(
+      "dispatch-priority-aging-ms",
+      po::value<size_t>(&g_dispatch_priority_aging_ms)
+          ->default_value(g_dispatch_priority_aging_ms),
+      "Raise the priority of a queued query by one class for every so many "
+      "milliseconds it waits. 0 disables aging.");
+  developer_desc.add_options()(
+      "dispatch-short-query-rows",
+      po::value<size_t>(&g_dispatch_short_query_rows)
+          ->default_value(g_dispatch_short_query_rows),
+      "Run queries over at most this many rows on a dedicated fast lane executor, next "
+      "to the num-executors ones. 0 disables the fast lane.");
+  developer_desc.add_options()(
+      "enable-dispatch-admission-control",
+      po::value<bool>(&g_enable_dispatch_admission_control)
+          ->default_value(g_enable_dispatch_admission_control)
+          ->implicit_value(true),
+      "Only start a query once the size of its input tables fits into the CPU buffer "
+      "pool next to those of the running queries.");
   developer_desc.add_options()(
       "gpu-shared-mem-threshold",
       po::value<size_t>(&g_gpu_smem_threshold)->default_value(g_gpu_smem_threshold),
@@ -441,11 +538,31 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->implicit_value(true),
       "Enables/disables offseting the chosen device ID by the table ID for a given "
       "fragment. This improves balance of fragments across GPUs.");
+  developer_desc.add_options()(
+      "enable-chunk-value-sketches",
+      po::value<bool>(&g_enable_chunk_value_sketches)
+          ->default_value(g_enable_chunk_value_sketches)
+          ->implicit_value(true),
+      "Build a Bloom filter and distinct count sketch for each new chunk of integer, "
+      "date/time and dictionary-encoded string columns, used to skip fragments for "
+      "equality predicates.");
   developer_desc.add_options()("enable-window-functions",
                                po::value<bool>(&g_enable_window_functions)
                                    ->default_value(g_enable_window_functions)
                                    ->implicit_value(true),
                                "Enable experimental window function support.");
+  developer_desc.add_options()(
+      "enable-parallel-window-partition-compute",
+      po::value<bool>(&g_enable_parallel_window_partition_compute)
+          ->default_value(g_enable_parallel_window_partition_compute)
+          ->implicit_value(true),
+      "Sort and compute window function partitions in parallel.");
+  developer_desc.add_options()(
+      "parallel-window-partition-compute-threshold",
+      po::value<size_t>(&g_parallel_window_partition_compute_threshold)
+          ->default_value(g_parallel_window_partition_compute_threshold),
+      "Minimum number of rows for computing window function partitions in parallel. "
+      "Partitions at least this large are also sorted in parallel.");
   developer_desc.add_options()("enable-table-functions",
                                po::value<bool>(&g_enable_table_functions)
                                    ->default_value(g_enable_table_functions)
@@ -470,6 +587,79 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_use_tbb_pool)
           ->implicit_value(true),
       "Enable a new thread pool implementation for queuing kernels for execution.");
+  developer_desc.add_options()(
+      "enable-parallel-reduction",
+      po::value<bool>(&g_enable_parallel_reduction)
+          ->default_value(g_enable_parallel_reduction)
+          ->implicit_value(true),
+      "Reduce the results of more than two kernels in parallel: pairwise in a tree for "
+      "small perfect hash outputs, hash-partitioned across threads for baseline hash "
+      "outputs.");
+  developer_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Persist compiled CPU query code under the data directory so it survives a "
+      "server restart.");
+  developer_desc.add_options()(
+      "enable-tiered-compilation",
+      po::value<bool>(&g_enable_tiered_compilation)
+          ->default_value(g_enable_tiered_compilation)
+          ->implicit_value(true),
+      "Recompile hot CPU query code in the background with the full optimization "
+      "pipeline, loop and SLP vectorization included, and swap it into the code cache.");
+  developer_desc.add_options()(
+      "tiered-compilation-hot-count",
+      po::value<size_t>(&g_tiered_compilation_hot_count)
+          ->default_value(g_tiered_compilation_hot_count),
+      "Number of executions served from the code cache after which CPU query code is "
+      "considered hot by tiered compilation.");
+  developer_desc.add_options()(
+      "enable-batch-filters",
+      po::value<bool>(&g_enable_batch_filters)
+          ->default_value(g_enable_batch_filters)
+          ->implicit_value(true),
+      "Evaluate the comparisons of columns with literals in the filters of CPU table "
+      "scans over blocks of rows, calling the row function for the selected rows only. "
+      "The batch_filters query hint enables it for a single query.");
+  developer_desc.add_options()(
+      "enable-plan-cache",
+      po::value<bool>(&g_enable_plan_cache)
+          ->default_value(g_enable_plan_cache)
+          ->implicit_value(true),
+      "Cache Calcite plans of repeated SQL statements, cleared by any DDL.");
+  developer_desc.add_options()(
+      "enable-kernel-scheduler",
+      po::value<bool>(&g_enable_kernel_scheduler)
+          ->default_value(g_enable_kernel_scheduler)
+          ->implicit_value(true),
+      "Run CPU execution kernels of concurrent queries on a shared work-stealing "
+      "scheduler, splitting the fragments of aggregate queries into row range morsels "
+      "to balance them over the cores.");
+  developer_desc.add_options()(
+      "kernel-scheduler-min-morsel-rows",
+      po::value<size_t>(&g_kernel_scheduler_min_morsel_rows)
+          ->default_value(g_kernel_scheduler_min_morsel_rows),
+      "Minimum number of rows of a morsel the kernel scheduler splits a fragment into.");
+  developer_desc.add_options()(
+      "enable-numa-placement",
+      po::value<bool>(&g_enable_numa_placement)
+          ->default_value(g_enable_numa_placement)
+          ->implicit_value(true),
+      "Bind CPU buffer pool slabs to NUMA nodes, spread fragments over the nodes and, "
+      "with the kernel scheduler, run each kernel on the node holding its fragment.");
+  developer_desc.add_options()(
+      "chunk-prefetch-fragment-count",
+      po::value<size_t>(&g_chunk_prefetch_fragment_count)
+          ->default_value(g_chunk_prefetch_fragment_count),
+      "Number of outer table fragments ahead of the running kernels whose chunks are "
+      "read into CPU memory in the background. 0 disables prefetching.");
+  developer_desc.add_options()(
+      "chunk-prefetch-threads",
+      po::value<size_t>(&g_chunk_prefetch_threads)
+          ->default_value(g_chunk_prefetch_threads),
+      "Number of threads reading prefetched chunks for each query step.");
   developer_desc.add_options()(
       "skip-intermediate-count",
       po::value<bool>(&g_skip_intermediate_count)
@@ -510,6 +700,16 @@ void CommandLineOptions::fillAdvancedOptions() {
       "there is not enough free memory to accomodate the target slab size, smaller "
       "slabs will be allocated, down to the minimum size speified by "
       "min-gpu-slab-size.");
+  developer_desc.add_options()(
+      "cpu-buffer-eviction-policy",
+      po::value<std::string>(&system_parameters.cpu_buffer_eviction_policy)
+          ->default_value(system_parameters.cpu_buffer_eviction_policy),
+      "Eviction policy of the CPU buffer pool, 'lru' or '2q'.");
+  developer_desc.add_options()(
+      "gpu-buffer-eviction-policy",
+      po::value<std::string>(&system_parameters.gpu_buffer_eviction_policy)
+          ->default_value(system_parameters.gpu_buffer_eviction_policy),
+      "Eviction policy of the GPU buffer pools, 'lru' or '2q'.");
 
   developer_desc.add_options()(
       "max-output-projection-allocation-bytes",
@@ -798,6 +998,11 @@ void CommandLineOptions::validate() {
               << "}.  Defaulted to disk cache disabled";
   }
 
+  disk_cache_config.eviction_policy = parse_eviction_policy(disk_cache_eviction_policy);
+  // Fail at startup rather than when the buffer pools are created.
+  parse_eviction_policy(system_parameters.cpu_buffer_eviction_policy);
+  parse_eviction_policy(system_parameters.gpu_buffer_eviction_policy);
+
   if (disk_cache_config.path.empty()) {
     disk_cache_config.path = base_path + "/omnisci_disk_cache";
   }
@@ -81,6 +81,7 @@ class CommandLineOptions {
   unsigned pending_query_interrupt_freq = 1000;  // in milliseconds
   unsigned dynamic_watchdog_time_limit = 10000;
   std::string disk_cache_level = "";
+  std::string disk_cache_eviction_policy = "lru";
 
   /**
    * Can be used to override the number of gpus detected on the system
@@ -156,6 +157,7 @@ extern bool g_allow_cpu_retry;
 extern bool g_null_div_by_zero;
 extern bool g_bigint_count;
 extern bool g_inner_join_fragment_skipping;
+extern bool g_enable_join_key_range_skipping;
 extern float g_filter_push_down_low_frac;
 extern float g_filter_push_down_high_frac;
 extern size_t g_filter_push_down_passing_row_ubound;
@@ -192,4 +194,17 @@ extern bool g_enable_fsi;
 extern bool g_enable_interop;
 extern bool g_enable_union;
 extern bool g_use_tbb_pool;
+extern bool g_enable_kernel_scheduler;
+extern size_t g_kernel_scheduler_min_morsel_rows;
+extern bool g_enable_numa_placement;
+extern bool g_enable_radix_join_build;
+extern size_t g_radix_join_min_hash_table_bytes;
+extern size_t g_radix_join_partition_bytes;
+extern std::string g_query_priority_high_users;
+extern std::string g_query_priority_low_users;
+extern size_t g_dispatch_priority_aging_ms;
+extern size_t g_dispatch_short_query_rows;
+extern bool g_enable_dispatch_admission_control;
+extern size_t g_chunk_prefetch_fragment_count;
+extern size_t g_chunk_prefetch_threads;
 extern bool g_enable_filter_function;
@@ -33,6 +33,7 @@
 #include "MapDRelease.h"
 
 #include "Calcite/Calcite.h"
+#include "Calcite/PlanCache.h"
 #include "gen-cpp/CalciteServer.h"
 
 #include "QueryEngine/RelAlgExecutor.h"
@@ -55,6 +56,8 @@
 #include "Parser/parser.h"
 #include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/CalciteAdapter.h"
+#include "QueryEngine/ChunkPrefetcher.h"
+#include "QueryEngine/DiskCodeCache.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/GpuMemUtils.h"
@@ -65,6 +68,7 @@
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/ThriftSerializers.h"
 #include "Shared/StringTransform.h"
+#include "Shared/WorkStealingPool.h"
 #include "Shared/import_helpers.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/measure.h"
@@ -135,6 +139,80 @@ struct ForceDisconnect : public std::runtime_error {
   ForceDisconnect(const std::string& cause) : std::runtime_error(cause) {}
 };
 
+void set_dispatch_queue_status(TServerStatus& status, const QueryDispatchQueue& queue) {
+  const auto stats = queue.getStats();
+  status.dispatch_queue_depth = stats.queuedCount();
+  status.dispatch_running_count = stats.running_count;
+  status.dispatch_fast_lane_count = stats.fast_lane_count;
+  status.dispatch_admission_wait_count = stats.admission_wait_count;
+  status.dispatch_reserved_bytes = stats.reserved_bytes;
+  const auto& bucket_upper_bounds_ms =
+      QueryDispatchQueue::LatencyHistogram::kBucketUpperBoundsMs;
+  for (size_t i = 0; i < stats.classes.size(); ++i) {
+    const auto& class_stats = stats.classes[i];
+    TQueryLatencyHistogram histogram;
+    histogram.priority_class =
+        QueryDispatchQueue::toString(static_cast<QueryDispatchQueue::Priority>(i));
+    histogram.queued_count = class_stats.queued_count;
+    histogram.executed_count = class_stats.executed_count;
+    histogram.bucket_upper_bounds_ms.assign(bucket_upper_bounds_ms.begin(),
+                                            bucket_upper_bounds_ms.end());
+    histogram.wait_time_counts.assign(class_stats.wait_time_ms.counts.begin(),
+                                      class_stats.wait_time_ms.counts.end());
+    histogram.latency_counts.assign(class_stats.latency_ms.counts.begin(),
+                                    class_stats.latency_ms.counts.end());
+    status.query_latency_histograms.push_back(std::move(histogram));
+  }
+}
+
+// Priority of the session's user and the size of the tables the query reads, from the
+// fragmenter metadata. The byte estimate covers all the columns of the tables, hence is
+// an upper bound of what the query brings into the buffer pool. The size is only
+// estimated as far as the fast lane and admission control need it, the walk over the
+// chunk metadata being too costly to do for every query.
+QueryDispatchQueue::TaskInfo get_dispatch_task_info(
+    const Catalog_Namespace::SessionInfo& session_info,
+    const lockmgr::LockedTableDescriptors& locks) {
+  QueryDispatchQueue::TaskInfo info;
+  info.priority =
+      QueryDispatchQueue::getUserPriority(session_info.get_currentUser().userName);
+  const bool estimate_rows = g_dispatch_short_query_rows > 0;
+  const bool estimate_bytes = g_enable_dispatch_admission_control;
+  if (!estimate_rows && !estimate_bytes) {
+    return info;
+  }
+  info.has_estimate = !locks.empty();
+  const auto& cat = session_info.getCatalog();
+  for (const auto& lock : locks) {
+    const auto td = (*lock)();
+    CHECK(td);
+    if (td->isView || td->storageType == StorageType::FOREIGN_TABLE) {
+      info.has_estimate = false;
+      continue;
+    }
+    for (const auto physical_td : cat.getPhysicalTablesDescriptors(td)) {
+      if (!physical_td->fragmenter) {
+        continue;
+      }
+      if (!estimate_bytes) {
+        // the fast lane only needs the row count, which the fragmenter keeps
+        info.estimated_rows += physical_td->fragmenter->getNumRows();
+        continue;
+      }
+      const auto table_info = physical_td->fragmenter->getFragmentsForQuery();
+      for (const auto& fragment : table_info.fragments) {
+        info.estimated_rows += fragment.getPhysicalNumTuples();
+        for (const auto& [column_id, chunk_metadata] :
+             fragment.getChunkMetadataMapPhysical()) {
+          CHECK(chunk_metadata);
+          info.estimated_bytes += chunk_metadata->numBytes;
+        }
+      }
+    }
+  }
+  return info;
+}
+
 }  // namespace
 
 template <>
@@ -172,6 +250,8 @@ SessionMap::iterator DBHandler::get_session_it_unsafe(
 extern std::unique_ptr<std::string> g_libgeos_so_filename;
 #endif
 
+extern size_t g_result_cursor_max_batch_rows;
+
 DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
                      const std::vector<LeafHostInfo>& string_leaves,
                      const std::string& base_data_path,
@@ -270,6 +350,10 @@ DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
     LOG(FATAL) << "Failed to initialize data manager: " << e.what();
   }
 
+  for (const auto& memory_info : data_mgr_->getMemoryInfo(MemoryLevel::CPU_LEVEL)) {
+    dispatch_queue_->setMemoryBudget(memory_info.maxNumPages * memory_info.pageSize);
+  }
+
   std::string udf_ast_filename("");
 
   try {
@@ -339,6 +423,8 @@ DBHandler::DBHandler(const std::vector<LeafHostInfo>& db_leaves,
   }
 
   import_path_ = boost::filesystem::path(base_data_path_) / "mapd_import";
+  DiskCodeCache::init(
+      (boost::filesystem::path(base_data_path_) / "mapd_code_cache").string());
   start_time_ = std::time(nullptr);
 
   if (is_rendering_enabled) {
@@ -585,6 +671,7 @@ void DBHandler::disconnect_impl(const SessionMap::iterator& session_it,
   sessions_.erase(session_it);
   write_lock.unlock();
 
+  result_cursors_.removeSession(session_id);
   if (render_handler_) {
     render_handler_->disconnect(session_id);
   }
@@ -679,6 +766,18 @@ void DBHandler::get_server_status(TServerStatus& _return, const TSessionId& sess
   _return.start_time = start_time_;
   _return.edition = MAPD_EDITION;
   _return.host_name = omnisci::get_hostname();
+  _return.plan_cache_hits = PlanCache::instance().getHitCount();
+  _return.plan_cache_misses = PlanCache::instance().getMissCount();
+  const auto chunk_prefetch_stats = ChunkPrefetcher::getStats();
+  _return.chunk_prefetch_count = chunk_prefetch_stats.prefetched_count;
+  _return.chunk_prefetch_wasted_count = chunk_prefetch_stats.wasted_count;
+  _return.chunk_prefetch_stall_count = chunk_prefetch_stats.stalled_count;
+  const auto thread_pool_stats = threadpool::WorkStealingPool::instance().getStats();
+  _return.thread_pool_queue_depth = thread_pool_stats.queue_depth;
+  _return.thread_pool_max_queue_depth = thread_pool_stats.max_queue_depth;
+  _return.thread_pool_steal_count = thread_pool_stats.steal_count;
+  CHECK(dispatch_queue_);
+  set_dispatch_queue_status(_return, *dispatch_queue_);
 }
 
 void DBHandler::get_status(std::vector<TServerStatus>& _return,
@@ -694,6 +793,18 @@ void DBHandler::get_status(std::vector<TServerStatus>& _return,
   ret.start_time = start_time_;
   ret.edition = MAPD_EDITION;
   ret.host_name = omnisci::get_hostname();
+  ret.plan_cache_hits = PlanCache::instance().getHitCount();
+  ret.plan_cache_misses = PlanCache::instance().getMissCount();
+  const auto chunk_prefetch_stats = ChunkPrefetcher::getStats();
+  ret.chunk_prefetch_count = chunk_prefetch_stats.prefetched_count;
+  ret.chunk_prefetch_wasted_count = chunk_prefetch_stats.wasted_count;
+  ret.chunk_prefetch_stall_count = chunk_prefetch_stats.stalled_count;
+  const auto thread_pool_stats = threadpool::WorkStealingPool::instance().getStats();
+  ret.thread_pool_queue_depth = thread_pool_stats.queue_depth;
+  ret.thread_pool_max_queue_depth = thread_pool_stats.max_queue_depth;
+  ret.thread_pool_steal_count = thread_pool_stats.steal_count;
+  CHECK(dispatch_queue_);
+  set_dispatch_queue_status(ret, *dispatch_queue_);
 
   // TSercivePort tcp_port{}
 
@@ -1193,6 +1304,114 @@ void DBHandler::deallocate_df(const TSessionId& session,
       data_mgr_);
 }
 
+void DBHandler::sql_execute_cursor(TCursor& _return,
+                                   const TSessionId& session,
+                                   const std::string& query_str,
+                                   const std::string& nonce) {
+  auto session_ptr = get_session_ptr(session);
+  auto query_state = create_query_state(session_ptr, query_str);
+  auto stdlog = STDLOG(session_ptr, query_state);
+  stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
+  stdlog.appendNameValuePairs("nonce", nonce);
+  auto timer = DEBUG_TIMER(__func__);
+
+  if (leaf_aggregator_.leafCount() > 0) {
+    THROW_MAPD_EXCEPTION("Exception: cursors are not supported in distributed mode");
+  }
+  _return.nonce = nonce;
+  _return.execution_time_ms = 0;
+
+  try {
+    ParserWrapper pw{query_str};
+    if (pw.is_ddl || pw.is_update_dml ||
+        pw.getExplainType() != ParserWrapper::ExplainType::None) {
+      throw std::runtime_error("only SELECT queries can be executed with a cursor");
+    }
+    std::shared_ptr<ResultSet> rows;
+    std::vector<TargetMetaInfo> targets;
+    _return.total_time_ms = measure<>::execution([&]() {
+      mapd_shared_lock<mapd_shared_mutex> executeReadLock(
+          *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+              legacylockmgr::ExecutorOuterLock, true));
+      std::string query_ra;
+      lockmgr::LockedTableDescriptors locks;
+      _return.execution_time_ms += measure<>::execution([&]() {
+        TPlanResult plan_result;
+        std::tie(plan_result, locks) = parse_to_ra(query_state->createQueryStateProxy(),
+                                                   query_str,
+                                                   {},
+                                                   true,
+                                                   system_parameters_);
+        query_ra = plan_result.plan_result;
+      });
+      const auto result = execute_rel_alg_cursor(
+          _return, query_ra, query_state->createQueryStateProxy(), *session_ptr);
+      rows = result.getRows();
+      targets = result.getTargetsMeta();
+    });
+    for (const auto& target : targets) {
+      if (target.get_type_info().is_varlen()) {
+        throw std::runtime_error("column " + target.get_resname() + " of type " +
+                                 target.get_type_info().get_type_name() +
+                                 " cannot be fetched with a cursor");
+      }
+    }
+    _return.row_desc = ThriftSerializers::target_meta_infos_to_thrift(targets);
+    _return.cursor_id = result_cursors_.add(session_ptr->get_session_id(), rows, targets);
+  } catch (const std::exception& e) {
+    THROW_MAPD_EXCEPTION(std::string("Exception: ") + e.what());
+  }
+  std::string debug_json = timer.stopAndGetJson();
+  if (!debug_json.empty()) {
+    _return.__set_debug(std::move(debug_json));
+  }
+  stdlog.appendNameValuePairs("execution_time_ms", _return.execution_time_ms);
+}
+
+// Serializes the next rows of a cursor without going through a TQueryResult of the whole
+// result set. The batches are columnar, and the cursor is closed along with the last one.
+void DBHandler::fetch_batch(TRowBatch& _return,
+                            const TSessionId& session,
+                            const TCursorId& cursor_id,
+                            const int32_t max_rows) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  if (max_rows <= 0) {
+    THROW_MAPD_EXCEPTION("Exception: max_rows must be positive");
+  }
+  auto cursor = result_cursors_.get(session_ptr->get_session_id(), cursor_id);
+  if (!cursor) {
+    THROW_MAPD_EXCEPTION("Exception: cursor does not exist or has expired");
+  }
+  const auto batch_row_count =
+      std::min(static_cast<size_t>(max_rows), g_result_cursor_max_batch_rows);
+  std::lock_guard<std::mutex> fetch_lock(cursor->fetch_mutex);
+  auto& row_set = _return.row_set;
+  row_set.is_columnar = true;
+  row_set.columns.resize(cursor->targets.size());
+  size_t fetched{0};
+  while (fetched < batch_row_count && !cursor->next_row.empty()) {
+    for (size_t i = 0; i < cursor->targets.size(); ++i) {
+      value_to_thrift_column(
+          cursor->next_row[i], cursor->targets[i].get_type_info(), row_set.columns[i]);
+    }
+    ++fetched;
+    cursor->next_row = cursor->rows->getNextRow(true, true);
+  }
+  _return.end_of_results = cursor->next_row.empty();
+  if (_return.end_of_results) {
+    result_cursors_.remove(session_ptr->get_session_id(), cursor_id);
+  }
+  stdlog.appendNameValuePairs("rows", fetched);
+}
+
+// Closing a cursor which has already been closed or has expired is not an error.
+void DBHandler::close_cursor(const TSessionId& session, const TCursorId& cursor_id) {
+  auto session_ptr = get_session_ptr(session);
+  auto stdlog = STDLOG(session_ptr);
+  result_cursors_.remove(session_ptr->get_session_id(), cursor_id);
+}
+
 std::string DBHandler::apply_copy_to_shim(const std::string& query_str) {
   auto result = query_str;
   {
@@ -2305,6 +2524,7 @@ void DBHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
       md.touch = gpu.touch;
       md.chunk_key.insert(md.chunk_key.end(), gpu.chunk_key.begin(), gpu.chunk_key.end());
       md.is_free = gpu.memStatus == Buffer_Namespace::MemStatus::FREE;
+      md.numa_node = gpu.numaNode;
       nodeInfo.node_memory_data.push_back(md);
     }
     _return.push_back(nodeInfo);
@@ -4812,7 +5032,8 @@ void DBHandler::execute_rel_alg_df(TDataFrame& _return,
                            /*filter_on_deleted_column=*/true,
                            ExecutorExplainType::Default,
                            intel_jit_profile_};
-  ExecutionOptions eo = {g_enable_columnar_output,
+  // The Arrow converter wraps columnar projection buffers without going row by row.
+  ExecutionOptions eo = {/*output_columnar_hint=*/true,
                          allow_multifrag_,
                          false,
                          allow_loop_joins_,
@@ -4863,6 +5084,61 @@ void DBHandler::execute_rel_alg_df(TDataFrame& _return,
   _return.df_size = arrow_result.df_size;
 }
 
+// The result set of a cursor outlives the table locks taken for the query, so lazy
+// fetch is disabled: the fixed width columns are read while the locks are held rather
+// than at fetch time, when the table could have been updated. Varlen targets still
+// point into the chunk buffers and are rejected by sql_execute_cursor.
+ExecutionResult DBHandler::execute_rel_alg_cursor(
+    TCursor& _return,
+    const std::string& query_ra,
+    QueryStateProxy query_state_proxy,
+    const Catalog_Namespace::SessionInfo& session_info) const {
+  query_state::Timer timer = query_state_proxy.createTimer(__func__);
+  const auto& cat = session_info.getCatalog();
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID,
+                                        jit_debug_ ? "/tmp" : "",
+                                        jit_debug_ ? "mapdquery" : "",
+                                        system_parameters_);
+  RelAlgExecutor ra_executor(executor.get(),
+                             cat,
+                             query_ra,
+                             query_state_proxy.getQueryState().shared_from_this());
+  const auto& query_hints = ra_executor.getParsedQueryHints();
+  CompilationOptions co = {query_hints.cpu_mode ? ExecutorDeviceType::CPU
+                                                : session_info.get_executor_device_type(),
+                           /*hoist_literals=*/true,
+                           ExecutorOptLevel::Default,
+                           g_enable_dynamic_watchdog,
+                           /*allow_lazy_fetch=*/false,
+                           /*filter_on_deleted_column=*/true,
+                           ExecutorExplainType::Default,
+                           intel_jit_profile_};
+  ExecutionOptions eo = {g_enable_columnar_output,
+                         allow_multifrag_,
+                         false,
+                         allow_loop_joins_,
+                         g_enable_watchdog,
+                         jit_debug_,
+                         false,
+                         g_enable_dynamic_watchdog,
+                         g_dynamic_watchdog_time_limit,
+                         false,
+                         false,
+                         system_parameters_.gpu_input_mem_limit,
+                         g_enable_runtime_query_interrupt,
+                         g_pending_query_interrupt_freq};
+  ExecutionResult result{std::make_shared<ResultSet>(std::vector<TargetInfo>{},
+                                                     ExecutorDeviceType::CPU,
+                                                     QueryMemoryDescriptor(),
+                                                     nullptr,
+                                                     nullptr),
+                         {}};
+  _return.execution_time_ms += measure<>::execution(
+      [&]() { result = ra_executor.executeRelAlgQuery(co, eo, false, nullptr); });
+  _return.execution_time_ms -= result.getRows()->getQueueTime();
+  return result;
+}
+
 std::vector<TargetMetaInfo> DBHandler::getTargetMetaInfo(
     const std::vector<std::shared_ptr<Analyzer::TargetEntry>>& targets) const {
   std::vector<TargetMetaInfo> result;
@@ -4906,7 +5182,8 @@ void DBHandler::convert_rows(TQueryResult& _return,
   int32_t fetched{0};
   if (column_format) {
     _return.row_set.is_columnar = true;
-    std::vector<TColumn> tcolumns(results.colCount());
+    auto& tcolumns = _return.row_set.columns;
+    tcolumns.resize(results.colCount());
     while (first_n == -1 || fetched < first_n) {
       const auto crt_row = results.getNextRow(true, true);
       if (crt_row.empty()) {
@@ -4922,9 +5199,6 @@ void DBHandler::convert_rows(TQueryResult& _return,
         value_to_thrift_column(agg_result, targets[i].get_type_info(), tcolumns[i]);
       }
     }
-    for (size_t i = 0; i < results.colCount(); ++i) {
-      _return.row_set.columns.push_back(tcolumns[i]);
-    }
   } else {
     _return.row_set.is_columnar = false;
     while (first_n == -1 || fetched < first_n) {
@@ -5206,7 +5480,8 @@ void DBHandler::sql_execute_impl(TQueryResult& _return,
     CHECK(dispatch_queue_);
     dispatch_queue_->submit(execute_rel_alg_task,
                             pw.getDMLType() == ParserWrapper::DMLType::Update ||
-                                pw.getDMLType() == ParserWrapper::DMLType::Delete);
+                                pw.getDMLType() == ParserWrapper::DMLType::Delete,
+                            get_dispatch_task_info(*session_ptr, locks));
     auto result_future = execute_rel_alg_task->get_future();
     result_future.get();
     return;
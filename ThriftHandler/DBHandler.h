@@ -58,6 +58,7 @@
 #include "ThriftHandler/DistributedValidate.h"
 #include "ThriftHandler/QueryState.h"
 #include "ThriftHandler/RenderHandler.h"
+#include "ThriftHandler/ResultCursors.h"
 
 #include <sys/types.h>
 #include <thrift/server/TServer.h>
@@ -295,6 +296,15 @@ class DBHandler : public OmniSciIf {
                      const TDataFrame& df,
                      const TDeviceType::type device_type,
                      const int32_t device_id) override;
+  void sql_execute_cursor(TCursor& _return,
+                          const TSessionId& session,
+                          const std::string& query,
+                          const std::string& nonce) override;
+  void fetch_batch(TRowBatch& _return,
+                   const TSessionId& session,
+                   const TCursorId& cursor_id,
+                   const int32_t max_rows) override;
+  void close_cursor(const TSessionId& session, const TCursorId& cursor_id) override;
   void interrupt(const TSessionId& query_session,
                  const TSessionId& interrupt_session) override;
   void sql_validate(TRowDescriptor& _return,
@@ -680,6 +690,12 @@ class DBHandler : public OmniSciIf {
                           const int32_t first_n,
                           const TArrowTransport::type transport_method) const;
 
+  ExecutionResult execute_rel_alg_cursor(
+      TCursor& _return,
+      const std::string& query_ra,
+      QueryStateProxy query_state_proxy,
+      const Catalog_Namespace::SessionInfo& session_info) const;
+
   void executeDdl(TQueryResult& _return,
                   const std::string& query_ra,
                   std::shared_ptr<Catalog_Namespace::SessionInfo const> session_ptr);
@@ -814,6 +830,9 @@ class DBHandler : public OmniSciIf {
   };
   GeoCopyFromSessions geo_copy_from_sessions;
 
+  // Result sets opened with sql_execute_cursor
+  ResultCursors result_cursors_;
+
   // Only for IPC device memory deallocation
   mutable std::mutex handle_to_dev_ptr_mutex_;
   mutable std::unordered_map<std::string, std::string> ipc_handle_to_dev_ptr_;
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThriftHandler/ResultCursors.h"
+
+#include "Logger/Logger.h"
+#include "Shared/StringTransform.h"
+
+size_t g_result_cursor_idle_timeout{300};              // seconds
+size_t g_result_cursor_memory_limit{size_t(2) << 30};  // bytes
+size_t g_result_cursor_max_batch_rows{1000000};
+
+ResultCursor::ResultCursor(const std::string& session_id,
+                           std::shared_ptr<ResultSet> rows,
+                           const std::vector<TargetMetaInfo>& targets)
+    : session_id(session_id)
+    , rows(rows)
+    , targets(targets)
+    , byte_size(rows->getHostBufferSizeBytes())
+    , next_row(rows->getNextRow(true, true))
+    , last_used(std::chrono::steady_clock::now()) {}
+
+std::string ResultCursors::add(const std::string& session_id,
+                               std::shared_ptr<ResultSet> rows,
+                               const std::vector<TargetMetaInfo>& targets) {
+  auto cursor = std::make_shared<ResultCursor>(session_id, rows, targets);
+  std::lock_guard<std::mutex> cursors_lock(cursors_mutex_);
+  std::string cursor_id;
+  do {
+    cursor_id = generate_random_string(32);
+  } while (cursors_.count(cursor_id));
+  cursors_.emplace(cursor_id, cursor);
+  total_byte_size_ += cursor->byte_size;
+  expireUnsafe(cursor_id);
+  return cursor_id;
+}
+
+std::shared_ptr<ResultCursor> ResultCursors::get(const std::string& session_id,
+                                                 const std::string& cursor_id) {
+  std::lock_guard<std::mutex> cursors_lock(cursors_mutex_);
+  expireUnsafe(cursor_id);
+  const auto cursor_it = cursors_.find(cursor_id);
+  if (cursor_it == cursors_.end() || cursor_it->second->session_id != session_id) {
+    return nullptr;
+  }
+  cursor_it->second->last_used = std::chrono::steady_clock::now();
+  return cursor_it->second;
+}
+
+void ResultCursors::remove(const std::string& session_id, const std::string& cursor_id) {
+  std::lock_guard<std::mutex> cursors_lock(cursors_mutex_);
+  const auto cursor_it = cursors_.find(cursor_id);
+  if (cursor_it != cursors_.end() && cursor_it->second->session_id == session_id) {
+    eraseUnsafe(cursor_it);
+  }
+}
+
+void ResultCursors::removeSession(const std::string& session_id) {
+  std::lock_guard<std::mutex> cursors_lock(cursors_mutex_);
+  for (auto cursor_it = cursors_.begin(); cursor_it != cursors_.end();) {
+    if (cursor_it->second->session_id == session_id) {
+      cursor_it = eraseUnsafe(cursor_it);
+    } else {
+      ++cursor_it;
+    }
+  }
+}
+
+size_t ResultCursors::size() const {
+  std::lock_guard<std::mutex> cursors_lock(cursors_mutex_);
+  return cursors_.size();
+}
+
+// Drops the idle cursors, then the least recently used ones until the result sets held
+// fit in the memory limit. The cursor being added or fetched from is kept, a single
+// result set over the limit is still served.
+void ResultCursors::expireUnsafe(const std::string& keep_cursor_id) {
+  const auto now = std::chrono::steady_clock::now();
+  const auto idle_timeout = std::chrono::seconds(g_result_cursor_idle_timeout);
+  for (auto cursor_it = cursors_.begin(); cursor_it != cursors_.end();) {
+    if (cursor_it->first != keep_cursor_id &&
+        now - cursor_it->second->last_used > idle_timeout) {
+      LOG(INFO) << "Result cursor idle for more than " << g_result_cursor_idle_timeout
+                << " seconds, closing it.";
+      cursor_it = eraseUnsafe(cursor_it);
+    } else {
+      ++cursor_it;
+    }
+  }
+  while (total_byte_size_ > g_result_cursor_memory_limit) {
+    auto lru_it = cursors_.end();
+    for (auto cursor_it = cursors_.begin(); cursor_it != cursors_.end(); ++cursor_it) {
+      if (cursor_it->first != keep_cursor_id &&
+          (lru_it == cursors_.end() ||
+           cursor_it->second->last_used < lru_it->second->last_used)) {
+        lru_it = cursor_it;
+      }
+    }
+    if (lru_it == cursors_.end()) {
+      break;
+    }
+    LOG(INFO) << "Result cursors hold " << total_byte_size_
+              << " bytes, over the limit of " << g_result_cursor_memory_limit
+              << " bytes, closing the least recently used one.";
+    eraseUnsafe(lru_it);
+  }
+}
+
+ResultCursors::CursorMap::iterator ResultCursors::eraseUnsafe(
+    CursorMap::iterator cursor_it) {
+  CHECK_GE(total_byte_size_, cursor_it->second->byte_size);
+  total_byte_size_ -= cursor_it->second->byte_size;
+  return cursors_.erase(cursor_it);
+}
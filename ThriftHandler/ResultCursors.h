@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ResultCursors.h
+ * @brief Result sets kept on the server for sql_execute_cursor / fetch_batch
+ *
+ * A cursor holds the ResultSet of a query until its rows have all been fetched, it is
+ * closed, its session disconnects or it expires. Cursors expire once idle for longer
+ * than g_result_cursor_idle_timeout seconds, and the least recently used ones are
+ * evicted when the result sets held by all cursors exceed g_result_cursor_memory_limit
+ * bytes.
+ *
+ * Varlen targets (none encoded strings, arrays and geo) are not supported: the result
+ * set points into the chunk buffers for those, which can be freed once the table locks
+ * of the query are released.
+ */
+
+#pragma once
+
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/TargetMetaInfo.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ResultCursor {
+  ResultCursor(const std::string& session_id,
+               std::shared_ptr<ResultSet> rows,
+               const std::vector<TargetMetaInfo>& targets);
+
+  const std::string session_id;
+  const std::shared_ptr<ResultSet> rows;
+  const std::vector<TargetMetaInfo> targets;
+  const size_t byte_size;
+
+  // ResultSet::getNextRow advances an iterator of its own, fetches of the same cursor
+  // have to take turns.
+  std::mutex fetch_mutex;
+  // The row after the last fetched one, empty past the end of the results. Reading one
+  // row ahead tells whether a batch is the last one.
+  std::vector<TargetValue> next_row;
+
+  // Only accessed under the ResultCursors mutex.
+  std::chrono::steady_clock::time_point last_used;
+};
+
+class ResultCursors {
+ public:
+  // Returns the id of the new cursor, evicting other cursors to stay within the memory
+  // limit if needed.
+  std::string add(const std::string& session_id,
+                  std::shared_ptr<ResultSet> rows,
+                  const std::vector<TargetMetaInfo>& targets);
+
+  // Returns nullptr if the cursor does not exist, has expired or belongs to another
+  // session.
+  std::shared_ptr<ResultCursor> get(const std::string& session_id,
+                                    const std::string& cursor_id);
+
+  void remove(const std::string& session_id, const std::string& cursor_id);
+
+  void removeSession(const std::string& session_id);
+
+  size_t size() const;
+
+ private:
+  using CursorMap = std::unordered_map<std::string, std::shared_ptr<ResultCursor>>;
+
+  void expireUnsafe(const std::string& keep_cursor_id);
+
+  CursorMap::iterator eraseUnsafe(CursorMap::iterator cursor_it);
+
+  mutable std::mutex cursors_mutex_;
+  CursorMap cursors_;
+  size_t total_byte_size_{0};
+};
@@ -410,6 +410,19 @@ void validate_and_set_date_encoding(ColumnDescriptor& cd, int encoding_size) {
   cd.columnType.set_comp_param((encoding_size == 16) ? 16 : 0);
 }
 
+void validate_and_set_packed_encoding(ColumnDescriptor& cd, const EncodingType encoding) {
+  CHECK(encoding == kENCODING_RL || encoding == kENCODING_DIFF);
+  const auto& ti = cd.columnType;
+  if (!ti.is_integer() && !ti.is_time()) {
+    throw std::runtime_error(
+        cd.columnName + ": " +
+        (encoding == kENCODING_RL ? "RL (run length)" : "DIFF (frame of reference)") +
+        " encoding is only supported on integer, date and time columns.");
+  }
+  cd.columnType.set_compression(encoding);
+  cd.columnType.set_comp_param(0);
+}
+
 void validate_and_set_encoding(ColumnDescriptor& cd,
                                const Encoding* encoding,
                                const SqlType* column_type) {
@@ -421,14 +434,10 @@ void validate_and_set_encoding(ColumnDescriptor& cd,
       validate_and_set_fixed_encoding(cd, encoding->get_encoding_param(), column_type);
     } else if (boost::iequals(comp, "rl")) {
       // run length encoding
-      cd.columnType.set_compression(kENCODING_RL);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
+      validate_and_set_packed_encoding(cd, kENCODING_RL);
     } else if (boost::iequals(comp, "diff")) {
-      // differential encoding
-      cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      // frame of reference encoding, bit-packed differences to the chunk minimum
+      validate_and_set_packed_encoding(cd, kENCODING_DIFF);
     } else if (boost::iequals(comp, "dict")) {
       validate_and_set_dictionary_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "NONE")) {
@@ -120,6 +120,8 @@ void validate_and_set_compressed_encoding(ColumnDescriptor& cd, int encoding_siz
 
 void validate_and_set_date_encoding(ColumnDescriptor& cd, int encoding_size);
 
+void validate_and_set_packed_encoding(ColumnDescriptor& cd, const EncodingType encoding);
+
 void validate_and_set_encoding(ColumnDescriptor& cd,
                                const Encoding* encoding,
                                const SqlType* column_type);
@@ -11,6 +11,8 @@ public class OmniSciHintStrategyTable {
   }
 
   static HintStrategyTable createHintStrategies(HintStrategyTable.Builder builder) {
-    return builder.hintStrategy("cpu_mode", HintPredicates.SET_VAR).build();
+    return builder.hintStrategy("cpu_mode", HintPredicates.SET_VAR)
+            .hintStrategy("batch_filters", HintPredicates.SET_VAR)
+            .build();
   }
 }
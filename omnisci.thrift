@@ -93,6 +93,7 @@ struct TStringRow {
 
 typedef list<TColumnType> TRowDescriptor
 typedef string TSessionId
+typedef string TCursorId
 typedef string TKrb5Token
 typedef i64 TQueryId
 typedef i64 TSubqueryId
@@ -146,6 +147,20 @@ struct TQueryResult {
   7: TQueryType query_type=TQueryType.UNKNOWN
 }
 
+struct TCursor {
+  1: TCursorId cursor_id
+  2: TRowDescriptor row_desc
+  3: i64 execution_time_ms
+  4: i64 total_time_ms
+  5: string nonce
+  6: string debug
+}
+
+struct TRowBatch {
+  1: TRowSet row_set
+  2: bool end_of_results
+}
+
 struct TDataFrame {
   1: binary sm_handle
   2: i64 sm_size
@@ -227,6 +242,15 @@ struct TDashboard {
   8: bool is_dash_shared
 }
 
+struct TQueryLatencyHistogram {
+  1: string priority_class
+  2: i64 queued_count
+  3: i64 executed_count
+  4: list<i64> bucket_upper_bounds_ms
+  5: list<i64> wait_time_counts
+  6: list<i64> latency_counts
+}
+
 struct TServerStatus {
   1: bool read_only
   2: string version
@@ -236,6 +260,20 @@ struct TServerStatus {
   6: string host_name
   7: bool poly_rendering_enabled
   8: TRole role
+  9: i64 plan_cache_hits
+  10: i64 plan_cache_misses
+  11: i64 chunk_prefetch_count
+  12: i64 chunk_prefetch_wasted_count
+  13: i64 chunk_prefetch_stall_count
+  14: i64 thread_pool_queue_depth
+  15: i64 thread_pool_max_queue_depth
+  16: i64 thread_pool_steal_count
+  17: i64 dispatch_queue_depth
+  18: i64 dispatch_running_count
+  19: i64 dispatch_fast_lane_count
+  20: i64 dispatch_admission_wait_count
+  21: i64 dispatch_reserved_bytes
+  22: list<TQueryLatencyHistogram> query_latency_histograms
 }
 
 struct TPixel {
@@ -290,6 +328,7 @@ struct TMemoryData {
   5: list<i64> chunk_key
   6: i32 buffer_epoch
   7: bool is_free
+  8: i32 numa_node = -1
 }
 
 struct TNodeMemoryInfo {
@@ -550,6 +589,9 @@ service OmniSci {
   TDataFrame sql_execute_df(1: TSessionId session, 2: string query 3: common.TDeviceType device_type 4: i32 device_id = 0 5: i32 first_n = -1 6: TArrowTransport transport_method) throws (1: TOmniSciException e)
   TDataFrame sql_execute_gdf(1: TSessionId session, 2: string query 3: i32 device_id = 0, 4: i32 first_n = -1) throws (1: TOmniSciException e)
   void deallocate_df(1: TSessionId session, 2: TDataFrame df, 3: common.TDeviceType device_type, 4: i32 device_id = 0) throws (1: TOmniSciException e)
+  TCursor sql_execute_cursor(1: TSessionId session, 2: string query, 3: string nonce) throws (1: TOmniSciException e)
+  TRowBatch fetch_batch(1: TSessionId session, 2: TCursorId cursor_id, 3: i32 max_rows) throws (1: TOmniSciException e)
+  void close_cursor(1: TSessionId session, 2: TCursorId cursor_id) throws (1: TOmniSciException e)
   void interrupt(1: TSessionId query_session, 2: TSessionId interrupt_session) throws (1: TOmniSciException e)
   TRowDescriptor sql_validate(1: TSessionId session, 2: string query) throws (1: TOmniSciException e)
   list<completion_hints.TCompletionHint> get_completion_hints(1: TSessionId session, 2:string sql, 3:i32 cursor) throws (1: TOmniSciException e)